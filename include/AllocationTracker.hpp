@@ -0,0 +1,31 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <cstdint>
+
+// Counts global operator new calls, for the HUD, the profiler zones and the steady-state check (T3_ALLOC_CHECK).
+// Opt-in: only builds with T3_ALLOC_TRACKING (CMake T3_ALLOC_TRACKING) replace operator new/delete, otherwise
+// every count stays 0. Per allocation that's two relaxed atomic adds for the process total plus two plain
+// thread_local adds. Frees aren't counted, the interesting number is how often something goes to the allocator.
+class AllocationTracker {
+public:
+    struct Counts {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    static bool isEnabled();
+    // Since startup, diff two of these for a frame or a zone.
+    static Counts total();      // every thread, SFML's audio threads included
+    static Counts thisThread(); // the calling thread only
+};
+
+inline AllocationTracker::Counts operator-(const AllocationTracker::Counts& a, const AllocationTracker::Counts& b) {
+    return {a.allocations - b.allocations, a.bytes - b.bytes};
+}
+
+inline AllocationTracker::Counts operator+(const AllocationTracker::Counts& a, const AllocationTracker::Counts& b) {
+    return {a.allocations + b.allocations, a.bytes + b.bytes};
+}
+
+#endif // ALLOCATION_TRACKER_HPP
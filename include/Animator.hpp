@@ -0,0 +1,41 @@
+#ifndef ANIMATOR_HPP
+#define ANIMATOR_HPP
+
+#include "TextureAtlas.hpp"
+#include "SFML/Graphics/Rect.hpp"
+
+#include <cstddef>
+
+// Steps through the frames of an atlas animation at a fixed rate. Looping, or playing once and holding the
+// last frame. Only picks the texture rect, whoever draws the thing applies it.
+class Animator {
+public:
+    Animator() = default;
+    Animator(const TextureAtlas::Animation* animation, float framesPerSecond, bool loop = true);
+
+    void update(float deltaSeconds);
+    void play() { m_playing = true; }
+    void pause() { m_playing = false; }
+    void restart();
+    // Switches animation (e.g. facing left/right) keeping the current frame index when it exists.
+    void setAnimation(const TextureAtlas::Animation* animation);
+
+    bool isPlaying() const { return m_playing; }
+    bool isFinished() const;
+    bool isValid() const { return m_animation && !m_animation->frames.empty(); }
+    std::size_t getFrameIndex() const { return m_frame; }
+    // Empty rect without a valid animation.
+    sf::IntRect getFrameRect() const;
+    // Id in TextureAtlas::getFrames(), 0 (white) without a valid animation.
+    sf::Uint16 getFrameId() const;
+
+private:
+    const TextureAtlas::Animation* m_animation = nullptr;
+    float m_frameDuration = 0.1f;
+    float m_time = 0.f;
+    std::size_t m_frame = 0;
+    bool m_loop = true;
+    bool m_playing = true;
+};
+
+#endif // ANIMATOR_HPP
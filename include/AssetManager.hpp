@@ -0,0 +1,115 @@
+#ifndef ASSET_MANAGER_HPP
+#define ASSET_MANAGER_HPP
+
+#include "SFML/Graphics/Font.hpp"
+#include "SFML/Graphics/Image.hpp"
+#include "SFML/Graphics/Texture.hpp"
+#include "SFML/Audio/SoundBuffer.hpp"
+#include "SFML/Config.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class AssetPack;
+
+using TextureHandle = std::shared_ptr<const sf::Texture>;
+using SoundBufferHandle = std::shared_ptr<const sf::SoundBuffer>;
+using FontHandle = std::shared_ptr<const sf::Font>;
+
+// One place for images, sound effects and fonts. Everything is cached by path (pack first, then disk) and handed out
+// as shared handles, asking twice gives back the same object. releaseUnused() drops whatever only the cache still holds.
+//
+// preload*() decodes on a pool of worker threads (PNG -> sf::Image, WAV/OGG -> samples), finishPreloads() then does the
+// GPU/OpenAL side on the calling thread, which has to be the one owning the window's GL context.
+// Not thread safe itself, use it from the main thread.
+class AssetManager {
+public:
+    // workerCount 0 = one per core. T3_ASSET_THREADS in the environment overrides it (1 to compare against serial).
+    explicit AssetManager(unsigned int workerCount = 0);
+    ~AssetManager();
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    void setAssetPack(const AssetPack* pack) { m_pack = pack; }
+
+    void preloadTexture(const std::string& path);
+    void preloadSoundBuffer(const std::string& path);
+    // Waits for every queued decode and turns the results into textures/buffers. Returns how many failed.
+    std::size_t finishPreloads();
+
+    // Cached handle, finishing a pending preload or loading synchronously on a miss. nullptr if the file can't be loaded.
+    // smooth only counts for the load that creates the texture, a later call asking otherwise gets the same one.
+    TextureHandle getTexture(const std::string& path, bool smooth = false);
+    SoundBufferHandle getSoundBuffer(const std::string& path);
+    FontHandle getFont(const std::string& path);
+
+    // Decodes a batch of images on the workers and waits for all of them, nothing is cached. For CPU side
+    // processing (the sprite atlas). out[i] belongs to paths[i]. Returns how many failed, those stay empty.
+    std::size_t loadImages(const std::vector<std::string>& paths, std::vector<sf::Image>& out);
+
+    // Forget assets nobody holds a handle to. Returns how many were dropped.
+    std::size_t releaseUnused();
+
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t preloaded = 0;
+        unsigned int workers = 0;
+        double lastPreloadMs = 0.0; // queue of the first preload -> end of finishPreloads
+    };
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct DecodedSound {
+        std::vector<sf::Int16> samples;
+        unsigned int channelCount = 0;
+        unsigned int sampleRate = 0;
+        bool ok = false;
+    };
+    struct DecodedImage {
+        sf::Image image;
+        bool ok = false;
+    };
+
+    DecodedImage decodeImage(const std::string& path) const;
+    DecodedSound decodeSound(const std::string& path) const;
+    TextureHandle uploadTexture(const std::string& path, DecodedImage decoded, bool smooth);
+    SoundBufferHandle uploadSound(const std::string& path, DecodedSound decoded);
+
+    // tiny fixed pool, jobs are whole-file decodes so a plain locked queue is plenty
+    void enqueue(std::function<void()> job);
+    void workerLoop();
+
+    const AssetPack* m_pack = nullptr;
+
+    std::unordered_map<std::string, std::shared_ptr<const sf::Texture>> m_textures;
+    std::unordered_map<std::string, std::shared_ptr<const sf::SoundBuffer>> m_sounds;
+    std::unordered_map<std::string, std::shared_ptr<const sf::Font>> m_fonts;
+
+    std::unordered_map<std::string, std::future<DecodedImage>> m_pendingImages;
+    std::unordered_map<std::string, std::future<DecodedSound>> m_pendingSounds;
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex m_jobMutex;
+    std::condition_variable m_jobReady;
+    bool m_stopping = false;
+    mutable std::mutex m_soundOpenMutex; // SFML registers its sound readers lazily and not thread safe
+
+    Stats m_stats;
+    std::chrono::steady_clock::time_point m_preloadStart;
+    bool m_preloadRunning = false;
+};
+
+#endif // ASSET_MANAGER_HPP
@@ -0,0 +1,93 @@
+#ifndef ASSET_PACK_HPP
+#define ASSET_PACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// All of assets/ in one file (built by tools/assetpack with -DT3_ASSET_PACK=ON), memory mapped once at startup.
+// SFML's loadFromMemory/openFromMemory and the level parser read straight out of the mapping, so after open()
+// there is no more file I/O for packed assets. Anything that is not in the pack is loaded from disk as before.
+//
+// Layout, little endian:
+//   header  "T3PK" u32 version, u32 entryCount, u32 flags, u64 indexOffset, u64 indexSize     (32 bytes)
+//   data    entries back to back, each starting on a 16 byte boundary
+//   index   per entry: u64 offset, u64 storedSize, u64 size, u32 flags, u32 pathLength, path bytes
+// Paths are relative to assets/ with forward slashes ("images/loading.png").
+namespace pak {
+    constexpr char MAGIC[4] = {'T', '3', 'P', 'K'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::size_t HEADER_SIZE = 32;
+    constexpr std::size_t DATA_ALIGNMENT = 16;
+    constexpr std::uint32_t ENTRY_LZ4 = 1u << 0; // stored LZ4 block compressed, size is the decompressed size
+}
+
+class AssetPack {
+public:
+    struct View {
+        const void* data = nullptr;
+        std::size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& packPath);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+    std::size_t getEntryCount() const { return m_entries.size(); }
+
+    // Bytes of a packed file, valid until close(). Uncompressed entries point into the mapping, LZ4 ones are
+    // decompressed once and kept. Empty view when the pack is closed or does not have it. Safe from any thread.
+    View find(const std::string& key) const;
+
+    // "../assets/images/loading.png" -> "images/loading.png", the same key the packer used.
+    static std::string keyFor(const std::string& path);
+
+    // Pack first, loose file second. Works for anything with loadFromMemory/loadFromFile (textures, fonts, sound buffers...).
+    template <typename Resource>
+    bool load(Resource& resource, const std::string& path) const {
+        View view = find(keyFor(path));
+        if (view) return resource.loadFromMemory(view.data, view.size);
+        return resource.loadFromFile(path);
+    }
+
+    // Same for streamed resources (sf::Music). The pack stays mapped, so the stream can keep reading from it.
+    template <typename Stream>
+    bool openStream(Stream& stream, const std::string& path) const {
+        View view = find(keyFor(path));
+        if (view) return stream.openFromMemory(view.data, view.size);
+        return stream.openFromFile(path);
+    }
+
+private:
+    struct Entry {
+        std::uint64_t offset;
+        std::uint64_t storedSize;
+        std::uint64_t size;
+        std::uint32_t flags;
+    };
+
+    bool readIndex();
+
+    const unsigned char* m_base = nullptr;
+    std::size_t m_mappedSize = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+    std::string m_path;
+    std::unordered_map<std::string, Entry> m_entries;
+
+    mutable std::mutex m_decompressedMutex;
+    mutable std::unordered_map<std::string, std::unique_ptr<std::vector<unsigned char>>> m_decompressed;
+};
+
+#endif // ASSET_PACK_HPP
@@ -22,13 +22,16 @@ namespace phys {
         bool hitWallRight = false;
         sf::Vector2f surfaceVelocity = {0.f, 0.f};
         const PlatformBody* groundPlatform = nullptr; 
+        // work done, summed over the iterations (perf HUD)
+        std::size_t platformsChecked = 0;  // solid bodies looked at
+        std::size_t sweepCandidates = 0;   // of those, the ones whose AABB the sweep overlaps, got a full sweptAABB
     };
 
     class CollisionSystem {
     public:
         static CollisionResolutionInfo resolveCollisions(
             DynamicBody& dynamicBody,
-            const std::vector<PlatformBody>& platformBodies,
+            const BodyList& platformBodies,
             float deltaTime
         );
 
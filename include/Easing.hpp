@@ -0,0 +1,150 @@
+#ifndef EASING_HPP
+#define EASING_HPP
+
+#include <array>
+#include <cstddef>
+
+// Easing curves picked at compile time, what the game eases with (Optimizer.hpp keeps the original Penner
+// functions around as the reference). ease<Curve::X>(alpha) maps 0..1 onto 0..1, clamped. The polynomial curves
+// are worked out directly; sine and expo read a constexpr table the compiler builds (nothing runs at startup) and
+// interpolate linearly, within 1e-5 of the exact curve (Penner's expo jumps by 2^-10 at its ends, the table ramps
+// over one step instead). easeBatch does a whole array in one loop the compiler can vectorize.
+//
+//   float offset = math::easing::ease<math::easing::Curve::SineInOut>(t, start, change, duration); // Penner order
+//   math::easing::easeBatch<math::easing::Curve::SineInOut>(alphas, eased, count);
+namespace math {
+namespace easing {
+
+enum class Curve {
+    Linear,
+    QuadIn, QuadOut, QuadInOut,
+    CubicIn, CubicOut, CubicInOut,
+    SineIn, SineOut, SineInOut,   // from here on tabled
+    ExpoIn, ExpoOut, ExpoInOut,
+};
+
+constexpr bool isTabled(Curve curve) { return curve >= Curve::SineIn; }
+
+namespace detail {
+    constexpr std::size_t TABLE_STEPS = 1024;  // the table has one more entry than this
+    constexpr double PI = 3.14159265358979323846;
+
+    // No constexpr cos or exp in C++17, these only ever run in the compiler.
+    constexpr double cosSeries(double x) {     // |x| <= pi/2
+        double term = 1.0, sum = 1.0;
+        for (int n = 1; n < 12; ++n) {
+            term *= -x * x / static_cast<double>((2 * n - 1) * (2 * n));
+            sum += term;
+        }
+        return sum;
+    }
+    constexpr double cosPi(double alpha) {     // cos(pi * alpha), alpha in 0..1
+        return alpha <= 0.5 ? cosSeries(PI * alpha) : -cosSeries(PI * (1.0 - alpha));
+    }
+    constexpr double exp2(double x) {          // x <= 0
+        double scale = 1.0;
+        for (; x < -1.0; x += 1.0) scale *= 0.5;
+        const double y = x * 0.69314718055994530942;
+        double term = 1.0, sum = 1.0;
+        for (int n = 1; n < 20; ++n) {
+            term *= y / n;
+            sum += term;
+        }
+        return sum * scale;
+    }
+
+    // same shapes as the Optimizer.hpp functions with b = 0, c = 1, d = 1
+    constexpr double exact(Curve curve, double a) {
+        switch (curve) {
+            case Curve::SineIn:    return 1.0 - cosPi(a / 2.0);
+            case Curve::SineOut:   return cosPi((1.0 - a) / 2.0);
+            case Curve::SineInOut: return (1.0 - cosPi(a)) / 2.0;
+            case Curve::ExpoIn:    return a <= 0.0 ? 0.0 : exp2(10.0 * (a - 1.0));
+            case Curve::ExpoOut:   return a >= 1.0 ? 1.0 : 1.0 - exp2(-10.0 * a);
+            case Curve::ExpoInOut:
+                if (a <= 0.0 || a >= 1.0) return a <= 0.0 ? 0.0 : 1.0;
+                return a < 0.5 ? exp2(20.0 * a - 10.0) / 2.0 : (2.0 - exp2(-20.0 * a + 10.0)) / 2.0;
+            default:               return a;
+        }
+    }
+
+    template <Curve C>
+    constexpr std::array<float, TABLE_STEPS + 1> makeTable() {
+        std::array<float, TABLE_STEPS + 1> values{};
+        for (std::size_t i = 0; i <= TABLE_STEPS; ++i) values[i] = static_cast<float>(exact(C, static_cast<double>(i) / TABLE_STEPS));
+        // ends exact, platforms have to come back to where they started
+        values[0] = 0.f;
+        values[TABLE_STEPS] = 1.f;
+        return values;
+    }
+
+    template <Curve C>
+    struct Table {
+        static constexpr std::array<float, TABLE_STEPS + 1> values = makeTable<C>();
+    };
+}
+
+// No branches, only picks between values (the in-out curves mirror the first half), so easeBatch's loop vectorizes.
+template <Curve C>
+constexpr float ease(float alpha) {
+    alpha = alpha > 0.f ? alpha : 0.f; // NaN ends up 0 too
+    alpha = alpha < 1.f ? alpha : 1.f;
+    const float back = 1.f - alpha;
+    if constexpr (C == Curve::Linear) {
+        return alpha;
+    } else if constexpr (C == Curve::QuadIn) {
+        return alpha * alpha;
+    } else if constexpr (C == Curve::QuadOut) {
+        return 1.f - back * back;
+    } else if constexpr (C == Curve::QuadInOut) {
+        const bool firstHalf = alpha < 0.5f;
+        const float m = firstHalf ? alpha : back;
+        return (firstHalf ? 0.f : 1.f) + (firstHalf ? 2.f : -2.f) * m * m;
+    } else if constexpr (C == Curve::CubicIn) {
+        return alpha * alpha * alpha;
+    } else if constexpr (C == Curve::CubicOut) {
+        return 1.f - back * back * back;
+    } else if constexpr (C == Curve::CubicInOut) {
+        const bool firstHalf = alpha < 0.5f;
+        const float m = firstHalf ? alpha : back;
+        return (firstHalf ? 0.f : 1.f) + (firstHalf ? 4.f : -4.f) * m * m * m;
+    } else {
+        static_assert(isTabled(C), "a curve without a formula needs a table");
+        constexpr int LAST = static_cast<int>(detail::TABLE_STEPS) - 1;
+        const std::array<float, detail::TABLE_STEPS + 1>& values = detail::Table<C>::values;
+        const float x = alpha * static_cast<float>(detail::TABLE_STEPS);
+        int i = static_cast<int>(x);
+        i = i < LAST ? i : LAST;
+        const float f = x - static_cast<float>(i);
+        return values[i] * (1.f - f) + values[i + 1] * f; // exactly values[i + 1] at f = 1
+    }
+}
+
+// t, b, c, d like the Optimizer.hpp functions: time, start value, change, duration. Done right away for d = 0.
+template <Curve C>
+constexpr float ease(float t, float b, float c, float d) {
+    return b + c * (d > 0.f ? ease<C>(t / d) : (t >= d ? 1.f : 0.f));
+}
+
+// out[i] = ease<C>(alpha[i]), out may be alpha. Tabled curves go through a buffer on the stack, with out written
+// straight away the compiler can't rule out it being the table and won't vectorize the lookups. GCC needs
+// -fno-trapping-math for any of it (CMakeLists sets it), clang and MSVC don't.
+template <Curve C>
+void easeBatch(const float* alpha, float* out, std::size_t count) {
+    if constexpr (!isTabled(C)) {
+        for (std::size_t i = 0; i < count; ++i) out[i] = ease<C>(alpha[i]);
+    } else {
+        constexpr std::size_t CHUNK = 64;
+        float eased[CHUNK];
+        for (std::size_t first = 0; first < count; first += CHUNK) {
+            const std::size_t n = count - first < CHUNK ? count - first : CHUNK;
+            for (std::size_t i = 0; i < n; ++i) eased[i] = ease<C>(alpha[first + i]);
+            for (std::size_t i = 0; i < n; ++i) out[first + i] = eased[i];
+        }
+    }
+}
+
+} // namespace easing
+} // namespace math
+
+#endif // EASING_HPP
@@ -0,0 +1,158 @@
+#ifndef EMBEDDED_LEVEL_HPP
+#define EMBEDDED_LEVEL_HPP
+
+#include "PhysicsTypes.hpp"
+#include "LevelTemplate.hpp"
+
+#include <cstddef>
+
+// Levels compiled into the binary (cmake -DT3_EMBED_LEVELS=ON). The levelembed tool runs the normal JSON parser
+// over assets/levels at build time and writes these tables as constexpr data, LevelManager then looks here before
+// it touches the disk. Plain aggregates only, so the tables can be checked with static_assert.
+namespace embedded {
+
+    struct Platform {
+        unsigned int id;
+        float x, y;
+        float width, height;
+        phys::bodyType type;
+        bool initiallyFalling;
+        float surfaceVelocityX, surfaceVelocityY;
+        unsigned int portalID;
+        float teleportOffsetX, teleportOffsetY;
+    };
+
+    struct MovingPlatform {
+        unsigned int id;
+        float startX, startY;
+        char axis;
+        float distance;
+        float cycleDuration;
+        int initialDirection;
+    };
+
+    struct InteractiblePlatform {
+        unsigned int id;
+        const char* interactionType;
+        const char* targetBodyTypeStr;
+        phys::bodyType targetBodyType;
+        unsigned char tileR, tileG, tileB, tileA;
+        bool hasTargetTileColor;
+        bool oneTime;
+        float cooldown;
+        unsigned int linkedID;
+    };
+
+    struct PortalPlatform {
+        unsigned int id;
+        unsigned int portalID;
+        float offsetX, offsetY;
+    };
+
+    struct ChunkEntry {
+        int x, y;
+        const char* file;
+    };
+
+    struct Streaming {
+        bool enabled;
+        float chunkSize;
+        int loadRadius, unloadRadius, maxPendingLoads;
+        int startChunkX, startChunkY;
+        bool hasDeathChunkRow;
+        int deathChunkRow;
+        float fallDistance;
+        const ChunkEntry* chunks; std::size_t chunkCount;
+    };
+
+    // One level file or one streamed chunk file. Empty tables are nullptr with a count of 0.
+    struct Level {
+        const char* file; // path relative to the level base path, e.g. "level3.json"
+        int levelNumber;  // 0 for chunk files
+        const char* levelName;
+        float playerStartX, playerStartY;
+        unsigned char backgroundR, backgroundG, backgroundB, backgroundA;
+        const Platform* platforms; std::size_t platformCount;
+        const MovingPlatform* moving; std::size_t movingCount;
+        const InteractiblePlatform* interactibles; std::size_t interactibleCount;
+        const PortalPlatform* portals; std::size_t portalCount;
+        Streaming streaming;
+    };
+
+    // --- build time checks, used by the generated static_asserts ---
+
+    constexpr bool hasPlatform(const Level& level, unsigned int id) {
+        for (std::size_t i = 0; i < level.platformCount; ++i) {
+            if (level.platforms[i].id == id) return true;
+        }
+        return false;
+    }
+
+    constexpr bool platformsAreSane(const Level& level) {
+        for (std::size_t i = 0; i < level.platformCount; ++i) {
+            const Platform& p = level.platforms[i];
+            if (!(p.width > 0.f) || !(p.height > 0.f)) return false;
+        }
+        return true;
+    }
+
+    // Not part of validate(): some shipped levels reuse ids and the loader just takes the first one,
+    // levelembed only warns about it.
+    constexpr bool hasUniqueIDs(const Level& level) {
+        for (std::size_t i = 0; i < level.platformCount; ++i) {
+            for (std::size_t j = i + 1; j < level.platformCount; ++j) {
+                if (level.platforms[j].id == level.platforms[i].id) return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool detailsPointAtPlatforms(const Level& level) {
+        for (std::size_t i = 0; i < level.movingCount; ++i) {
+            const MovingPlatform& m = level.moving[i];
+            if (!hasPlatform(level, m.id)) return false;
+            if (m.axis != 'x' && m.axis != 'y') return false;
+            if (!(m.cycleDuration > 0.f)) return false;
+        }
+        for (std::size_t i = 0; i < level.interactibleCount; ++i) {
+            const InteractiblePlatform& ip = level.interactibles[i];
+            if (!hasPlatform(level, ip.id)) return false;
+            // streamed levels may link into another chunk, those are only checked at runtime
+            if (ip.linkedID != 0 && !level.streaming.enabled && !hasPlatform(level, ip.linkedID)) return false;
+        }
+        for (std::size_t i = 0; i < level.portalCount; ++i) {
+            if (!hasPlatform(level, level.portals[i].id)) return false;
+        }
+        return true;
+    }
+
+    constexpr bool streamingIsSane(const Streaming& s) {
+        if (!s.enabled) return s.chunkCount == 0;
+        if (!(s.chunkSize >= 64.f) || s.loadRadius < 0 || s.unloadRadius <= s.loadRadius || s.maxPendingLoads < 1) return false;
+        for (std::size_t i = 0; i < s.chunkCount; ++i) {
+            for (std::size_t j = i + 1; j < s.chunkCount; ++j) {
+                if (s.chunks[i].x == s.chunks[j].x && s.chunks[i].y == s.chunks[j].y) return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool validate(const Level& level) {
+        return level.file != nullptr &&
+               (level.platformCount > 0 || level.streaming.enabled || level.levelNumber == 0) &&
+               platformsAreSane(level) &&
+               detailsPointAtPlatforms(level) &&
+               streamingIsSane(level.streaming);
+    }
+
+    // --- runtime side (src/EmbeddedLevels.cpp, only built with T3_EMBED_LEVELS) ---
+
+    // nullptr when nothing was embedded under that number / path.
+    const Level* findLevel(int levelNumber);
+    const Level* findFile(const char* relativePath);
+    std::size_t getLevelCount();
+
+    LevelData toLevelData(const Level& level);
+}
+
+#endif // EMBEDDED_LEVEL_HPP
@@ -0,0 +1,58 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include "LatencyStats.hpp"
+#include "SFML/Window/Window.hpp"
+
+#include <cstdint>
+
+// Decides when a frame starts.
+//  VSync:    the driver blocks in display(). Smooth, but most drivers queue 2-3 frames ahead, which is input lag.
+//  Uncapped: no waiting at all.
+//  Limited:  a target rate without vsync. Each frame waits until its present deadline minus the render time it
+//            is expected to take, so input gets polled as late as possible. sleep() for the bulk of the wait,
+//            spinning for the last bit, sleep alone overshoots by a scheduler quantum.
+//
+// Also measures what came out: display to display intervals and how long frames took to build.
+class FramePacer {
+public:
+    enum class Mode { VSync, Uncapped, Limited };
+
+    void setMode(Mode mode) { m_mode = mode; m_deadlineUs = 0; }
+    Mode getMode() const { return m_mode; }
+    void setTargetFps(int fps);
+    int getTargetFps() const { return m_targetFps; }
+
+    // Vsync on or off to match the mode. SFML's own limiter stays off, it only sleeps.
+    void apply(sf::Window& window) const;
+
+    // Right before polling events.
+    void waitForFrameStart();
+    // Right after display().
+    void endFrame();
+
+    // Refreshed twice a second.
+    const LatencyStats::Summary& getFrameTimes() const { return m_frameSummary; }
+    double getRenderEstimateMs() const { return m_renderEstimateUs / 1000.0; }
+
+    static const char* modeName(Mode mode);
+
+private:
+    static constexpr std::int64_t SPIN_US = 2000; // below this, spin instead of sleep
+
+    Mode m_mode = Mode::VSync;
+    int m_targetFps = 144;
+    std::int64_t m_periodUs = 1000000 / 144;
+    std::int64_t m_deadlineUs = 0;       // when the current frame should be on screen, 0 = not pacing yet
+    std::int64_t m_frameStartUs = 0;
+    std::int64_t m_lastDisplayUs = 0;
+    double m_renderMeanUs = 0.0;         // running average of frame build time and its deviation
+    double m_renderDeviationUs = 0.0;
+    double m_renderEstimateUs = 0.0;
+
+    LatencyStats m_frameTimes{600};
+    LatencyStats::Summary m_frameSummary;
+    std::int64_t m_lastSummaryUs = 0;
+};
+
+#endif // FRAME_PACER_HPP
@@ -0,0 +1,66 @@
+#ifndef GOLDEN_TRACE_HPP
+#define GOLDEN_TRACE_HPP
+
+#include "SFML/System/Vector2.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the player did on every tick of a replayed run: position, velocity, the platform it stood on and the
+// collision resolution flags, after the step. The golden check (T3_GOLDEN) replays each level's committed input
+// log and compares the run against the trace committed next to it, so a change to the collision code or the step
+// that moves the player at all shows up as the first tick where the two part ways.
+//
+// Plain text like InputLog: a "t3trace 1 <tickRate> <level>" header, then one
+// "<tick> <x> <y> <vx> <vy> <groundID> <flags>" line per tick. Floats are written with enough digits to read back
+// bit for bit.
+class GoldenTrace {
+public:
+    enum Flag : std::uint8_t {
+        OnGround = 1 << 0,
+        HitCeiling = 1 << 1,
+        HitWallLeft = 1 << 2,
+        HitWallRight = 1 << 3,
+    };
+
+    struct Sample {
+        std::uint64_t tick;
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        unsigned int groundID;   // 0 = in the air
+        std::uint8_t flags;
+    };
+
+    // How far position (pixels) and velocity (pixels/s) may drift before a tick counts as different. Ground
+    // platform and flags always have to match.
+    struct Tolerance {
+        float position = 0.001f;
+        float velocity = 0.001f;
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    void clear();
+    void setInfo(int tickRate, int level) { m_tickRate = tickRate; m_level = level; }
+    void add(const Sample& sample) { m_samples.push_back(sample); }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // Index of the first sample of `actual` that doesn't match this trace (a run that ends early or goes on
+    // longer diverges where the shorter one stops), npos when they match. outWhat says what was off.
+    std::size_t findDivergence(const GoldenTrace& actual, const Tolerance& tolerance, std::string& outWhat) const;
+
+    const std::vector<Sample>& getSamples() const { return m_samples; }
+    int getTickRate() const { return m_tickRate; }
+    int getLevel() const { return m_level; }
+
+private:
+    std::vector<Sample> m_samples;
+    int m_tickRate = 60;
+    int m_level = 0;
+};
+
+#endif // GOLDEN_TRACE_HPP
@@ -0,0 +1,41 @@
+#ifndef INPUT_LOG_HPP
+#define INPUT_LOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The keyboard input of one run, as the simulation saw it: which key went down or up on which tick. Input is
+// assigned to ticks by timestamp, so feeding a log back in place of the keyboard replays the run exactly,
+// whatever the frame rate was.
+//
+// Plain text: a "t3input 1 <tickRate> <level>" header, then one "<tick> <key> <0|1>" line per event (key is
+// the sf::Keyboard::Key value, -1 = release everything).
+class InputLog {
+public:
+    struct Entry {
+        std::uint64_t tick;
+        int key;
+        bool pressed;
+    };
+
+    void clear();
+    void setInfo(int tickRate, int level) { m_tickRate = tickRate; m_level = level; }
+    void add(std::uint64_t tick, int key, bool pressed) { m_entries.push_back({tick, key, pressed}); }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    const std::vector<Entry>& getEntries() const { return m_entries; }
+    int getTickRate() const { return m_tickRate; }
+    int getLevel() const { return m_level; }
+    bool empty() const { return m_entries.empty(); }
+
+private:
+    std::vector<Entry> m_entries;
+    int m_tickRate = 60;
+    int m_level = 0;
+};
+
+#endif // INPUT_LOG_HPP
@@ -0,0 +1,25 @@
+#ifndef INTERPOLATION_HPP
+#define INTERPOLATION_HPP
+
+#include "SFML/System/Vector2.hpp"
+
+#include <cmath>
+
+// The simulation runs at a fixed tick rate and the screen at whatever it likes, so a frame usually lands between
+// two ticks. Rendering blends from the state before the last tick to the current one by alpha (the leftover of
+// the accumulator in ticks, 0..1), which trades up to one tick of latency for smooth motion.
+namespace interp {
+
+// Further than this in one tick is a teleport (portal, respawn, a vanishing tile parked off-world),
+// drawn straight at the new spot instead of sliding there.
+constexpr float SNAP_DISTANCE = 128.f;
+
+inline sf::Vector2f blend(const sf::Vector2f& previous, const sf::Vector2f& current, float alpha) {
+    const sf::Vector2f delta = current - previous;
+    if (std::abs(delta.x) > SNAP_DISTANCE || std::abs(delta.y) > SNAP_DISTANCE) return current;
+    return previous + delta * alpha;
+}
+
+} // namespace interp
+
+#endif // INTERPOLATION_HPP
@@ -0,0 +1,45 @@
+#ifndef LATENCY_STATS_HPP
+#define LATENCY_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keeps the last N samples of some latency (ms) for min/mean/p50/p99/max. Storage is allocated once up front,
+// neither add() nor summarize() allocate, so both can sit in a hot loop. Not thread safe, one thread adds and
+// summarizes.
+class LatencyStats {
+public:
+    struct Summary {
+        std::size_t count = 0;
+        double min = 0.0;
+        double mean = 0.0;
+        double stdDev = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    explicit LatencyStats(std::size_t capacity = 4096);
+
+    // Once full the oldest sample is overwritten.
+    void add(double milliseconds);
+    void reset();
+    std::size_t size() const { return m_count; }
+
+    Summary summarize() const;
+    // "n=120 min 1.02 mean 3.40 sd 1.10 p50 3.11 p99 8.75 max 9.20 ms"
+    static std::string format(const Summary& summary);
+
+    // steady clock, for timestamping across threads
+    static std::int64_t nowMicros();
+
+private:
+    std::vector<double> m_samples;
+    mutable std::vector<double> m_sorted; // summarize() scratch, same capacity as m_samples
+    std::size_t m_next = 0;
+    std::size_t m_count = 0;
+};
+
+#endif // LATENCY_STATS_HPP
@@ -0,0 +1,59 @@
+#ifndef LEVEL_ARENA_HPP
+#define LEVEL_ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for everything that lives exactly as long as one run of a level (LevelOverlay's bodies and
+// platform state, main's tiles). Allocating is a pointer bump, deallocate does nothing, and reset() hands the
+// whole thing back at once when the level is torn down or respawned.
+//
+// Memory comes from upstream in large blocks. reset() folds them into one block of the combined size, so
+// after the first run of a level the next ones (respawns, reloads of the same size) don't touch the heap at all.
+// Containers using it must be gone (or emptied down to no storage) before reset(), whatever they still point
+// at gets handed out again. Not thread safe, same rules as the containers drawing from it.
+class LevelArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit LevelArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~LevelArena() override;
+
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+
+    // Rewinds to empty, keeping (and merging) the blocks.
+    void reset();
+    // Rewinds and gives every block back to upstream.
+    void release();
+
+    std::size_t getBytesUsed() const { return m_used; }     // handed out since the last reset, padding included
+    std::size_t getCapacity() const { return m_capacity; }
+    std::size_t getBlockCount() const { return m_blocks.size(); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minSize);
+    void freeBlocks();
+
+    std::pmr::memory_resource* m_upstream;
+    std::size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    std::size_t m_current = 0;  // block being bumped
+    std::size_t m_offset = 0;   // into it
+    std::size_t m_used = 0;
+    std::size_t m_capacity = 0;
+};
+
+#endif // LEVEL_ARENA_HPP
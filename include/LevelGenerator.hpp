@@ -0,0 +1,77 @@
+#ifndef LEVEL_GENERATOR_HPP
+#define LEVEL_GENERATOR_HPP
+
+#include "PhysicsTypes.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Synthetic levels for scale and stress testing, as level JSON the LevelManager loads like any other level.
+// Platforms sit on a grid (cell size, rows, columns following from the count), one per cell with some jitter in
+// position and size, and get their type drawn from per-type weights. Moving platforms get a path that stays in
+// their cell, interactibles a link to a platform close by, portals come in pairs and vanishing fields overwrite
+// rectangles of cells. The same options and seed give the same file on every platform and compiler.
+//
+//   LevelGenerator::Options options;
+//   options.platformCount = 100000;
+//   options.setWeight(phys::bodyType::trap, 0.f);
+//   LevelGenerator(options).write(file);
+class LevelGenerator {
+public:
+    static constexpr std::size_t TYPE_COUNT = static_cast<std::size_t>(phys::bodyType::portal) + 1;
+
+    struct Options {
+        std::size_t platformCount = 1000;
+        std::uint64_t seed = 1;
+        std::string levelName;           // "generated <count>" when empty
+        int levelNumber = 0;
+        // Layout. Keep rows * cellHeight + top under the death line (2000), levels don't scroll down.
+        std::size_t rows = 20;
+        float cellWidth = 160.f;
+        float cellHeight = 88.f;
+        float top = 160.f;
+        // Relative, by phys::bodyType. Goal is ignored, the last cell always gets the only one.
+        std::array<float, TYPE_COUNT> weights = {
+            1.f,   // none
+            20.f,  // platform
+            6.f,   // conveyorBelt
+            8.f,   // moving
+            4.f,   // interactible
+            6.f,   // falling
+            8.f,   // vanishing
+            3.f,   // spring
+            3.f,   // trap
+            30.f,  // solid
+            0.f,   // goal
+            4.f,   // portal
+        };
+        // Rectangles of fieldSize x fieldSize cells turned into vanishing platforms, on top of the weights.
+        std::size_t vanishingFields = 0;
+        std::size_t vanishingFieldSize = 6;
+        std::size_t linkRange = 8;       // interactibles link to a platform at most this many cells away
+
+        void setWeight(phys::bodyType type, float weight) { weights[static_cast<std::size_t>(type)] = weight; }
+    };
+
+    explicit LevelGenerator(const Options& options) : m_options(options) {}
+
+    // false when the options can't make a level (no platforms, all weights 0) or the write failed.
+    bool write(std::FILE* out) const;
+    std::string toJson() const;
+
+    // Level file spelling, the inverse of LevelManager::stringToBodyType.
+    static const char* typeName(phys::bodyType type);
+    // false for names that aren't a body type.
+    static bool typeFromName(const std::string& name, phys::bodyType& outType);
+
+private:
+    template <typename Sink>
+    bool generate(Sink& sink) const;
+
+    Options m_options;
+};
+
+#endif // LEVEL_GENERATOR_HPP
@@ -3,6 +3,8 @@
 
 #include "rapidjson/document.h"
 #include "PlatformBody.hpp"
+#include "LevelTemplate.hpp"
+#include "AssetManager.hpp"
 #include "SFML/System/Vector2.hpp"
 #include "SFML/System/Clock.hpp"
 #include "SFML/Graphics/Color.hpp"
@@ -16,48 +18,7 @@
 #include <map>
 #include "PhysicsTypes.hpp"
 
-namespace phys {}
-
-struct LevelData {
-    // level handler of the intial rules
-    std::string levelName;
-    int levelNumber = 0;
-    sf::Vector2f playerStartPosition = {100.f, 100.f};
-    sf::Color backgroundColor = sf::Color(20, 20, 40);
-    std::vector<phys::PlatformBody> platforms;
-
-    //moving platform rules
-    struct MovingPlatformInfo {
-        unsigned int id;
-        sf::Vector2f startPosition;
-        char axis = 'x';
-        float distance = 0.f;
-        float cycleDuration = 4.f;
-        int initialDirection = 1;
-    };
-    std::vector<MovingPlatformInfo> movingPlatformDetails;
-
-    //interactible platform rules
-    struct InteractiblePlatformInfo {
-        unsigned int id;
-        std::string interactionType = "changeSelf"; 
-        std::string targetBodyTypeStr;             
-        sf::Color targetTileColor = sf::Color::Transparent; 
-        bool hasTargetTileColor = false;
-        bool oneTime = false;
-        float cooldown = 0.0f;
-        unsigned int linkedID = 0;
-    };
-    std::vector<InteractiblePlatformInfo> interactiblePlatformDetails; 
-
-    //portal rules
-    struct PortalPlatformInfo {
-    unsigned int id; 
-    unsigned int portalID; 
-    sf::Vector2f offset{10.f, 0.f}; 
-};
-    std::vector<PortalPlatformInfo> portalPlatformDetails;
-};
+class AssetPack;
 
 class LevelManager {
 public:
@@ -78,15 +39,33 @@ public:
     ~LevelManager();
 
     void setLevelBasePath(const std::string& path) { m_levelBasePath = path; }
+    const std::string& getLevelBasePath() const { return m_levelBasePath; }
+    // Level JSON and loading screens come out of the pack when it has them. The pack must outlive the manager.
+    void setAssetPack(const AssetPack* pack) { m_assetPack = pack; }
+    // Loading screens go through the shared cache when set, so the preloaded ones are already on the GPU.
+    void setAssetManager(AssetManager* assets) { m_assetManager = assets; }
     void setGeneralLoadingScreenImage(const std::string& imagePath);
     void setNextLevelLoadingScreenImage(const std::string& imagePath);
     void setRespawnLoadingScreenImage(const std::string& imagePath);
     void setTransitionProperties(float fadeDuration = 1.0f);
 
-    bool requestLoadLevel(int levelNumber, LevelData& outLevelData, LoadRequestType type = LoadRequestType::GENERAL);
-    bool requestLoadSpecificLevel(int levelNumber, LevelData& outLevelData);
-    bool requestLoadNextLevel(LevelData& outLevelData);
-    bool requestRespawnCurrentLevel(LevelData& outLevelData);
+    bool requestLoadLevel(int levelNumber, LevelTemplatePtr& outLevel, LoadRequestType type = LoadRequestType::GENERAL);
+    bool requestLoadSpecificLevel(int levelNumber, LevelTemplatePtr& outLevel);
+    bool requestLoadNextLevel(LevelTemplatePtr& outLevel);
+    bool requestRespawnCurrentLevel(LevelTemplatePtr& outLevel);
+
+    // Synchronous, no transition. Parses on first use and then hands out the cached template,
+    // so any number of worlds can share one copy of the level geometry.
+    // Builds with T3_EMBED_LEVELS look in the compiled-in tables before the level base path.
+    LevelTemplatePtr getLevelTemplate(int levelNumber);
+    void clearTemplateCache() { m_templateCache.clear(); }
+
+    // Parses one chunk file of a streamed level (path relative to the level base path).
+    // Only touches const state, so the LevelStreamer calls it from its loader threads. nullptr on failure.
+    LevelTemplatePtr loadChunkTemplate(const std::string& relativePath) const;
+
+    // Parses a whole level from JSON already in memory, same rules as a level file. For benchmarks and tools.
+    bool parseLevelJson(const char* json, std::size_t size, LevelData& outLevelData);
 
     void update(float dt, sf::RenderWindow& window);
     void draw(sf::RenderWindow& window);
@@ -95,6 +74,8 @@ public:
     TransitionState getCurrentTransitionState() const { return m_transitionState; }
 
     int getCurrentLevelNumber() const { return m_currentLevelNumber; }
+    // How long the last transition took to get the level template, parse included (near 0 when cached).
+    float getLastLoadMs() const { return m_lastLoadMs; }
     void setCurrentLevelNumber(int number) { m_currentLevelNumber = number; }
 
     bool hasNextLevel() const;
@@ -105,18 +86,23 @@ public:
 
 
 private:
-    bool performActualLoad(int levelNumber, LevelData& outLevelData);
+    bool performActualLoad(int levelNumber, LevelTemplatePtr& outLevel);
     bool loadLevelDataFromFile(const std::string& filename, LevelData& outLevelData);
     bool loadLevelDataFromJson(const rapidjson::Document& doc, LevelData& outLevelData);
     
-    rapidjson::Document* readJsonFile(const std::string& filepath);
-    void freeJsonDocument(rapidjson::Document* doc);
+    rapidjson::Document* readJsonFile(const std::string& filepath) const;
+    void freeJsonDocument(rapidjson::Document* doc) const;
     // phys::bodyType stringToBodyType(const std::string& typeStr); // Moved to public
     bool parseLevelData(const rapidjson::Document& doc, LevelData& outLevelData);
+    bool parsePlatforms(const rapidjson::Value& platformsArray, LevelData& outLevelData) const;
+    bool parseStreamingInfo(const rapidjson::Value& streamingJson, LevelData::StreamingInfo& outStreaming) const;
 
     int m_currentLevelNumber;
     int m_targetLevelNumber;
-    LevelData* m_levelDataToFill;
+    LevelTemplatePtr* m_levelToFill;
+    const AssetPack* m_assetPack;
+    AssetManager* m_assetManager;
+    std::map<int, LevelTemplatePtr> m_templateCache;
 
     int m_maxLevels;
     std::string m_levelBasePath;
@@ -126,8 +112,9 @@ private:
     LoadRequestType m_currentLoadType;
     sf::Clock m_transitionClock;
     float m_fadeDuration;
+    float m_lastLoadMs = 0.f;
 
-    sf::Texture m_loadingTexture;
+    TextureHandle m_loadingTexture;
     sf::Sprite m_loadingSprite;
     bool m_loadingScreenReady;
 
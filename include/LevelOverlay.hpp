@@ -0,0 +1,117 @@
+#ifndef LEVEL_OVERLAY_HPP
+#define LEVEL_OVERLAY_HPP
+
+#include "LevelArena.hpp"
+#include "LevelTemplate.hpp"
+#include "PlatformBody.hpp"
+#include "SFML/System/Time.hpp"
+#include "SFML/System/Vector2.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// Per-run state of a moving platform; the path itself stays in the template's MovingPlatformInfo.
+struct ActiveMovingPlatform {
+    std::size_t bodyIndex;
+    const LevelData::MovingPlatformInfo* info;
+    float cycleTime;
+    sf::Vector2f lastFrameActualPosition;
+    sf::Vector2f origin; // where the path's frame sits in the world, see LevelOverlay::Segment
+};
+
+// Per-run state of a falling platform. The player landing on it starts delayTimer, when that runs out it drops
+// until it passes cutoffY and is gone for the rest of the run.
+struct ActiveFallingPlatform {
+    std::size_t bodyIndex;
+    sf::Time delayTimer;
+    bool falling;
+    bool fallen;
+    float cutoffY; // 600, or the level's streaming fallDistance below the spawn point in a streamed world
+};
+
+// Per-run state of an interactible; what it does stays in the template's InteractiblePlatformInfo.
+struct ActiveInteractiblePlatform {
+    const LevelData::InteractiblePlatformInfo* info;
+    bool hasBeenInteractedThisSession;
+    float currentCooldownTimer;
+};
+
+// Mutable side of a running level. Holds a reference on the template it was built from and only the state
+// that diverges from it, bodies[i] is always the runtime copy of template platform i.
+// Many overlays can run off one template at once (one per simulated world).
+//
+// Streamed levels splice extra templates (chunks) in and out as segments. Each segment owns a contiguous run
+// of bodies and an origin, the world position of its template's (0,0). Removing a segment shifts the bodies
+// after it down, so body pointers/indices held outside have to be refreshed (see removeSegment).
+//
+// Everything here is allocated out of the overlay's LevelArena, so building a run is a few large allocations and
+// tearing it down (reset/clear) just rewinds the arena. Other per-run containers can draw from it too
+// (getResource()), as long as they let go of their storage before the next reset/clear.
+class LevelOverlay {
+public:
+    struct Segment {
+        unsigned int handle;
+        LevelTemplatePtr levelTemplate;
+        std::size_t firstBody;
+        std::size_t bodyCount;
+        sf::Vector2f origin;
+    };
+
+    LevelOverlay();
+    LevelOverlay(const LevelOverlay&) = delete;
+    LevelOverlay& operator=(const LevelOverlay&) = delete;
+
+    // Throws away any previous run and rebuilds everything from the template's spawn state.
+    void reset(LevelTemplatePtr levelTemplate);
+    void clear();
+
+    const LevelTemplatePtr& getTemplate() const { return m_template; }
+    bool isLoaded() const { return static_cast<bool>(m_template); }
+
+    // Appends the template's platforms at the end of bodies with their frame placed at origin.
+    // Returns the segment handle. May reallocate bodies.
+    unsigned int appendSegment(LevelTemplatePtr segmentTemplate, const sf::Vector2f& origin);
+    // Drops a segment and its bodies. Returns the erased body range as (first, count), count 0 if the handle is unknown.
+    std::pair<std::size_t, std::size_t> removeSegment(unsigned int handle);
+    const std::pmr::vector<Segment>& getSegments() const { return m_segments; }
+
+    // Moves everything (bodies, segment origins, moving platform paths, fall cutoffs) by delta. Used to rebase the world origin.
+    void translate(const sf::Vector2f& delta);
+
+    // Where body i spawned, in world coordinates.
+    sf::Vector2f getSpawnPosition(std::size_t bodyIndex) const;
+
+    // Index of the runtime body for this platform id, or LevelTemplate::npos.
+    std::size_t findBodyIndex(unsigned int id) const;
+
+    // The run's arena, for containers that should come and go with it.
+    std::pmr::memory_resource* getResource() { return &m_arena; }
+    const LevelArena& getArena() const { return m_arena; }
+
+private:
+    // first, so it outlives every container below
+    LevelArena m_arena;
+    // map nodes, on top of the arena so chunks coming and going reuse them instead of bumping new ones
+    std::pmr::unsynchronized_pool_resource m_nodePool;
+
+public:
+    phys::BodyList bodies;
+    std::pmr::vector<ActiveMovingPlatform> movingPlatforms;
+    std::pmr::vector<ActiveFallingPlatform> fallingPlatforms;
+    std::pmr::map<unsigned int, ActiveInteractiblePlatform> interactibles;
+
+    sf::Time vanishingPlatformCycleTimer = sf::Time::Zero;
+    int oddEvenVanishing = 1;
+
+private:
+    const Segment* findSegment(std::size_t bodyIndex) const;
+
+    LevelTemplatePtr m_template;
+    std::pmr::vector<Segment> m_segments;
+    unsigned int m_nextSegmentHandle = 1;
+};
+
+#endif // LEVEL_OVERLAY_HPP
@@ -0,0 +1,100 @@
+#ifndef LEVEL_STREAMER_HPP
+#define LEVEL_STREAMER_HPP
+
+#include "LevelTemplate.hpp"
+#include "LevelOverlay.hpp"
+#include "SFML/System/Vector2.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class LevelManager;
+
+// Keeps only the chunks of a streamed level that are near the player or the camera resident in a LevelOverlay.
+// Chunks are parsed on loader threads and spliced in on the main thread, one overlay segment per chunk.
+// A chunk is loaded once it is within loadRadius (chebyshev distance in chunks) of either focus and dropped once it
+// is further than unloadRadius from both, the gap between the two keeps a player standing on a border from thrashing.
+//
+// World coordinates are relative to an origin chunk that follows the player, everything stays within a few chunks
+// of (0,0) so float precision does not degrade no matter how far the level goes.
+class LevelStreamer {
+public:
+    // What an update() did to the overlay, so the caller can mirror it on anything kept parallel to bodies.
+    struct Changes {
+        std::vector<std::pair<std::size_t, std::size_t>> removedRanges; // (first, count), in the order they were erased
+        std::size_t firstAppendedBody = 0; // bodies from here to the end were added by this update
+        bool appended = false;
+        bool rebased = false;
+        sf::Vector2f rebaseDelta = {0.f, 0.f}; // already applied to the overlay, was applied before the removals
+
+        bool any() const { return rebased || appended || !removedRanges.empty(); }
+    };
+
+    explicit LevelStreamer(const LevelManager& loader);
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // Starts streaming level. The overlay must have just been reset() with it, its own platforms stay
+    // resident for the whole run as the first segment. Returns false if the level is not a streamed one.
+    bool begin(const LevelTemplatePtr& level);
+    // Forgets the level. Blocks until loads in flight are done.
+    void end();
+    bool isActive() const { return static_cast<bool>(m_level); }
+
+    // Once per frame, before simulating. Positions are in current world coordinates.
+    Changes update(LevelOverlay& world, const sf::Vector2f& playerPos, const sf::Vector2f& cameraCenter);
+
+    sf::Vector2i getOriginChunk() const { return m_originChunk; }
+    // Absolute chunk coordinate of a world position.
+    sf::Vector2i chunkAt(const sf::Vector2f& worldPos) const;
+    bool isBelowDeathRow(const sf::Vector2f& worldPos) const;
+    float getFallDistance() const;
+
+    std::size_t getResidentChunkCount() const { return m_resident.size(); }
+    std::size_t getPendingLoadCount() const { return m_pending.size(); }
+
+private:
+    using ChunkKey = std::uint64_t;
+    static ChunkKey makeKey(int x, int y);
+    static int chunkDistance(const sf::Vector2i& a, int x, int y);
+
+    struct ChunkRef {
+        int x;
+        int y;
+        const std::string* file;
+    };
+    struct ResidentChunk {
+        int x;
+        int y;
+        unsigned int segmentHandle;
+    };
+    struct PendingChunk {
+        int x;
+        int y;
+        std::future<LevelTemplatePtr> result;
+    };
+
+    sf::Vector2f chunkOrigin(int x, int y) const;
+    int focusDistance(int x, int y, const sf::Vector2i& playerChunk, const sf::Vector2i& cameraChunk) const;
+
+    const LevelManager& m_loader;
+    LevelTemplatePtr m_level;
+    const LevelData::StreamingInfo* m_info = nullptr;
+    std::unordered_map<ChunkKey, ChunkRef> m_chunkTable;
+    std::unordered_map<ChunkKey, ResidentChunk> m_resident;
+    std::unordered_map<ChunkKey, PendingChunk> m_pending;
+    std::unordered_set<ChunkKey> m_failed; // bad chunk files are not retried every frame
+    sf::Vector2i m_originChunk = {0, 0};
+
+    static constexpr int REBASE_DISTANCE = 2; // chunks the player may get from the origin before it moves
+};
+
+#endif // LEVEL_STREAMER_HPP
@@ -0,0 +1,112 @@
+#ifndef LEVEL_TEMPLATE_HPP
+#define LEVEL_TEMPLATE_HPP
+
+#include "PlatformBody.hpp"
+#include "PhysicsTypes.hpp"
+#include "SFML/System/Vector2.hpp"
+#include "SFML/Graphics/Color.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct LevelData {
+    // level handler of the intial rules
+    std::string levelName;
+    int levelNumber = 0;
+    sf::Vector2f playerStartPosition = {100.f, 100.f};
+    sf::Color backgroundColor = sf::Color(20, 20, 40);
+    std::vector<phys::PlatformShape> platforms;
+
+    //moving platform rules
+    struct MovingPlatformInfo {
+        unsigned int id;
+        sf::Vector2f startPosition;
+        char axis = 'x';
+        float distance = 0.f;
+        float cycleDuration = 4.f;
+        int initialDirection = 1;
+    };
+    std::vector<MovingPlatformInfo> movingPlatformDetails;
+
+    //interactible platform rules
+    struct InteractiblePlatformInfo {
+        enum class Interaction { changeSelf, unknown };
+        static Interaction toInteraction(const std::string& type) { return type == "changeSelf" ? Interaction::changeSelf : Interaction::unknown; }
+
+        unsigned int id;
+        std::string interactionType = "changeSelf";
+        Interaction interaction = Interaction::changeSelf;     // interactionType resolved at parse time
+        std::string targetBodyTypeStr;
+        phys::bodyType targetBodyType = phys::bodyType::solid; // targetBodyTypeStr resolved at parse time
+        sf::Color targetTileColor = sf::Color::Transparent;
+        bool hasTargetTileColor = false;
+        bool oneTime = false;
+        float cooldown = 0.0f;
+        unsigned int linkedID = 0;
+    };
+    std::vector<InteractiblePlatformInfo> interactiblePlatformDetails;
+
+    //portal rules
+    struct PortalPlatformInfo {
+    unsigned int id;
+    unsigned int portalID;
+    sf::Vector2f offset{10.f, 0.f};
+};
+    std::vector<PortalPlatformInfo> portalPlatformDetails;
+
+    // streaming rules, only for levels split into chunk files. Chunk files hold just a "platforms" array with
+    // positions relative to their chunk's top-left corner. Platform ids must be unique across the whole level
+    // since interactible links are resolved by id over every resident chunk.
+    struct ChunkEntry {
+        int x = 0;
+        int y = 0;
+        std::string file; // relative to the level base path
+    };
+    struct StreamingInfo {
+        bool enabled = false;
+        float chunkSize = 1024.f;
+        int loadRadius = 1;   // chunks within this distance of the player or camera get loaded
+        int unloadRadius = 2; // and stay resident until they are further than this one
+        int maxPendingLoads = 4;
+        sf::Vector2i startChunk = {0, 0}; // playerStart and the level's own platforms are relative to this chunk
+        bool hasDeathChunkRow = false;
+        int deathChunkRow = 0; // falling below this chunk row kills the player
+        float fallDistance = 1200.f; // how far a falling platform drops before it is gone
+        std::vector<ChunkEntry> chunks;
+    };
+    StreamingInfo streaming;
+};
+
+// Parsed level, frozen. One instance per level is shared (by shared_ptr) between the LevelManager cache,
+// the running world and any extra simulation instances; the per-run state lives in LevelOverlay.
+// Platform shapes have stable addresses for the template's whole lifetime.
+class LevelTemplate {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit LevelTemplate(LevelData data);
+
+    const LevelData& getData() const { return m_data; }
+    const std::vector<phys::PlatformShape>& getPlatforms() const { return m_data.platforms; }
+    std::size_t getPlatformCount() const { return m_data.platforms.size(); }
+
+    // Index of the first platform with this id, or npos.
+    std::size_t findPlatformIndex(unsigned int id) const;
+
+    // Details for the platform at this index, nullptr when the level has none for it.
+    const LevelData::MovingPlatformInfo* getMovingDetail(std::size_t platformIndex) const;
+    const LevelData::InteractiblePlatformInfo* getInteractibleDetail(std::size_t platformIndex) const;
+
+private:
+    LevelData m_data;
+    std::unordered_map<unsigned int, std::size_t> m_indexByID;
+    std::vector<const LevelData::MovingPlatformInfo*> m_movingByIndex;
+    std::vector<const LevelData::InteractiblePlatformInfo*> m_interactibleByIndex;
+};
+
+using LevelTemplatePtr = std::shared_ptr<const LevelTemplate>;
+
+#endif // LEVEL_TEMPLATE_HPP
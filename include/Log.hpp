@@ -0,0 +1,140 @@
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// Lowest level compiled in (CMake T3_LOG_LEVEL): 0 debug, 1 info, 2 warning, 3 error. Call sites below it
+// are gone from the binary, arguments included.
+#ifndef T3_LOG_LEVEL
+#define T3_LOG_LEVEL 1
+#endif
+
+enum class LogLevel { Debug = 0, Info = 1, Warning = 2, Error = 3 };
+
+// One per T3_LOG_* call site, constant initialized. The site is what a queued message points at instead of
+// carrying its text, and where the per-site rate limit keeps its counts.
+struct LogSite {
+    constexpr LogSite(LogLevel level, const char* format) : level(level), format(format) {}
+
+    const LogLevel level;
+    const char* const format;
+    std::atomic<std::int64_t> windowStartUs{0};
+    std::atomic<std::uint32_t> windowCount{0};
+    std::atomic<std::uint32_t> suppressed{0};  // since the site's last message that got through
+};
+
+// Asynchronous logger. A message is the call site plus its raw arguments (numbers as is, strings copied),
+// pushed into a fixed lock-free ring that any thread can write; formatting and the actual write to
+// stdout (debug, info) or stderr (warning, error) happen later on the flush thread. No locks and no allocation
+// on the logging side, so it's fine in the simulation step.
+//
+//   T3_LOG_WARNING("LevelManager Warning: platform {} has no size, using {}x{}", id, width, height);
+//
+// Formats use {} for the next argument. Integers, floats, bools, chars, enums and strings (const char*,
+// std::string, string_view) work. Each site gets RATE_LIMIT messages a second, the rest are counted and
+// reported with the next one that gets through. A full ring drops messages (counted, reported) instead of waiting.
+//
+// Before start() and after stop() messages are formatted and written right away on the calling thread, so
+// tools linking the same sources without a flush thread still see them.
+class Log {
+public:
+    static constexpr std::size_t MAX_ARGS = 8;
+    static constexpr std::size_t TEXT_CAPACITY = 256;      // string arguments of one message, truncated past this
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;    // messages, power of two
+    static constexpr std::uint32_t RATE_LIMIT = 10;        // per site per second
+
+    enum class ArgType : std::uint8_t { Int, UInt, Double, Bool, Char, String };
+
+    struct Record {
+        const LogSite* site;
+        std::int64_t timeUs;
+        std::uint64_t position;   // in the ring, for commit
+        std::uint32_t suppressed;
+        std::uint8_t argCount;
+        std::uint16_t textUsed;
+        ArgType types[MAX_ARGS];
+        union Value {
+            std::int64_t i;
+            std::uint64_t u;
+            double d;
+            char c;
+            struct { std::uint16_t offset, length; } text;
+        } values[MAX_ARGS];
+        char text[TEXT_CAPACITY];
+
+        template <typename T>
+        void add(const T& value) {
+            if (argCount == MAX_ARGS) return;
+            Value& slot = values[argCount];
+            ArgType& type = types[argCount++];
+            if constexpr (std::is_same_v<T, bool>) {
+                type = ArgType::Bool;
+                slot.u = value ? 1 : 0;
+            } else if constexpr (std::is_same_v<T, char>) {
+                type = ArgType::Char;
+                slot.c = value;
+            } else if constexpr (std::is_enum_v<T>) {
+                type = ArgType::Int;
+                slot.i = static_cast<std::int64_t>(value);
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                type = ArgType::Int;
+                slot.i = value;
+            } else if constexpr (std::is_integral_v<T>) {
+                type = ArgType::UInt;
+                slot.u = value;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                type = ArgType::Double;
+                slot.d = static_cast<double>(value);
+            } else if constexpr (std::is_pointer_v<T>) {
+                static_assert(std::is_convertible_v<T, const char*>, "Log: pointer arguments have to be strings");
+                type = ArgType::String;
+                addText(slot, value ? std::string_view(value) : std::string_view("(null)"));
+            } else {
+                static_assert(std::is_convertible_v<const T&, std::string_view>, "Log: unsupported argument type");
+                type = ArgType::String;
+                addText(slot, std::string_view(value));
+            }
+        }
+
+        void addText(Value& slot, std::string_view value);
+    };
+
+    static void start();
+    // Writes out whatever is still queued and joins the flush thread. Also runs at exit.
+    static void stop();
+    static bool isRunning();
+    static std::uint64_t getDropped();
+
+    template <typename... Args>
+    static void write(LogSite& site, const Args&... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Log: too many arguments");
+        Record* record = beginRecord(site);
+        if (!record) return;
+        (record->add(args), ...);
+        commitRecord(record);
+    }
+
+private:
+    // nullptr when the site is over its rate limit or the ring is full
+    static Record* beginRecord(LogSite& site);
+    static void commitRecord(Record* record);
+};
+
+#define T3_LOG(level, format, ...)                                              \
+    do {                                                                        \
+        if constexpr (static_cast<int>(level) >= T3_LOG_LEVEL) {                \
+            static LogSite t3LogSite(level, format);                            \
+            Log::write(t3LogSite, ##__VA_ARGS__);                               \
+        }                                                                       \
+    } while (0)
+
+#define T3_LOG_DEBUG(format, ...) T3_LOG(LogLevel::Debug, format, ##__VA_ARGS__)
+#define T3_LOG_INFO(format, ...) T3_LOG(LogLevel::Info, format, ##__VA_ARGS__)
+#define T3_LOG_WARNING(format, ...) T3_LOG(LogLevel::Warning, format, ##__VA_ARGS__)
+#define T3_LOG_ERROR(format, ...) T3_LOG(LogLevel::Error, format, ##__VA_ARGS__)
+
+#endif // LOG_HPP
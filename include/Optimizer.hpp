@@ -2,7 +2,6 @@
 #define OPTIMIZER_HPP
 
 #include <cmath>   // For std::pow, std::cos, std::sin
-#include <numbers> // For std::numbers::pi_v (C++20)
 //i am not touching anything here cuz idk anything here
 // just note none of this is ai but a snippet from a code i found online
 // this has gone kaput and i will not be using this until further notice and realized its effects alr
@@ -11,15 +10,9 @@
 // i just copied it like a dumbass
 //https://code.markrichards.ninja/sfml/sfml-platformer-in-less-than-1-million-lines-part-2
 // t: current time, b: beginning value, c: change in value, d: duration
-// Define a PI constant for use within this header, preferring std::numbers
+// The game eases with Easing.hpp now, these stay as the reference it's checked and benchmarked against.
 #ifndef PI_FOR_EASING // Use a unique macro name to avoid conflicts
-    #if __cplusplus >= 202002L && __has_include(<numbers>)
-        #define PI_FOR_EASING std::numbers::pi_v<float>
-    #else
-        // Fallback if <numbers> not available or not C++20
-        // Using acos for a high-precision PI is a common trick.
-        #define PI_FOR_EASING static_cast<float>(std::acos(-1.0L))
-    #endif
+    #define PI_FOR_EASING 3.14159265358979323846f // a literal, std::numbers is C++20 and acos would run every call
 #endif
 
 namespace math { 
@@ -0,0 +1,64 @@
+#ifndef PERF_HUD_HPP
+#define PERF_HUD_HPP
+
+#include "RenderQueue.hpp"
+#include "SFML/Graphics/Color.hpp"
+#include "SFML/Graphics/Font.hpp"
+#include "SFML/Graphics/Vertex.hpp"
+#include "SFML/System/Vector2.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// The in-game overlay: a bar graph of the last HISTORY frame times and whatever lines the game print()s.
+// Built so that having it on doesn't show up in what it measures: lines are formatted into a fixed buffer and
+// turned into glyph quads here (no sf::Text, no sf::String), and the vertex buffers keep their capacity, so
+// after the first frames nothing in here allocates. Everything goes through the RenderQueue, the text as one
+// batch on the font texture and the graph as one untextured batch.
+class PerfHud {
+public:
+    static constexpr std::size_t HISTORY = 240;
+    static constexpr std::size_t TEXT_CAPACITY = 2048;
+
+    void setFont(const sf::Font* font, unsigned int characterSize);
+    void setVisible(bool visible) { m_visible = visible; }
+    void toggle() { m_visible = !m_visible; }
+    bool isVisible() const { return m_visible; }
+
+    void addFrameTime(float milliseconds);
+
+    // Starts over this frame's text. print() appends printf style, what doesn't fit in TEXT_CAPACITY is cut off.
+    void beginText() { m_textLength = 0; m_text[0] = '\0'; }
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    void print(const char* format, ...);
+    const char* getText() const { return m_text; }
+
+    // Text with its top left at position, the graph (graphSize) right under it. Uses the queue's current view
+    // and layer. Does nothing without a font or while hidden.
+    void record(RenderQueue& queue, const sf::Vector2f& position, const sf::Vector2f& graphSize);
+
+private:
+    void recordText(RenderQueue& queue, const sf::Vector2f& position);
+    void recordGraph(RenderQueue& queue, const sf::Vector2f& position, const sf::Vector2f& size);
+    void addQuad(std::vector<sf::Vertex>& vertices, float left, float top, float width, float height, const sf::Color& color);
+
+    const sf::Font* m_font = nullptr;
+    unsigned int m_characterSize = 14;
+    bool m_visible = true;
+
+    std::array<float, HISTORY> m_frameTimes{};
+    std::size_t m_nextFrame = 0;
+    std::size_t m_frameCount = 0;
+
+    char m_text[TEXT_CAPACITY] = {};
+    std::size_t m_textLength = 0;
+    float m_textHeight = 0.f;           // of the last recorded text, where the graph goes
+
+    std::vector<sf::Vertex> m_textVertices;
+    std::vector<sf::Vertex> m_graphVertices;
+};
+
+#endif // PERF_HUD_HPP
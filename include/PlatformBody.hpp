@@ -5,52 +5,61 @@
 #include <SFML/Graphics/Rect.hpp>
 #include "PhysicsTypes.hpp"
 
+#include <memory_resource>
+#include <vector>
+
 namespace phys {
 
+    // Spawn description of a platform as it comes out of the level file.
+    // Owned by the LevelTemplate and never mutated after load, so every running copy of a level can point at the same one.
+    struct PlatformShape {
+        unsigned int id = 0;
+        sf::Vector2f position = {0.f, 0.f};
+        float width = 32.f;
+        float height = 32.f;
+        bodyType type = bodyType::platform;
+        bool initiallyFalling = false;
+        sf::Vector2f surfaceVelocity = {0.f, 0.f};
+        unsigned int portalID = 0;
+        sf::Vector2f teleportOffset = {10.f, 0.f};
+    };
+
+    // Runtime platform: only the bits that change while playing (position, type, falling) live here,
+    // everything else is read through the shape. The shape must outlive the body.
+    // Shape positions are in the template's own frame, the overlay knows where that frame sits (LevelOverlay::getSpawnPosition).
     class PlatformBody {
     public:
-        PlatformBody(
-            unsigned int id = 0,
-            const sf::Vector2f& position = {0.f, 0.f},
-            float width = 32.f,
-            float height = 32.f,
-            bodyType type = bodyType::platform,
-            bool initiallyFalling = false,
-            const sf::Vector2f& surfaceVelocity = {0.f, 0.f}
-        );
-
-        void setPortalID(unsigned int id) { m_portalID = id; }
-        unsigned int getPortalID() const { return m_portalID; }
-        void setTeleportOffset(const sf::Vector2f& offset) { m_teleportOffset = offset; }
-        const sf::Vector2f& getTeleportOffset() const { return m_teleportOffset; }
+        explicit PlatformBody(const PlatformShape& shape);
+
         void update(float deltaTime);
 
-        unsigned int getID() const { return m_id; }
+        const PlatformShape& getShape() const { return *m_shape; }
+        unsigned int getID() const { return m_shape->id; }
         const sf::Vector2f& getPosition() const { return m_position; }
-        float getWidth() const { return m_width; }
-        float getHeight() const { return m_height; }
+        float getWidth() const { return m_shape->width; }
+        float getHeight() const { return m_shape->height; }
         sf::FloatRect getAABB() const;
         bodyType getType() const { return m_type; }
+        bodyType getSpawnType() const { return m_shape->type; }
         bool isFalling() const { return m_falling; }
-        const sf::Vector2f& getSurfaceVelocity() const { return m_surfaceVelocity; }
+        const sf::Vector2f& getSurfaceVelocity() const { return m_shape->surfaceVelocity; }
+        unsigned int getPortalID() const { return m_shape->portalID; }
+        const sf::Vector2f& getTeleportOffset() const { return m_shape->teleportOffset; }
 
         void setPosition(const sf::Vector2f& position) { m_position = position; }
         void setFalling(bool falling) { m_falling = falling; }
         void setType(bodyType newType) { m_type = newType; }
 
     private:
-        unsigned int m_id;
+        const PlatformShape* m_shape;
         sf::Vector2f m_position;
-        sf::Vector2f m_velocity;
-        float m_width;
-        float m_height;
         bodyType m_type;
         bool m_falling;
-        sf::Vector2f m_surfaceVelocity;
-        unsigned int m_portalID = 0;
-        sf::Vector2f m_teleportOffset = {10.f, 0.f};
     };
 
+    // A level's runtime bodies, allocated out of its LevelArena (see LevelOverlay).
+    using BodyList = std::pmr::vector<PlatformBody>;
+
 }
 
 #endif
@@ -0,0 +1,99 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "AllocationTracker.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define T3_PROFILE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define T3_PROFILE_HAS_TSC 1
+#endif
+
+// Scoped CPU zones, for seeing where frame time goes on a player's machine. Each thread writes finished zones
+// (name, start, end) into its own ring buffer, no locks and no allocation after the first zone on a thread.
+// Timestamps are raw TSC ticks, turned into microseconds only when a trace is written.
+//
+//   T3_PROFILE_SCOPE("LevelManager::update");      // until the end of the enclosing block
+//   T3_PROFILE_ZONE(step, "sim.input");             // a named zone...
+//   T3_PROFILE_NEXT(step, "sim.collision");         // ...ended and the next one started, for long flat functions
+//
+// Built in with -DT3_PROFILE (CMake T3_PROFILER), otherwise the macros are empty and cost nothing. With
+// T3_ALLOC_TRACKING as well, each zone also carries what its thread allocated inside it (trace args).
+// writeChromeTrace() dumps the last few seconds as trace_event JSON for ui.perfetto.dev or chrome://tracing.
+class Profiler {
+public:
+    static constexpr std::size_t EVENTS_PER_THREAD = 1 << 16;
+
+    static bool isCompiledIn();
+    // Shows up as the thread's name in the trace.
+    static void setThreadName(const char* name);
+    // Zones of every thread that ended in the last `seconds`. false if the file can't be written.
+    static bool writeChromeTrace(const std::string& path, double seconds);
+
+    static std::uint64_t now() {
+#ifdef T3_PROFILE_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+    // name has to outlive the profiler, a string literal.
+    static void record(const char* name, std::uint64_t start, std::uint64_t end, const AllocationTracker::Counts& allocated = {});
+};
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : m_name(name), m_start(Profiler::now()) {}
+    ~ProfileZone() { Profiler::record(m_name, m_start, Profiler::now(), takeAllocated()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    void next(const char* name) {
+        const std::uint64_t now = Profiler::now();
+        Profiler::record(m_name, m_start, now, takeAllocated());
+        m_name = name;
+        m_start = now;
+    }
+
+private:
+    // since the zone (or the last next()) started, and starts counting over
+    AllocationTracker::Counts takeAllocated() {
+#ifdef T3_ALLOC_TRACKING
+        const AllocationTracker::Counts now = AllocationTracker::thisThread();
+        const AllocationTracker::Counts allocated = now - m_allocations;
+        m_allocations = now;
+        return allocated;
+#else
+        return {};
+#endif
+    }
+
+    const char* m_name;
+    std::uint64_t m_start;
+#ifdef T3_ALLOC_TRACKING
+    AllocationTracker::Counts m_allocations = AllocationTracker::thisThread();
+#endif
+};
+
+#ifdef T3_PROFILE
+#define T3_PROFILE_CONCAT_INNER(a, b) a##b
+#define T3_PROFILE_CONCAT(a, b) T3_PROFILE_CONCAT_INNER(a, b)
+#define T3_PROFILE_SCOPE(name) ProfileZone T3_PROFILE_CONCAT(t3ProfileZone, __LINE__)(name)
+#define T3_PROFILE_ZONE(var, name) ProfileZone var(name)
+#define T3_PROFILE_NEXT(var, name) var.next(name)
+#define T3_PROFILE_THREAD(name) Profiler::setThreadName(name)
+#else
+#define T3_PROFILE_SCOPE(name) ((void)0)
+#define T3_PROFILE_ZONE(var, name) ((void)0)
+#define T3_PROFILE_NEXT(var, name) ((void)0)
+#define T3_PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,93 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include "SFML/Graphics/BlendMode.hpp"
+#include "SFML/Graphics/Drawable.hpp"
+#include "SFML/Graphics/PrimitiveType.hpp"
+#include "SFML/Graphics/RenderStates.hpp"
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/Sprite.hpp"
+#include "SFML/Graphics/Texture.hpp"
+#include "SFML/Graphics/Vertex.hpp"
+#include "SFML/Graphics/VertexArray.hpp"
+#include "SFML/Graphics/View.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sits between the game's drawing code and the window. Draws are recorded into a per-frame command list
+// (primitive, vertices, texture, blend, view) and only go to SFML at submit(), sorted so commands sharing a
+// texture and blend mode end up next to each other, and adjacent compatible ones merged into one draw call.
+//
+// Ordering rules: layers draw in increasing order, inside one layer the order is up to the queue (so only put
+// things in the same layer that don't overlap or don't care). setView() and opaque drawables (text, shapes,
+// anything that isn't vertices or a sprite) are barriers, nothing moves across them.
+//
+// submit(nullptr) is the headless mode: nothing is drawn, the frame is only counted and hashed. No GL needed,
+// so CI can check draw calls/state changes and catch rendering changes through the hash.
+class RenderQueue {
+public:
+    struct FrameStats {
+        std::size_t commands = 0;       // as recorded
+        std::size_t drawCalls = 0;      // after sorting and merging
+        std::size_t vertices = 0;
+        std::size_t textureChanges = 0;
+        std::size_t blendChanges = 0;
+        std::size_t viewChanges = 0;
+        std::size_t unsortedStateChanges = 0; // texture + blend changes had the commands gone out as recorded
+        std::uint64_t hash = 0;         // of everything that reached (or would have reached) the target
+        std::size_t stateChanges() const { return textureChanges + blendChanges; }
+    };
+
+    void setView(const sf::View& view);
+    void setLayer(std::uint8_t layer) { m_layer = layer; }
+    std::uint8_t getLayer() const { return m_layer; }
+
+    // Vertices are copied (and pre-transformed by states.transform), the caller can reuse its buffer right away.
+    // Shaders aren't supported.
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default);
+    // Recorded as a textured quad, so it can batch with everything else on the same texture.
+    void draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+    // Anything else. Kept by pointer, so it has to live until submit(). Barrier.
+    void drawOpaque(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Sorts, merges and draws everything recorded since the last submit, then clears the queue.
+    // nullptr: headless, only the stats and hash are produced.
+    void submit(sf::RenderTarget* target);
+    void clear();
+
+    const FrameStats& getLastFrameStats() const { return m_stats; }
+
+private:
+    struct Command {
+        std::uint64_t sortKey;        // segment, layer, blend, texture
+        std::uint32_t sequence;       // record order, tie breaker
+        sf::PrimitiveType type;
+        std::uint32_t firstVertex;
+        std::uint32_t vertexCount;
+        std::uint16_t texture;        // into m_textures, 0 = none
+        std::uint16_t blend;          // into m_blends
+        std::uint32_t view;           // into m_views
+        const sf::Drawable* opaque;   // set for drawOpaque() commands
+        sf::RenderStates opaqueStates;
+    };
+
+    std::uint16_t textureIndex(const sf::Texture* texture);
+    std::uint16_t blendIndex(const sf::BlendMode& blend);
+    void push(Command command);
+    static bool isBatchable(sf::PrimitiveType type);
+
+    std::vector<Command> m_commands;
+    std::vector<sf::Vertex> m_vertices;
+    std::vector<const sf::Texture*> m_textures; // [0] is nullptr, then in order of first use this frame
+    std::vector<sf::BlendMode> m_blends;
+    std::vector<sf::View> m_views;
+    std::vector<sf::Vertex> m_merged;          // scratch for merged runs at submit
+    std::uint32_t m_segment = 0;
+    std::uint8_t m_layer = 0;
+    FrameStats m_stats;
+};
+
+#endif // RENDER_QUEUE_HPP
@@ -0,0 +1,78 @@
+#ifndef SCENARIO_BENCH_HPP
+#define SCENARIO_BENCH_HPP
+
+#include "LatencyStats.hpp"
+#include "PhysicsTypes.hpp"
+#include "SFML/Window/Keyboard.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// End to end cost of the fixed step, T3_SCENARIO_BENCH=<csv>. main loads every shipped level plus a few synthetic
+// stress levels, no window, and steps each one back to back for a fixed number of ticks with a script at the
+// keys instead of a player. Every step is timed; per scenario the CSV gets mean, p50, p99 and max, under a
+// header saying what machine and build produced it.
+//
+// Ticks only compare on the same machine, so the baseline is an earlier CSV from that machine
+// (T3_SCENARIO_BASELINE). A scenario whose p99 ends up more than the tolerance over the baseline's fails the run.
+class ScenarioBench {
+public:
+    // One stretch of the script. The player is put on the next platform of `target` (or left where it is for
+    // none), then `hold` stays down and `tap` goes down and up every tapEvery ticks, for `ticks` steps.
+    struct Phase {
+        const char* name;
+        phys::bodyType target;
+        bool inside;                 // put it in the platform's middle instead of on top (portals)
+        int ticks;
+        sf::Keyboard::Key hold[2];   // Unknown = nothing
+        sf::Keyboard::Key tap;
+        int tapEvery;
+    };
+
+    struct Result {
+        std::string scenario;
+        std::size_t platforms = 0;
+        std::uint64_t ticks = 0;
+        std::uint64_t restarts = 0;  // deaths and goals, the level got set up again (not timed)
+        double meanUs = 0.0;
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+        double maxUs = 0.0;
+    };
+
+    // Phases with a target the level doesn't have are skipped.
+    static const std::vector<Phase>& getScript();
+
+    // Platform counts of the synthetic levels, and the level itself: LevelGenerator's default mix with a fixed
+    // seed, laid out to stay above the death line. Level JSON, same as a level file.
+    static const std::vector<std::size_t>& getStressSizes();
+    static std::string makeStressLevelJson(std::size_t platformCount);
+
+    explicit ScenarioBench(std::uint64_t ticksPerScenario = 100000);
+
+    void begin(const std::string& scenario, std::size_t platforms);
+    void addTick(double microseconds) { m_ticks.add(microseconds / 1000.0); }
+    void addRestart() { ++m_restarts; }
+    void end();
+
+    std::uint64_t getTicksPerScenario() const { return m_ticksPerScenario; }
+    const std::vector<Result>& getResults() const { return m_results; }
+
+    bool writeCsv(const std::string& path, int tickRate) const;
+    static bool readCsv(const std::string& path, std::vector<Result>& outResults);
+
+    // Logs and counts the scenarios whose p99 is more than tolerance (0.1 = 10%) over the baseline's. Scenarios
+    // missing from either side are left out.
+    std::size_t checkBaseline(const std::vector<Result>& baseline, double tolerance) const;
+
+private:
+    std::uint64_t m_ticksPerScenario;
+    LatencyStats m_ticks;
+    Result m_current;
+    std::uint64_t m_restarts = 0;
+    std::vector<Result> m_results;
+};
+
+#endif // SCENARIO_BENCH_HPP
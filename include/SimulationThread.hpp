@@ -0,0 +1,72 @@
+#ifndef SIMULATION_THREAD_HPP
+#define SIMULATION_THREAD_HPP
+
+#include "LatencyStats.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Calls the game's fixed step on its own thread at the tick rate, so ticks land on schedule no matter how long
+// a frame takes to render (or how long the window blocks in a resize/drag). This class only does the timing,
+// the step itself reads its input from a queue and publishes what it produced, see main.cpp.
+//
+// Starts paused. setRunning(false) doesn't return while a step is in flight, after it the caller owns the world
+// again (level loads, respawns). A step returning false pauses the thread by itself (the run ended).
+class SimulationThread {
+public:
+    // Gets the time the tick was scheduled for (LatencyStats::nowMicros() clock), input up to there belongs to it.
+    using StepFunction = std::function<bool(std::int64_t)>;
+
+    SimulationThread() = default;
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start(StepFunction step);
+    void stop();
+    bool isStarted() const { return m_thread.joinable(); }
+
+    void setRunning(bool running);
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // Take effect on the next setRunning(true), safe to call while the thread runs.
+    void setTickRate(int ticksPerSecond);
+    void setMaxCatchUpSteps(int steps);
+
+    std::uint64_t getTickCount() const { return m_ticks.load(std::memory_order_relaxed); }
+    // Backlog thrown away after stalls longer than the catch-up cap.
+    double getDroppedMs() const { return static_cast<double>(m_droppedUs.load(std::memory_order_relaxed)) / 1000.0; }
+
+    // How late ticks started against their schedule, collected while enabled. takeJitter() also clears it.
+    void setMeasureJitter(bool enabled) { m_measureJitter.store(enabled, std::memory_order_relaxed); }
+    LatencyStats::Summary takeJitter();
+
+private:
+    void run();
+
+    std::thread m_thread;
+    StepFunction m_step;
+
+    std::mutex m_stateMutex;          // m_running changes, the wake up
+    std::condition_variable m_wake;
+    std::mutex m_stepMutex;           // held for the duration of a step
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_quit{false};
+
+    // written from the main thread whenever, the sim thread copies them when it (re)starts
+    std::atomic<std::int64_t> m_tickUs{1000000 / 60};
+    std::atomic<int> m_maxCatchUpSteps{8};
+    std::atomic<std::uint64_t> m_ticks{0};
+    std::atomic<std::int64_t> m_droppedUs{0};
+
+    std::atomic<bool> m_measureJitter{false};
+    std::mutex m_jitterMutex;
+    LatencyStats m_jitter;
+};
+
+#endif // SIMULATION_THREAD_HPP
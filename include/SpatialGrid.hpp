@@ -0,0 +1,78 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include "SFML/Graphics/Rect.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid over world space for "what is near this rect" queries. Items are small integer ids (an index into
+// whatever array the caller owns) with a bounding rect, an item is listed in every cell its rect touches.
+// A query visits the cells under the area only, so its cost follows the area, not how many items there are.
+// Cells are hashed, the world can be any size or go negative.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 256.f) : m_cellSize(cellSize) {}
+
+    void clear();
+    // Only while empty.
+    void setCellSize(float cellSize) { if (m_itemCount == 0) m_cellSize = cellSize; }
+    float getCellSize() const { return m_cellSize; }
+
+    void insert(std::uint32_t id, const sf::FloatRect& bounds);
+    void remove(std::uint32_t id);
+    // For things that move (entities). Cheap when the item stays in the same cells.
+    void update(std::uint32_t id, const sf::FloatRect& bounds);
+
+    std::size_t size() const { return m_itemCount; }
+    std::size_t getCellCount() const { return m_cells.size(); }
+
+    // Calls visit(id) once per item whose rect intersects area. Items are not in any particular order.
+    template <typename Visitor>
+    void query(const sf::FloatRect& area, Visitor&& visit) const {
+        if (m_itemCount == 0) return;
+        CellRange range = cellsFor(area);
+        if (++m_queryStamp == 0) { // wrapped, forget every old stamp
+            std::fill(m_stamps.begin(), m_stamps.end(), 0u);
+            m_queryStamp = 1;
+        }
+        for (int cy = range.y0; cy <= range.y1; ++cy) {
+            for (int cx = range.x0; cx <= range.x1; ++cx) {
+                auto cell = m_cells.find(key(cx, cy));
+                if (cell == m_cells.end()) continue;
+                for (std::uint32_t id : cell->second) {
+                    if (m_stamps[id] == m_queryStamp) continue; // already seen through another cell
+                    m_stamps[id] = m_queryStamp;
+                    if (m_bounds[id].intersects(area)) visit(id);
+                }
+            }
+        }
+    }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+        bool operator==(const CellRange& other) const { return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1; }
+    };
+
+    static std::uint64_t key(int cx, int cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+    }
+    CellRange cellsFor(const sf::FloatRect& bounds) const;
+    void link(std::uint32_t id, const CellRange& range);
+    void unlink(std::uint32_t id, const CellRange& range);
+
+    float m_cellSize;
+    std::size_t m_itemCount = 0;
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> m_cells;
+    std::vector<sf::FloatRect> m_bounds; // by id
+    std::vector<CellRange> m_ranges;     // by id
+    std::vector<bool> m_present;         // by id
+    mutable std::vector<std::uint32_t> m_stamps;
+    mutable std::uint32_t m_queryStamp = 0;
+};
+
+#endif // SPATIAL_GRID_HPP
@@ -0,0 +1,58 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include "SFML/Config.hpp"
+#include "SFML/Graphics/Image.hpp"
+#include "SFML/Graphics/Rect.hpp"
+#include "SFML/Graphics/Texture.hpp"
+#include "SFML/System/Vector2.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Every sprite in one texture, so anything textured can go into the same vertex array (one bind, one draw call).
+// Built once at startup: add*() queues frames, build() scales them down, shelf packs them and uploads the result.
+// The source art is 1024px+ per frame, each frame is box filtered down to fit maxFrameSize on its longer side
+// (aspect kept), nothing is ever drawn bigger than that anyway.
+//
+// Also holds a small solid white block, getWhiteRect(), so plain coloured quads can share the texture too.
+class TextureAtlas {
+public:
+    struct Animation {
+        std::vector<sf::IntRect> frames; // texel rects in the atlas, in play order
+        std::vector<sf::Uint16> ids;     // the same frames as indices into getFrames()
+    };
+
+    // A sprite sheet cut into columns x rows equal cells. cells picks which ones are frames and in which order
+    // (x = column, y = row), empty takes all of them row by row.
+    void addSheet(const std::string& name, const sf::Image& sheet, unsigned int columns, unsigned int rows,
+                  const std::vector<sf::Vector2u>& cells, unsigned int maxFrameSize);
+    // One image per frame.
+    void addFrames(const std::string& name, const std::vector<const sf::Image*>& frames, unsigned int maxFrameSize);
+
+    // Packs and uploads everything added so far. Needs a GL context. false if it doesn't fit the GPU's max size.
+    bool build();
+
+    const sf::Texture& getTexture() const { return m_texture; }
+    const Animation* find(const std::string& name) const;
+    const sf::IntRect& getWhiteRect() const { return m_frames.empty() ? m_noFrame : m_frames.front(); }
+    // Every frame rect by id, what Tile::frame indexes. Id 0 is the white block.
+    const std::vector<sf::IntRect>& getFrames() const { return m_frames; }
+
+private:
+    struct PendingFrame {
+        std::string name;
+        sf::Image image;
+    };
+
+    static sf::Image scaleDown(const sf::Image& source, const sf::IntRect& area, unsigned int maxFrameSize);
+
+    std::vector<PendingFrame> m_pending;
+    std::map<std::string, Animation> m_animations;
+    sf::Texture m_texture;
+    std::vector<sf::IntRect> m_frames;
+    sf::IntRect m_noFrame;
+};
+
+#endif // TEXTURE_ATLAS_HPP
@@ -1,40 +1,43 @@
 #ifndef TILE_HPP
 #define TILE_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/System/Time.hpp>
-#include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/RenderStates.hpp>
-#include <SFML/Graphics/Drawable.hpp>
-#include <SFML/Graphics/Transformable.hpp>
-
-class Tile : public sf::Drawable, public sf::Transformable {
-public:
-    Tile(const sf::Vector2f& size = {32.f, 32.f},
-         const sf::Color& color = sf::Color::White);
-
-    void startFalling(sf::Time delay);
-    void update(sf::Time deltaTime);
-
-    bool isFalling() const { return m_isFalling; }
-    bool hasFallen() const { return m_hasFallen; }
-
-    void setFillColor(const sf::Color& color) { m_shape.setFillColor(color); }
-    const sf::Color& getFillColor() const { return m_shape.getFillColor(); }
-    void setTexture(const sf::Texture* texture, bool resetRect = false) { m_shape.setTexture(texture, resetRect); }
-
-    sf::FloatRect getGlobalBounds() const;
-    sf::FloatRect getLocalBounds() const;
-
-
-private:
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-
-    sf::RectangleShape m_shape;
-    bool m_isFalling;
-    sf::Time m_fallDelayTimer;
-    bool m_hasFallen;
-    float m_fallSpeed;
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <type_traits>
+
+// Render side of one platform, tiles[i] draws world.bodies[i]. Plain data, 24 bytes: TileBatchRenderer builds
+// the quad, the runtime state (falling timers etc.) lives in LevelOverlay next to the body.
+// frame indexes the renderer's frame table (TextureAtlas::getFrames()), 0 is the plain white block.
+struct Tile {
+    enum Flags : sf::Uint8 {
+        Hidden = 1 << 0 // fallen/removed, skipped until shown again
+    };
+
+    sf::Vector2f position;
+    sf::Vector2f size;
+    sf::Uint32 color = 0xFFFFFFFF; // sf::Color::toInteger()
+    sf::Uint16 frame = 0;
+    sf::Uint8 flags = 0;
+
+    void setPosition(const sf::Vector2f& pos) { position = pos; }
+    const sf::Vector2f& getPosition() const { return position; }
+    void move(const sf::Vector2f& delta) { position += delta; }
+
+    void setFillColor(const sf::Color& fill) { color = fill.toInteger(); }
+    sf::Color getFillColor() const { return sf::Color(color); }
+
+    void setHidden(bool hidden) { flags = static_cast<sf::Uint8>(hidden ? (flags | Hidden) : (flags & ~Hidden)); }
+    bool isHidden() const { return (flags & Hidden) != 0; }
+    // hidden or fully transparent, nothing to draw
+    bool isVisible() const { return !isHidden() && (color & 0xFF) != 0; }
+
+    sf::FloatRect getGlobalBounds() const { return isHidden() ? sf::FloatRect() : sf::FloatRect(position, size); }
 };
 
-#endif
\ No newline at end of file
+static_assert(sizeof(Tile) == 24, "Tile is meant to stay a small plain record");
+static_assert(std::is_trivially_copyable<Tile>::value, "Tile is copied around in bulk");
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef TILE_BATCH_RENDERER_HPP
+#define TILE_BATCH_RENDERER_HPP
+
+#include "Tile.hpp"
+#include "SpatialGrid.hpp"
+#include "RenderQueue.hpp"
+#include "SFML/Graphics/Drawable.hpp"
+#include "SFML/Graphics/Rect.hpp"
+#include "SFML/Graphics/RenderStates.hpp"
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/RenderTexture.hpp"
+#include "SFML/Graphics/Texture.hpp"
+#include "SFML/Graphics/VertexArray.hpp"
+#include "SFML/Graphics/View.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Draws a tile list as one vertex array (two triangles per tile), so the tiles cost one draw call instead of one
+// per tile. Tiles are plain records, all of them share one texture (the sprite atlas) and pick their rect by
+// frame id out of the table given to setTexture(). Without a texture they're flat coloured, alpha blended.
+//
+// The tiles stay the source of truth. rebuild() sorts them into static and dynamic and indexes them in a
+// SpatialGrid. Each frame cull() looks up what the view (plus a margin) touches and writes only those quads, so
+// the CPU side of a frame follows what is on screen, not the level size. A static tile that changes anyway
+// needs a rebuild().
+//
+// With static caching on (the default) the static tiles are not in the vertex arrays at all: rebuild() rasterizes
+// them once into CHUNK_SIZE render textures and cull() only picks the chunks overlapping the view, the dynamic
+// layers go on top. Needs a GL context at rebuild(), if a render texture can't be created it falls back to
+// plain vertex arrays.
+class TileBatchRenderer : public sf::Drawable {
+public:
+    static constexpr unsigned int CHUNK_SIZE = 512;
+
+    // Everywhere tiles[i] can still be drawn from now on (its bounds plus wherever it can move to).
+    // An empty rect marks a static tile, one that never moves or changes colour again.
+    using MotionBounds = std::function<sf::FloatRect(std::size_t)>;
+
+    void rebuild(const std::vector<Tile>& tiles, const MotionBounds& motionBounds);
+    // Picks what intersects the view rect grown by the cull margin and refreshes those quads from the tiles.
+    void cull(const std::vector<Tile>& tiles, const sf::View& view);
+    // Same as drawing it, through the queue: the chunks go in the queue's current layer, the dynamic tiles one
+    // layer above (they overlap the chunks). The chunk textures are referenced, don't rebuild before the submit.
+    void record(RenderQueue& queue) const;
+    void clear();
+
+    // frames[id] is the texel rect for Tile::frame == id. Takes effect on the next rebuild().
+    void setTexture(const sf::Texture* texture, const std::vector<sf::IntRect>& frames);
+    // previousPositions[i] is where tiles[i] was one tick ago, cull() draws the dynamic tiles blended from there
+    // by alpha (see Interpolation.hpp). nullptr draws them where they are. The vector has to outlive the culls.
+    void setInterpolation(const std::vector<sf::Vector2f>* previousPositions, float alpha);
+
+    // Takes effect on the next rebuild().
+    void setStaticCaching(bool enabled) { m_staticCaching = enabled; }
+    bool isStaticCaching() const { return m_staticCaching; }
+    void setCullMargin(float margin) { m_cullMargin = margin; }
+
+    struct CullStats {
+        std::size_t tiles = 0;         // in the grid (everything not baked into chunks)
+        std::size_t visited = 0;       // tiles the grid handed back for the view
+        std::size_t drawn = 0;         // of those, the ones actually on screen and visible
+        std::size_t culled = 0;        // tiles - drawn
+        std::size_t chunks = 0;        // baked static chunks
+        std::size_t visibleChunks = 0;
+    };
+    const CullStats& getCullStats() const { return m_stats; }
+
+    std::size_t getTileCount() const { return m_tileCount; }
+    std::size_t getDynamicCount() const { return m_dynamicCount; }
+    std::size_t getCachedChunkCount() const { return m_chunks.size(); }
+    std::size_t getDrawCallCount() const;
+
+private:
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    struct StaticChunk {
+        sf::FloatRect bounds;
+        std::unique_ptr<sf::RenderTexture> texture; // not movable in SFML 2
+    };
+
+    void writeQuad(const Tile& tile, const sf::Vector2f& position, sf::VertexArray& vertices, std::size_t firstVertex) const;
+    bool rasterizeStatic(const std::vector<Tile>& tiles, const std::vector<std::size_t>& staticTiles);
+
+    const sf::Texture* m_texture = nullptr;
+    std::vector<sf::IntRect> m_frames;
+    const std::vector<sf::Vector2f>* m_previousPositions = nullptr;
+    float m_alpha = 1.f;
+    sf::VertexArray m_vertices{sf::Triangles}; // the visible non-baked tiles, refilled by every cull()
+    std::vector<StaticChunk> m_chunks;
+    SpatialGrid m_tileGrid{256.f};                          // tile indices, by motion bounds
+    SpatialGrid m_chunkGrid{static_cast<float>(CHUNK_SIZE)}; // indices into m_chunks
+    std::vector<std::size_t> m_visibleTiles;
+    std::vector<std::size_t> m_visibleChunks;
+
+    std::size_t m_tileCount = 0;
+    std::size_t m_dynamicCount = 0;
+    bool m_staticCaching = true;
+    float m_cullMargin = 64.f;
+    CullStats m_stats;
+};
+
+#endif // TILE_BATCH_RENDERER_HPP
@@ -0,0 +1,47 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// One writer thread, one reader thread, no locks. The writer fills back() and publish()es it, the reader
+// acquire()s the newest published slot and reads front() until the next acquire. Neither side ever waits, the
+// writer just overwrites what the reader hasn't picked up yet (a skipped frame, not a stall).
+//
+// Slots are reused, not cleared: back() holds whatever was written into it two or three publishes ago.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- writer ---
+    T& back() { return m_slots[m_back]; }
+    void publish() {
+        const std::uint8_t previous = m_middle.exchange(static_cast<std::uint8_t>(m_back | FRESH), std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    // --- reader ---
+    // true if a newer slot was swapped in
+    bool acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        const std::uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+    const T& front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4; // middle holds something the reader hasn't seen
+
+    std::array<T, 3> m_slots{};
+    std::atomic<std::uint8_t> m_middle{1};
+    std::uint8_t m_back = 0;  // writer only
+    std::uint8_t m_front = 2; // reader only
+};
+
+#endif // TRIPLE_BUFFER_HPP
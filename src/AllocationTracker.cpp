@@ -0,0 +1,90 @@
+#include "AllocationTracker.hpp"
+
+#ifdef T3_ALLOC_TRACKING
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> allocatedBytes{0};
+    // plain integers, no constructor, so touching them from inside operator new can't recurse
+    thread_local std::uint64_t threadAllocationCount = 0;
+    thread_local std::uint64_t threadAllocatedBytes = 0;
+
+    void* allocate(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        ++threadAllocationCount;
+        threadAllocatedBytes += size;
+        if (size == 0) size = 1;
+        for (;;) {
+            if (void* memory = std::malloc(size)) return memory;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) return nullptr;
+            handler();
+        }
+    }
+}
+
+bool AllocationTracker::isEnabled() {
+    return true;
+}
+
+AllocationTracker::Counts AllocationTracker::total() {
+    return {allocationCount.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed)};
+}
+
+AllocationTracker::Counts AllocationTracker::thisThread() {
+    return {threadAllocationCount, threadAllocatedBytes};
+}
+
+// The aligned overloads are left to the library, they come with their own matching deletes.
+void* operator new(std::size_t size) {
+    if (void* memory = allocate(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* memory = allocate(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) { // a new_handler giving up
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) { // a new_handler giving up
+        return nullptr;
+    }
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+
+#else
+
+bool AllocationTracker::isEnabled() {
+    return false;
+}
+
+AllocationTracker::Counts AllocationTracker::total() {
+    return {};
+}
+
+AllocationTracker::Counts AllocationTracker::thisThread() {
+    return {};
+}
+
+#endif
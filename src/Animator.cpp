@@ -0,0 +1,49 @@
+#include "Animator.hpp"
+
+Animator::Animator(const TextureAtlas::Animation* animation, float framesPerSecond, bool loop)
+    : m_animation(animation),
+      m_frameDuration(framesPerSecond > 0.f ? 1.f / framesPerSecond : 0.1f),
+      m_loop(loop) {
+}
+
+void Animator::update(float deltaSeconds) {
+    if (!m_playing || !isValid()) return;
+    const std::size_t frameCount = m_animation->frames.size();
+    m_time += deltaSeconds;
+    while (m_time >= m_frameDuration) {
+        m_time -= m_frameDuration;
+        if (m_frame + 1 < frameCount) {
+            ++m_frame;
+        } else if (m_loop) {
+            m_frame = 0;
+        } else {
+            m_time = 0.f;
+            m_playing = false;
+            break;
+        }
+    }
+}
+
+void Animator::restart() {
+    m_time = 0.f;
+    m_frame = 0;
+    m_playing = true;
+}
+
+void Animator::setAnimation(const TextureAtlas::Animation* animation) {
+    if (animation == m_animation) return;
+    m_animation = animation;
+    if (!isValid() || m_frame >= m_animation->frames.size()) m_frame = 0;
+}
+
+bool Animator::isFinished() const {
+    return !m_loop && !m_playing && isValid() && m_frame + 1 == m_animation->frames.size();
+}
+
+sf::IntRect Animator::getFrameRect() const {
+    return isValid() ? m_animation->frames[m_frame] : sf::IntRect();
+}
+
+sf::Uint16 Animator::getFrameId() const {
+    return isValid() && m_frame < m_animation->ids.size() ? m_animation->ids[m_frame] : 0;
+}
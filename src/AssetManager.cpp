@@ -0,0 +1,248 @@
+#include "AssetManager.hpp"
+#include "AssetPack.hpp"
+#include "Log.hpp"
+#include "SFML/Audio/InputSoundFile.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+AssetManager::AssetManager(unsigned int workerCount) {
+    if (const char* env = std::getenv("T3_ASSET_THREADS")) {
+        int forced = std::atoi(env);
+        if (forced > 0) workerCount = static_cast<unsigned int>(forced);
+    }
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_stats.workers = workerCount;
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&AssetManager::workerLoop, this);
+    }
+}
+
+AssetManager::~AssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_stopping = true;
+    }
+    m_jobReady.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void AssetManager::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobReady.notify_one();
+}
+
+void AssetManager::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobReady.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping && m_jobs.empty()) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
+
+AssetManager::DecodedImage AssetManager::decodeImage(const std::string& path) const {
+    DecodedImage decoded;
+    AssetPack::View packed = m_pack ? m_pack->find(AssetPack::keyFor(path)) : AssetPack::View();
+    decoded.ok = packed ? decoded.image.loadFromMemory(packed.data, packed.size) : decoded.image.loadFromFile(path);
+    return decoded;
+}
+
+AssetManager::DecodedSound AssetManager::decodeSound(const std::string& path) const {
+    DecodedSound decoded;
+    sf::InputSoundFile file;
+    {
+        std::lock_guard<std::mutex> lock(m_soundOpenMutex);
+        AssetPack::View packed = m_pack ? m_pack->find(AssetPack::keyFor(path)) : AssetPack::View();
+        if (!(packed ? file.openFromMemory(packed.data, packed.size) : file.openFromFile(path))) {
+            return decoded;
+        }
+    }
+    // the actual decode runs unlocked
+    decoded.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+    sf::Uint64 read = file.read(decoded.samples.data(), file.getSampleCount());
+    decoded.samples.resize(static_cast<std::size_t>(read));
+    decoded.channelCount = file.getChannelCount();
+    decoded.sampleRate = file.getSampleRate();
+    decoded.ok = read > 0;
+    return decoded;
+}
+
+void AssetManager::preloadTexture(const std::string& path) {
+    if (m_textures.count(path) || m_pendingImages.count(path)) return;
+    if (!m_preloadRunning) {
+        m_preloadRunning = true;
+        m_preloadStart = std::chrono::steady_clock::now();
+    }
+    auto task = std::make_shared<std::packaged_task<DecodedImage()>>([this, path] { return decodeImage(path); });
+    m_pendingImages.emplace(path, task->get_future());
+    enqueue([task] { (*task)(); });
+}
+
+void AssetManager::preloadSoundBuffer(const std::string& path) {
+    if (m_sounds.count(path) || m_pendingSounds.count(path)) return;
+    if (!m_preloadRunning) {
+        m_preloadRunning = true;
+        m_preloadStart = std::chrono::steady_clock::now();
+    }
+    auto task = std::make_shared<std::packaged_task<DecodedSound()>>([this, path] { return decodeSound(path); });
+    m_pendingSounds.emplace(path, task->get_future());
+    enqueue([task] { (*task)(); });
+}
+
+std::size_t AssetManager::loadImages(const std::vector<std::string>& paths, std::vector<sf::Image>& out) {
+    std::vector<std::future<DecodedImage>> pending;
+    pending.reserve(paths.size());
+    for (const std::string& path : paths) {
+        auto task = std::make_shared<std::packaged_task<DecodedImage()>>([this, path] { return decodeImage(path); });
+        pending.push_back(task->get_future());
+        enqueue([task] { (*task)(); });
+    }
+    std::size_t failed = 0;
+    out.assign(paths.size(), sf::Image());
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        DecodedImage decoded = pending[i].get();
+        if (decoded.ok) {
+            out[i] = std::move(decoded.image);
+        } else {
+            T3_LOG_ERROR("AssetManager Error: Failed to load image {}", paths[i]);
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+std::size_t AssetManager::finishPreloads() {
+    std::size_t failed = 0;
+    std::size_t finished = 0;
+    for (auto& pending : m_pendingImages) {
+        if (!uploadTexture(pending.first, pending.second.get(), false)) ++failed;
+        ++finished;
+    }
+    m_pendingImages.clear();
+    for (auto& pending : m_pendingSounds) {
+        if (!uploadSound(pending.first, pending.second.get())) ++failed;
+        ++finished;
+    }
+    m_pendingSounds.clear();
+
+    if (m_preloadRunning) {
+        m_preloadRunning = false;
+        m_stats.preloaded += finished;
+        m_stats.lastPreloadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_preloadStart).count();
+    }
+    return failed;
+}
+
+TextureHandle AssetManager::uploadTexture(const std::string& path, DecodedImage decoded, bool smooth) {
+    if (!decoded.ok) {
+        T3_LOG_ERROR("AssetManager Error: Failed to load image {}", path);
+        return nullptr;
+    }
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(decoded.image)) {
+        T3_LOG_ERROR("AssetManager Error: Failed to create texture for {}", path);
+        return nullptr;
+    }
+    texture->setSmooth(smooth);
+    m_textures[path] = texture;
+    return texture;
+}
+
+SoundBufferHandle AssetManager::uploadSound(const std::string& path, DecodedSound decoded) {
+    if (!decoded.ok) {
+        T3_LOG_ERROR("AssetManager Error: Failed to load sound {}", path);
+        return nullptr;
+    }
+    auto buffer = std::make_shared<sf::SoundBuffer>();
+    if (!buffer->loadFromSamples(decoded.samples.data(), decoded.samples.size(), decoded.channelCount, decoded.sampleRate)) {
+        T3_LOG_ERROR("AssetManager Error: Failed to create sound buffer for {}", path);
+        return nullptr;
+    }
+    m_sounds[path] = buffer;
+    return buffer;
+}
+
+TextureHandle AssetManager::getTexture(const std::string& path, bool smooth) {
+    auto it = m_textures.find(path);
+    if (it != m_textures.end()) {
+        ++m_stats.hits;
+        // the texture is shared, switching its filtering would change it under everyone already holding it
+        if (it->second->isSmooth() != smooth) {
+            T3_LOG_WARNING("AssetManager Warning: {} was loaded with smooth={}, keeping that", path, it->second->isSmooth());
+        }
+        return it->second;
+    }
+    ++m_stats.misses;
+    auto pending = m_pendingImages.find(path);
+    if (pending != m_pendingImages.end()) {
+        DecodedImage decoded = pending->second.get();
+        m_pendingImages.erase(pending);
+        return uploadTexture(path, std::move(decoded), smooth);
+    }
+    return uploadTexture(path, decodeImage(path), smooth);
+}
+
+SoundBufferHandle AssetManager::getSoundBuffer(const std::string& path) {
+    auto it = m_sounds.find(path);
+    if (it != m_sounds.end()) {
+        ++m_stats.hits;
+        return it->second;
+    }
+    ++m_stats.misses;
+    auto pending = m_pendingSounds.find(path);
+    if (pending != m_pendingSounds.end()) {
+        DecodedSound decoded = pending->second.get();
+        m_pendingSounds.erase(pending);
+        return uploadSound(path, std::move(decoded));
+    }
+    return uploadSound(path, decodeSound(path));
+}
+
+FontHandle AssetManager::getFont(const std::string& path) {
+    auto it = m_fonts.find(path);
+    if (it != m_fonts.end()) {
+        ++m_stats.hits;
+        return it->second;
+    }
+    ++m_stats.misses;
+    // fonts only read their header here, glyphs are rasterized lazily, nothing worth a worker
+    auto font = std::make_shared<sf::Font>();
+    bool loaded = m_pack ? m_pack->load(*font, path) : font->loadFromFile(path);
+    if (!loaded) {
+        return nullptr;
+    }
+    m_fonts[path] = font;
+    return font;
+}
+
+std::size_t AssetManager::releaseUnused() {
+    std::size_t released = 0;
+    auto sweep = [&released](auto& cache) {
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (it->second.use_count() == 1) {
+                it = cache.erase(it);
+                ++released;
+            } else {
+                ++it;
+            }
+        }
+    };
+    sweep(m_textures);
+    sweep(m_sounds);
+    sweep(m_fonts);
+    return released;
+}
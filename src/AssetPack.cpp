@@ -0,0 +1,207 @@
+#include "AssetPack.hpp"
+#include "Log.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef T3_HAVE_LZ4
+#include "lz4.h"
+#endif
+
+namespace {
+    std::uint32_t readU32(const unsigned char* p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    std::uint64_t readU64(const unsigned char* p) {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& packPath) {
+    close();
+    m_path = packPath;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(pak::HEADER_SIZE)) {
+        CloseHandle(file);
+        T3_LOG_ERROR("AssetPack Error: {} is too small to be a pack", packPath);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        T3_LOG_ERROR("AssetPack Error: Could not map {}", packPath);
+        return false;
+    }
+    m_base = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_base) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        T3_LOG_ERROR("AssetPack Error: Could not map {}", packPath);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(packPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(pak::HEADER_SIZE)) {
+        ::close(fd);
+        T3_LOG_ERROR("AssetPack Error: {} is too small to be a pack", packPath);
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive, no descriptor stays open
+    if (mapped == MAP_FAILED) {
+        T3_LOG_ERROR("AssetPack Error: Could not map {}", packPath);
+        return false;
+    }
+    m_base = static_cast<const unsigned char*>(mapped);
+    m_mappedSize = static_cast<std::size_t>(st.st_size);
+#endif
+
+    if (!readIndex()) {
+        close();
+        return false;
+    }
+    T3_LOG_INFO("AssetPack: Mapped {} ({} entries, {} KiB)", packPath, m_entries.size(), m_mappedSize / 1024);
+    return true;
+}
+
+void AssetPack::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_decompressedMutex);
+        m_decompressed.clear();
+    }
+    m_entries.clear();
+    if (!m_base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_base);
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(m_base), m_mappedSize);
+#endif
+    m_base = nullptr;
+    m_mappedSize = 0;
+}
+
+bool AssetPack::readIndex() {
+    if (std::memcmp(m_base, pak::MAGIC, sizeof(pak::MAGIC)) != 0) {
+        T3_LOG_ERROR("AssetPack Error: {} is not an asset pack", m_path);
+        return false;
+    }
+    const std::uint32_t version = readU32(m_base + 4);
+    if (version != pak::VERSION) {
+        T3_LOG_ERROR("AssetPack Error: {} has version {}, expected {}", m_path, version, pak::VERSION);
+        return false;
+    }
+    const std::uint32_t entryCount = readU32(m_base + 8);
+    const std::uint64_t indexOffset = readU64(m_base + 16);
+    const std::uint64_t indexSize = readU64(m_base + 24);
+    if (indexOffset > m_mappedSize || indexSize > m_mappedSize - indexOffset) {
+        T3_LOG_ERROR("AssetPack Error: {} has a truncated index", m_path);
+        return false;
+    }
+
+    const unsigned char* p = m_base + indexOffset;
+    const unsigned char* end = p + indexSize;
+    m_entries.reserve(entryCount);
+    for (std::uint32_t i = 0; i < entryCount; ++i) {
+        if (end - p < 32) {
+            T3_LOG_ERROR("AssetPack Error: {} index ends early", m_path);
+            return false;
+        }
+        Entry entry;
+        entry.offset = readU64(p);
+        entry.storedSize = readU64(p + 8);
+        entry.size = readU64(p + 16);
+        entry.flags = readU32(p + 24);
+        const std::uint32_t pathLength = readU32(p + 28);
+        p += 32;
+        if (static_cast<std::uint64_t>(end - p) < pathLength ||
+            entry.offset > m_mappedSize || entry.storedSize > m_mappedSize - entry.offset ||
+            (!(entry.flags & pak::ENTRY_LZ4) && entry.size != entry.storedSize)) { // find() hands out size bytes as they are
+            T3_LOG_ERROR("AssetPack Error: {} has a bad entry at index {}", m_path, i);
+            return false;
+        }
+        m_entries.emplace(std::string(reinterpret_cast<const char*>(p), pathLength), entry);
+        p += pathLength;
+    }
+    return true;
+}
+
+AssetPack::View AssetPack::find(const std::string& key) const {
+    if (!m_base) return {};
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return {};
+    const Entry& entry = it->second;
+
+    if (!(entry.flags & pak::ENTRY_LZ4)) {
+        return {m_base + entry.offset, static_cast<std::size_t>(entry.size)};
+    }
+
+    std::lock_guard<std::mutex> lock(m_decompressedMutex);
+    auto cached = m_decompressed.find(key);
+    if (cached != m_decompressed.end()) {
+        return {cached->second->data(), cached->second->size()};
+    }
+#ifdef T3_HAVE_LZ4
+    auto buffer = std::make_unique<std::vector<unsigned char>>(static_cast<std::size_t>(entry.size));
+    int written = LZ4_decompress_safe(reinterpret_cast<const char*>(m_base + entry.offset),
+                                      reinterpret_cast<char*>(buffer->data()),
+                                      static_cast<int>(entry.storedSize), static_cast<int>(entry.size));
+    if (written < 0 || static_cast<std::uint64_t>(written) != entry.size) {
+        T3_LOG_ERROR("AssetPack Error: {} failed to decompress", key);
+        return {};
+    }
+    View view{buffer->data(), buffer->size()};
+    m_decompressed.emplace(key, std::move(buffer));
+    return view;
+#else
+    T3_LOG_WARNING("AssetPack Warning: {} is LZ4 compressed but this build has no LZ4, using the loose file", key);
+    return {};
+#endif
+}
+
+std::string AssetPack::keyFor(const std::string& path) {
+    std::string key = path;
+    for (char& c : key) {
+        if (c == '\\') c = '/';
+    }
+    const std::string marker = "assets/";
+    std::size_t pos = key.rfind(marker);
+    if (pos != std::string::npos && (pos == 0 || key[pos - 1] == '/')) {
+        return key.substr(pos + marker.size());
+    }
+    return key;
+}
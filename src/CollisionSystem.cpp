@@ -19,7 +19,7 @@ namespace phys {
 
 CollisionResolutionInfo CollisionSystem::resolveCollisions(
     DynamicBody& dynamicBody,
-    const std::vector<PlatformBody>& platformBodies,
+    const BodyList& platformBodies,
     float deltaTime)
 {
     CollisionResolutionInfo resolutionInfo;
@@ -60,6 +60,7 @@ CollisionResolutionInfo CollisionSystem::resolveCollisions(
             if (&platform == dynamicBody.getGroundPlatformTemporarilyIgnored()) {
                 continue;
             }
+            ++resolutionInfo.platformsChecked;
 
             // Optional: AABB check for the sweep before detailed sweptAABB
             sf::FloatRect dynamicBroadAABB = dynamicBody.getAABB();
@@ -71,6 +72,7 @@ CollisionResolutionInfo CollisionSystem::resolveCollisions(
             if (!dynamicBroadAABB.intersects(platform.getAABB())) {
                 continue;
             }
+            ++resolutionInfo.sweepCandidates;
 
 
             CollisionEvent currentEventDetails;
@@ -0,0 +1,107 @@
+#include "EmbeddedLevel.hpp"
+#include "EmbeddedLevels.generated.hpp" // written by levelembed into the build tree
+#include <cstring>
+
+namespace embedded {
+
+const Level* findLevel(int levelNumber) {
+    for (const Level& level : generated::levels) {
+        if (level.levelNumber != 0 && level.levelNumber == levelNumber) return &level;
+    }
+    return nullptr;
+}
+
+const Level* findFile(const char* relativePath) {
+    for (const Level& level : generated::levels) {
+        if (std::strcmp(level.file, relativePath) == 0) return &level;
+    }
+    return nullptr;
+}
+
+std::size_t getLevelCount() {
+    return sizeof(generated::levels) / sizeof(generated::levels[0]);
+}
+
+LevelData toLevelData(const Level& level) {
+    LevelData data;
+    data.levelName = level.levelName;
+    data.levelNumber = level.levelNumber;
+    data.playerStartPosition = {level.playerStartX, level.playerStartY};
+    data.backgroundColor = sf::Color(level.backgroundR, level.backgroundG, level.backgroundB, level.backgroundA);
+
+    data.platforms.reserve(level.platformCount);
+    for (std::size_t i = 0; i < level.platformCount; ++i) {
+        const Platform& p = level.platforms[i];
+        phys::PlatformShape shape;
+        shape.id = p.id;
+        shape.position = {p.x, p.y};
+        shape.width = p.width;
+        shape.height = p.height;
+        shape.type = p.type;
+        shape.initiallyFalling = p.initiallyFalling;
+        shape.surfaceVelocity = {p.surfaceVelocityX, p.surfaceVelocityY};
+        shape.portalID = p.portalID;
+        shape.teleportOffset = {p.teleportOffsetX, p.teleportOffsetY};
+        data.platforms.push_back(shape);
+    }
+
+    data.movingPlatformDetails.reserve(level.movingCount);
+    for (std::size_t i = 0; i < level.movingCount; ++i) {
+        const MovingPlatform& m = level.moving[i];
+        LevelData::MovingPlatformInfo mpi;
+        mpi.id = m.id;
+        mpi.startPosition = {m.startX, m.startY};
+        mpi.axis = m.axis;
+        mpi.distance = m.distance;
+        mpi.cycleDuration = m.cycleDuration;
+        mpi.initialDirection = m.initialDirection;
+        data.movingPlatformDetails.push_back(mpi);
+    }
+
+    data.interactiblePlatformDetails.reserve(level.interactibleCount);
+    for (std::size_t i = 0; i < level.interactibleCount; ++i) {
+        const InteractiblePlatform& ip = level.interactibles[i];
+        LevelData::InteractiblePlatformInfo ipi;
+        ipi.id = ip.id;
+        ipi.interactionType = ip.interactionType;
+        ipi.interaction = LevelData::InteractiblePlatformInfo::toInteraction(ipi.interactionType);
+        ipi.targetBodyTypeStr = ip.targetBodyTypeStr;
+        ipi.targetBodyType = ip.targetBodyType;
+        ipi.targetTileColor = sf::Color(ip.tileR, ip.tileG, ip.tileB, ip.tileA);
+        ipi.hasTargetTileColor = ip.hasTargetTileColor;
+        ipi.oneTime = ip.oneTime;
+        ipi.cooldown = ip.cooldown;
+        ipi.linkedID = ip.linkedID;
+        data.interactiblePlatformDetails.push_back(ipi);
+    }
+
+    data.portalPlatformDetails.reserve(level.portalCount);
+    for (std::size_t i = 0; i < level.portalCount; ++i) {
+        const PortalPlatform& pp = level.portals[i];
+        LevelData::PortalPlatformInfo ppi;
+        ppi.id = pp.id;
+        ppi.portalID = pp.portalID;
+        ppi.offset = {pp.offsetX, pp.offsetY};
+        data.portalPlatformDetails.push_back(ppi);
+    }
+
+    const Streaming& s = level.streaming;
+    if (s.enabled) {
+        data.streaming.enabled = true;
+        data.streaming.chunkSize = s.chunkSize;
+        data.streaming.loadRadius = s.loadRadius;
+        data.streaming.unloadRadius = s.unloadRadius;
+        data.streaming.maxPendingLoads = s.maxPendingLoads;
+        data.streaming.startChunk = {s.startChunkX, s.startChunkY};
+        data.streaming.hasDeathChunkRow = s.hasDeathChunkRow;
+        data.streaming.deathChunkRow = s.deathChunkRow;
+        data.streaming.fallDistance = s.fallDistance;
+        data.streaming.chunks.reserve(s.chunkCount);
+        for (std::size_t i = 0; i < s.chunkCount; ++i) {
+            data.streaming.chunks.push_back({s.chunks[i].x, s.chunks[i].y, s.chunks[i].file});
+        }
+    }
+    return data;
+}
+
+} // namespace embedded
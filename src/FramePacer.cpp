@@ -0,0 +1,62 @@
+#include "FramePacer.hpp"
+
+#include "SFML/System/Sleep.hpp"
+#include "SFML/System/Time.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+void FramePacer::setTargetFps(int fps) {
+    m_targetFps = std::max(1, fps);
+    m_periodUs = 1000000 / m_targetFps;
+    m_deadlineUs = 0;
+}
+
+void FramePacer::apply(sf::Window& window) const {
+    window.setFramerateLimit(0);
+    window.setVerticalSyncEnabled(m_mode == Mode::VSync);
+}
+
+void FramePacer::waitForFrameStart() {
+    if (m_mode == Mode::Limited) {
+        const std::int64_t now = LatencyStats::nowMicros();
+        // next present deadline, restarting the schedule if we fell behind instead of rushing to catch up
+        m_deadlineUs = m_deadlineUs == 0 ? now + m_periodUs : m_deadlineUs + m_periodUs;
+        const std::int64_t renderUs = static_cast<std::int64_t>(m_renderEstimateUs);
+        if (m_deadlineUs - renderUs < now) m_deadlineUs = now + renderUs;
+
+        const std::int64_t startAt = m_deadlineUs - renderUs;
+        const std::int64_t sleepFor = startAt - now - SPIN_US;
+        if (sleepFor > 0) sf::sleep(sf::microseconds(sleepFor));
+        while (LatencyStats::nowMicros() < startAt) std::this_thread::yield();
+    }
+    m_frameStartUs = LatencyStats::nowMicros();
+}
+
+void FramePacer::endFrame() {
+    const std::int64_t now = LatencyStats::nowMicros();
+
+    // mean + 2 deviations, so a frame only runs past its deadline when it's unusually slow
+    const double renderUs = static_cast<double>(now - m_frameStartUs);
+    if (m_renderMeanUs == 0.0) m_renderMeanUs = renderUs;
+    m_renderMeanUs += (renderUs - m_renderMeanUs) * 0.1;
+    m_renderDeviationUs += (std::abs(renderUs - m_renderMeanUs) - m_renderDeviationUs) * 0.1;
+    m_renderEstimateUs = std::min(m_renderMeanUs + 2.0 * m_renderDeviationUs, static_cast<double>(m_periodUs));
+
+    if (m_lastDisplayUs != 0) m_frameTimes.add(static_cast<double>(now - m_lastDisplayUs) / 1000.0);
+    m_lastDisplayUs = now;
+    if (now - m_lastSummaryUs >= 500000) {
+        m_frameSummary = m_frameTimes.summarize();
+        m_lastSummaryUs = now;
+    }
+}
+
+const char* FramePacer::modeName(Mode mode) {
+    switch (mode) {
+        case Mode::VSync:    return "VSync";
+        case Mode::Uncapped: return "Uncapped";
+        case Mode::Limited:  return "Limited";
+    }
+    return "?";
+}
@@ -0,0 +1,90 @@
+#include "GoldenTrace.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+    // %.9g reads back as the same float
+    std::string describe(const char* field, float expected, float actual, float tolerance) {
+        char text[160];
+        std::snprintf(text, sizeof(text), "%s %.9g, golden %.9g (off by %g, tolerance %g)", field, actual, expected,
+                      std::fabs(actual - expected), tolerance);
+        return text;
+    }
+
+    bool near(float expected, float actual, float tolerance) {
+        return std::fabs(actual - expected) <= tolerance;
+    }
+}
+
+void GoldenTrace::clear() {
+    m_samples.clear();
+}
+
+bool GoldenTrace::save(const std::string& path) const {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        T3_LOG_ERROR("GoldenTrace Error: Could not write {}", path);
+        return false;
+    }
+    std::fprintf(out, "t3trace 1 %d %d\n", m_tickRate, m_level);
+    for (const Sample& sample : m_samples) {
+        std::fprintf(out, "%llu %.9g %.9g %.9g %.9g %u %u\n", static_cast<unsigned long long>(sample.tick),
+                     sample.position.x, sample.position.y, sample.velocity.x, sample.velocity.y, sample.groundID,
+                     static_cast<unsigned int>(sample.flags));
+    }
+    const bool ok = !std::ferror(out);
+    return std::fclose(out) == 0 && ok;
+}
+
+bool GoldenTrace::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        T3_LOG_ERROR("GoldenTrace Error: Could not open {}", path);
+        return false;
+    }
+    std::string magic;
+    int version = 0;
+    if (!(in >> magic >> version >> m_tickRate >> m_level) || magic != "t3trace" || version != 1) {
+        T3_LOG_ERROR("GoldenTrace Error: {} is not a golden trace", path);
+        return false;
+    }
+    m_samples.clear();
+    Sample sample{};
+    unsigned int flags = 0;
+    while (in >> sample.tick >> sample.position.x >> sample.position.y >> sample.velocity.x >> sample.velocity.y >>
+           sample.groundID >> flags) {
+        sample.flags = static_cast<std::uint8_t>(flags);
+        m_samples.push_back(sample);
+    }
+    if (!in.eof()) {
+        T3_LOG_ERROR("GoldenTrace Error: {} has a bad line after {} ticks", path, m_samples.size());
+        m_samples.clear();
+        return false;
+    }
+    return true;
+}
+
+std::size_t GoldenTrace::findDivergence(const GoldenTrace& actual, const Tolerance& tolerance, std::string& outWhat) const {
+    const std::vector<Sample>& run = actual.getSamples();
+    const std::size_t common = std::min(m_samples.size(), run.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        const Sample& expected = m_samples[i];
+        const Sample& got = run[i];
+        if (!near(expected.position.x, got.position.x, tolerance.position)) outWhat = describe("x", expected.position.x, got.position.x, tolerance.position);
+        else if (!near(expected.position.y, got.position.y, tolerance.position)) outWhat = describe("y", expected.position.y, got.position.y, tolerance.position);
+        else if (!near(expected.velocity.x, got.velocity.x, tolerance.velocity)) outWhat = describe("vx", expected.velocity.x, got.velocity.x, tolerance.velocity);
+        else if (!near(expected.velocity.y, got.velocity.y, tolerance.velocity)) outWhat = describe("vy", expected.velocity.y, got.velocity.y, tolerance.velocity);
+        else if (expected.groundID != got.groundID) outWhat = "ground platform " + std::to_string(got.groundID) + ", golden " + std::to_string(expected.groundID);
+        else if (expected.flags != got.flags) outWhat = "resolution flags " + std::to_string(got.flags) + ", golden " + std::to_string(expected.flags);
+        else continue;
+        return i;
+    }
+    if (m_samples.size() == run.size()) return npos;
+    outWhat = run.size() < m_samples.size() ? "run ended, golden goes on for " + std::to_string(m_samples.size() - run.size()) + " more ticks"
+                                            : "golden ended, run goes on for " + std::to_string(run.size() - m_samples.size()) + " more ticks";
+    return common;
+}
@@ -0,0 +1,53 @@
+#include "InputLog.hpp"
+#include "Log.hpp"
+
+#include <fstream>
+
+void InputLog::clear() {
+    m_entries.clear();
+}
+
+bool InputLog::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        T3_LOG_ERROR("InputLog Error: Could not write {}", path);
+        return false;
+    }
+    out << "t3input 1 " << m_tickRate << " " << m_level << "\n";
+    for (const Entry& entry : m_entries) {
+        out << entry.tick << " " << entry.key << " " << (entry.pressed ? 1 : 0) << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool InputLog::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        T3_LOG_ERROR("InputLog Error: Could not open {}", path);
+        return false;
+    }
+    std::string magic;
+    int version = 0;
+    if (!(in >> magic >> version >> m_tickRate >> m_level) || magic != "t3input" || version != 1) {
+        T3_LOG_ERROR("InputLog Error: {} is not an input log", path);
+        return false;
+    }
+    m_entries.clear();
+    Entry entry{};
+    int pressed = 0;
+    while (in >> entry.tick >> entry.key >> pressed) {
+        entry.pressed = pressed != 0;
+        if (!m_entries.empty() && entry.tick < m_entries.back().tick) {
+            T3_LOG_ERROR("InputLog Error: {} goes back in time at tick {}", path, entry.tick);
+            m_entries.clear();
+            return false;
+        }
+        m_entries.push_back(entry);
+    }
+    if (!in.eof()) {
+        T3_LOG_ERROR("InputLog Error: {} has a bad line after {} events", path, m_entries.size());
+        m_entries.clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+#include "LatencyStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+LatencyStats::LatencyStats(std::size_t capacity) : m_samples(std::max<std::size_t>(1, capacity), 0.0) {
+    m_sorted.reserve(m_samples.size());
+}
+
+void LatencyStats::add(double milliseconds) {
+    m_samples[m_next] = milliseconds;
+    m_next = (m_next + 1) % m_samples.size();
+    m_count = std::min(m_count + 1, m_samples.size());
+}
+
+void LatencyStats::reset() {
+    m_next = 0;
+    m_count = 0;
+}
+
+LatencyStats::Summary LatencyStats::summarize() const {
+    Summary summary;
+    if (m_count == 0) return summary;
+    // the valid samples are the first m_count slots until the ring wraps, then all of them
+    std::vector<double>& sorted = m_sorted;
+    sorted.assign(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(m_count));
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        const std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    };
+    summary.count = sorted.size();
+    summary.min = sorted.front();
+    summary.max = sorted.back();
+    summary.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    double squares = 0.0;
+    for (double sample : sorted) squares += (sample - summary.mean) * (sample - summary.mean);
+    summary.stdDev = std::sqrt(squares / static_cast<double>(sorted.size()));
+    summary.p50 = percentile(0.50);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+std::string LatencyStats::format(const Summary& summary) {
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "n=%zu min %.2f mean %.2f sd %.2f p50 %.2f p99 %.2f max %.2f ms",
+                  summary.count, summary.min, summary.mean, summary.stdDev, summary.p50, summary.p99, summary.max);
+    return buffer;
+}
+
+std::int64_t LatencyStats::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
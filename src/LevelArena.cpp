@@ -0,0 +1,84 @@
+#include "LevelArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+}
+
+LevelArena::LevelArena(std::size_t blockSize, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream ? upstream : std::pmr::new_delete_resource()),
+      m_blockSize(std::max<std::size_t>(blockSize, 256)) {
+}
+
+LevelArena::~LevelArena() {
+    freeBlocks();
+}
+
+void LevelArena::reset() {
+    if (m_blocks.size() > 1) {
+        // one block that fits the whole last run, the next run of the same level bumps through it without growing
+        const std::size_t total = m_capacity;
+        freeBlocks();
+        addBlock(total);
+    }
+    m_current = 0;
+    m_offset = 0;
+    m_used = 0;
+}
+
+void LevelArena::release() {
+    freeBlocks();
+    m_current = 0;
+    m_offset = 0;
+    m_used = 0;
+}
+
+void* LevelArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes == 0) bytes = 1;
+    for (;;) {
+        if (m_current < m_blocks.size()) {
+            const Block& block = m_blocks[m_current];
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data);
+            const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            const std::size_t start = static_cast<std::size_t>(aligned - base);
+            if (start + bytes <= block.size) {
+                m_used += start + bytes - m_offset;
+                m_offset = start + bytes;
+                return block.data + start;
+            }
+            // the rest of this block is lost until the next reset, kept small by the blocks doubling
+            if (m_current + 1 < m_blocks.size()) {
+                ++m_current;
+                m_offset = 0;
+                continue;
+            }
+        }
+        const std::size_t last = m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2;
+        addBlock(std::max(last, bytes + alignment)); // upstream throws if it can't
+        m_current = m_blocks.size() - 1;
+        m_offset = 0;
+    }
+}
+
+void LevelArena::do_deallocate(void*, std::size_t, std::size_t) {
+    // nothing, everything goes back at reset()
+}
+
+bool LevelArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void LevelArena::addBlock(std::size_t minSize) {
+    const std::size_t size = std::max(minSize, m_blockSize);
+    std::byte* data = static_cast<std::byte*>(m_upstream->allocate(size, BLOCK_ALIGNMENT));
+    m_blocks.push_back({data, size});
+    m_capacity += size;
+}
+
+void LevelArena::freeBlocks() {
+    for (const Block& block : m_blocks) m_upstream->deallocate(block.data, block.size, BLOCK_ALIGNMENT);
+    m_blocks.clear();
+    m_capacity = 0;
+}
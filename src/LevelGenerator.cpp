@@ -0,0 +1,267 @@
+#include "LevelGenerator.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+namespace {
+    constexpr std::size_t FILE_BUFFER = 1 << 16;
+    constexpr long long MIN_WIDTH = 48;
+    constexpr long long GAP = 16;            // at least this much between neighbours in a row
+    constexpr long long PLAYER_HEIGHT = 32;
+
+    // splitmix64. Everything drawn from it is an integer or compared against exact float sums, so a seed gives the
+    // same level whatever the compiler does with floating point.
+    class Random {
+    public:
+        explicit Random(std::uint64_t seed) : m_state(seed) {}
+
+        std::uint64_t next() {
+            std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+        // [0, 1), 24 bits so it's exact as a float
+        float uniform() { return static_cast<float>(next() >> 40) / 16777216.f; }
+        // [0, n)
+        long long below(long long n) { return n > 0 ? static_cast<long long>(next() % static_cast<std::uint64_t>(n)) : 0; }
+
+    private:
+        std::uint64_t m_state;
+    };
+
+    class StringSink {
+    public:
+        explicit StringSink(std::string& out) : m_out(out) {}
+        void append(const char* text, std::size_t length) { m_out.append(text, length); }
+        bool finish() { return true; }
+
+    private:
+        std::string& m_out;
+    };
+
+    // buffered, one fwrite per FILE_BUFFER bytes
+    class FileSink {
+    public:
+        explicit FileSink(std::FILE* out) : m_out(out) { m_buffer.reserve(FILE_BUFFER); }
+        void append(const char* text, std::size_t length) {
+            if (m_buffer.size() + length > FILE_BUFFER) flush();
+            m_buffer.insert(m_buffer.end(), text, text + length);
+        }
+        bool finish() {
+            flush();
+            return m_ok && std::fflush(m_out) == 0;
+        }
+
+    private:
+        void flush() {
+            if (!m_buffer.empty() && std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_out) != m_buffer.size()) m_ok = false;
+            m_buffer.clear();
+        }
+
+        std::FILE* m_out;
+        std::vector<char> m_buffer;
+        bool m_ok = true;
+    };
+
+    template <typename Sink, typename... Args>
+    void appendf(Sink& sink, const char* format, Args... args) {
+        char buffer[512];
+        const int written = std::snprintf(buffer, sizeof(buffer), format, args...);
+        if (written > 0) sink.append(buffer, std::min(static_cast<std::size_t>(written), sizeof(buffer) - 1));
+    }
+
+    std::string jsonEscaped(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+        }
+        return escaped;
+    }
+}
+
+const char* LevelGenerator::typeName(phys::bodyType type) {
+    switch (type) {
+        case phys::bodyType::none:         return "none";
+        case phys::bodyType::platform:     return "platform";
+        case phys::bodyType::conveyorBelt: return "conveyorBelt";
+        case phys::bodyType::moving:       return "moving";
+        case phys::bodyType::interactible: return "interactible";
+        case phys::bodyType::falling:      return "falling";
+        case phys::bodyType::vanishing:    return "vanishing";
+        case phys::bodyType::spring:       return "spring";
+        case phys::bodyType::trap:         return "trap";
+        case phys::bodyType::solid:        return "solid";
+        case phys::bodyType::goal:         return "goal";
+        case phys::bodyType::portal:       return "portal";
+    }
+    return "solid";
+}
+
+bool LevelGenerator::typeFromName(const std::string& name, phys::bodyType& outType) {
+    for (std::size_t i = 0; i < TYPE_COUNT; ++i) {
+        const phys::bodyType type = static_cast<phys::bodyType>(i);
+        if (name == typeName(type)) {
+            outType = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LevelGenerator::write(std::FILE* out) const {
+    FileSink sink(out);
+    return generate(sink);
+}
+
+std::string LevelGenerator::toJson() const {
+    std::string json;
+    StringSink sink(json);
+    return generate(sink) ? json : std::string();
+}
+
+template <typename Sink>
+bool LevelGenerator::generate(Sink& sink) const {
+    const Options& o = m_options;
+    const std::size_t count = o.platformCount;
+    float totalWeight = 0.f;
+    for (std::size_t i = 0; i < TYPE_COUNT; ++i) {
+        if (static_cast<phys::bodyType>(i) != phys::bodyType::goal) totalWeight += std::max(0.f, o.weights[i]);
+    }
+    if (count == 0 || !(totalWeight > 0.f)) return false;
+
+    const long long rows = static_cast<long long>(std::max<std::size_t>(1, std::min(o.rows, count)));
+    const long long columns = (static_cast<long long>(count) + rows - 1) / rows;
+    const long long cellWidth = std::max(MIN_WIDTH + 2 * GAP, static_cast<long long>(o.cellWidth));
+    const long long cellHeight = std::max(PLAYER_HEIGHT * 2, static_cast<long long>(o.cellHeight));
+    const long long top = static_cast<long long>(o.top);
+    Random random(o.seed);
+
+    // types first, portals and fields need to see all of them before anything is written
+    std::vector<phys::bodyType> types(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float pick = random.uniform() * totalWeight;
+        float sum = 0.f;
+        phys::bodyType type = phys::bodyType::solid;
+        for (std::size_t t = 0; t < TYPE_COUNT; ++t) {
+            if (static_cast<phys::bodyType>(t) == phys::bodyType::goal || !(o.weights[t] > 0.f)) continue;
+            sum += o.weights[t];
+            type = static_cast<phys::bodyType>(t);
+            if (pick < sum) break;
+        }
+        types[i] = type;
+    }
+    for (std::size_t field = 0; field < o.vanishingFields; ++field) {
+        const long long row0 = random.below(rows);
+        const long long column0 = random.below(columns);
+        const long long size = static_cast<long long>(o.vanishingFieldSize);
+        for (long long row = row0; row < std::min(rows, row0 + size); ++row) {
+            for (long long column = column0; column < std::min(columns, column0 + size); ++column) {
+                const std::size_t i = static_cast<std::size_t>(row * columns + column);
+                if (i < count) types[i] = phys::bodyType::vanishing;
+            }
+        }
+    }
+    // the player starts on the first one, the last one is the way out
+    types[0] = phys::bodyType::solid;
+    if (count > 1) types[count - 1] = phys::bodyType::goal;
+    std::size_t portalCount = 0;
+    std::size_t lastPortal = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (types[i] != phys::bodyType::portal) continue;
+        ++portalCount;
+        lastPortal = i;
+    }
+    if (portalCount % 2 == 1) types[lastPortal] = phys::bodyType::solid; // no partner
+
+    const std::string name = o.levelName.empty() ? "generated " + std::to_string(count) : o.levelName;
+    appendf(sink, R"({"levelName":"%s","levelNumber":%d,"playerStart":{"x":%lld,"y":%lld},)",
+            jsonEscaped(name).c_str(), o.levelNumber, GAP, top - 2 * PLAYER_HEIGHT);
+    appendf(sink, R"("backgroundColor":{"r":20,"g":20,"b":40},"platforms":[)");
+
+    std::size_t portalsWritten = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const phys::bodyType type = types[i];
+        const long long row = static_cast<long long>(i) / columns;
+        const long long column = static_cast<long long>(i) % columns;
+        const long long cellX = column * cellWidth;
+        const long long cellY = top + row * cellHeight;
+
+        long long width = MIN_WIDTH + random.below(cellWidth - 2 * GAP - MIN_WIDTH + 1);
+        long long height = random.below(2) ? 32 : 16;
+        if (type == phys::bodyType::portal || type == phys::bodyType::goal) {
+            width = 32;
+            height = 48;
+        } else if (type == phys::bodyType::interactible) {
+            width = 32;
+            height = 32;
+        }
+        long long x = cellX + random.below(cellWidth - GAP - width + 1);
+        long long y = cellY + random.below(cellHeight / 4);
+        if (i == 0) {
+            // something wide and level under the spawn point
+            x = cellX;
+            y = top;
+            width = cellWidth - GAP;
+            height = 32;
+        }
+
+        // moving ones go back and forth inside their own cell, starting from the end they move away from
+        bool alongX = false;
+        int direction = 1;
+        long long distance = 0;
+        if (type == phys::bodyType::moving) {
+            alongX = random.below(2) == 0;
+            direction = random.below(2) ? 1 : -1;
+            distance = alongX ? cellWidth - GAP - width : cellHeight / 2;
+            if (alongX) x = direction > 0 ? cellX : cellX + distance;
+            else if (direction < 0) y += distance;
+        }
+
+        const unsigned int id = static_cast<unsigned int>(i + 1);
+        appendf(sink, R"(%s{"id":%u,"type":"%s","position":{"x":%lld,"y":%lld},"size":{"width":%lld,"height":%lld})",
+                i ? "," : "", id, typeName(type), x, y, width, height);
+
+        switch (type) {
+            case phys::bodyType::moving: {
+                const long long cycle = 2 + random.below(4);
+                appendf(sink, R"(,"movement":{"startPosition":{"x":%lld,"y":%lld},"axis":"%c","distance":%lld,"cycleDuration":%lld,"initialDirection":%d})",
+                        x, y, alongX ? 'x' : 'y', distance, cycle, direction);
+                break;
+            }
+            case phys::bodyType::conveyorBelt: {
+                const long long speed = 40 + 10 * random.below(9);
+                appendf(sink, R"(,"surfaceVelocity":{"x":%lld,"y":0})", random.below(2) ? speed : -speed);
+                break;
+            }
+            case phys::bodyType::interactible: {
+                static const char* const TARGETS[] = {"none", "solid", "platform"};
+                const long long range = static_cast<long long>(std::max<std::size_t>(1, o.linkRange));
+                const long long step = 1 + random.below(range);
+                long long linked = random.below(2) ? static_cast<long long>(i) + step : static_cast<long long>(i) - step;
+                if (linked < 0 || linked >= static_cast<long long>(count)) linked = static_cast<long long>(i) - (linked < 0 ? -step : step);
+                linked = std::clamp(linked, 0ll, static_cast<long long>(count) - 1);
+                const char* target = TARGETS[random.below(3)];
+                const bool oneTime = random.below(4) == 0;
+                const long long cooldown = 1 + random.below(3);
+                appendf(sink, R"(,"interaction":{"type":"changeSelf","targetBodyType":"%s","oneTime":%s,"cooldown":%lld)",
+                        target, oneTime ? "true" : "false", cooldown);
+                if (linked != static_cast<long long>(i)) appendf(sink, R"(,"linkedID":%lld)", linked + 1);
+                sink.append("}", 1);
+                break;
+            }
+            case phys::bodyType::portal:
+                // in pairs by order: the 1st and 2nd share an id, then the 3rd and 4th, ...
+                appendf(sink, R"(,"portalID":%zu,"teleportOffset":{"x":0,"y":-10})", portalsWritten / 2 + 1);
+                ++portalsWritten;
+                break;
+            default:
+                break;
+        }
+        sink.append("}", 1);
+    }
+    sink.append("]}\n", 3);
+    return sink.finish();
+}
@@ -1,15 +1,29 @@
 #include "LevelManager.hpp"
+#include "AssetPack.hpp"
+#include "Easing.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
 #include "rapidjson/filereadstream.h"
 #include "rapidjson/error/en.h"
 #include <cstdio>
-#include <iostream>
 #include <algorithm>
+#include <utility>
+#ifdef T3_EMBEDDED_LEVELS
+#include "EmbeddedLevel.hpp"
+#endif
+
+namespace {
+    // the screen fade between levels, any math::easing::Curve works here
+    constexpr math::easing::Curve FADE_CURVE = math::easing::Curve::Linear;
+}
 
 // Constructor
 LevelManager::LevelManager()
     : m_currentLevelNumber(0),
       m_targetLevelNumber(0),
-      m_levelDataToFill(nullptr),
+      m_levelToFill(nullptr),
+      m_assetPack(nullptr),
+      m_assetManager(nullptr),
       m_maxLevels(0),
       m_levelBasePath("../assets/levels/"),
       m_transitionState(TransitionState::NONE),
@@ -51,46 +65,47 @@ void LevelManager::setTransitionProperties(float fadeDuration) {
     m_fadeDuration = std::max(0.1f, fadeDuration);
 }
 
-bool LevelManager::requestLoadLevel(int levelNumber, LevelData& outLevelData, LoadRequestType type) {
+bool LevelManager::requestLoadLevel(int levelNumber, LevelTemplatePtr& outLevel, LoadRequestType type) {
     if (m_transitionState != TransitionState::NONE) {
-        std::cerr << "LevelManager Warning: Cannot request load, transition in progress." << std::endl;
+        T3_LOG_WARNING("LevelManager Warning: Cannot request load, transition in progress.");
         return false;
     }
     if (levelNumber <= 0 || (m_maxLevels > 0 && levelNumber > m_maxLevels && type != LoadRequestType::RESPAWN)) {
         if (!(type == LoadRequestType::RESPAWN && levelNumber == m_currentLevelNumber && m_currentLevelNumber > 0)){
-             std::cerr << "LevelManager Error: Requested level " << levelNumber << " invalid." << std::endl;
+             T3_LOG_ERROR("LevelManager Error: Requested level {} invalid.", levelNumber);
              return false;
         }
     }
     m_targetLevelNumber = levelNumber;
-    m_levelDataToFill = &outLevelData;
+    m_levelToFill = &outLevel;
     m_currentLoadType = type;
     m_transitionState = TransitionState::FADING_OUT;
     m_transitionClock.restart();
     m_loadingScreenReady = false;
-    std::cout << "LevelManager: FADE_OUT for level " << m_targetLevelNumber << " (Type: " << static_cast<int>(type) << ")" << std::endl;
+    T3_LOG_INFO("LevelManager: FADE_OUT for level {} (Type: {})", m_targetLevelNumber, type);
     return true;
 }
-bool LevelManager::requestLoadSpecificLevel(int levelNumber, LevelData& outLevelData) {
-    return requestLoadLevel(levelNumber, outLevelData, LoadRequestType::GENERAL);
+bool LevelManager::requestLoadSpecificLevel(int levelNumber, LevelTemplatePtr& outLevel) {
+    return requestLoadLevel(levelNumber, outLevel, LoadRequestType::GENERAL);
 }
-bool LevelManager::requestLoadNextLevel(LevelData& outLevelData) {
+bool LevelManager::requestLoadNextLevel(LevelTemplatePtr& outLevel) {
     if (!hasNextLevel() && m_currentLevelNumber != 0) {
-        std::cout << "LevelManager: No next level." << std::endl;
+        T3_LOG_INFO("LevelManager: No next level.");
         return false;
     }
     int target = (m_currentLevelNumber == 0) ? 1 : m_currentLevelNumber + 1;
-    return requestLoadLevel(target, outLevelData, LoadRequestType::NEXT_LEVEL);
+    return requestLoadLevel(target, outLevel, LoadRequestType::NEXT_LEVEL);
 }
-bool LevelManager::requestRespawnCurrentLevel(LevelData& outLevelData) {
+bool LevelManager::requestRespawnCurrentLevel(LevelTemplatePtr& outLevel) {
     if (m_currentLevelNumber <= 0) {
-        std::cerr << "LevelManager Error: Cannot respawn, no current level loaded." << std::endl;
+        T3_LOG_ERROR("LevelManager Error: Cannot respawn, no current level loaded.");
         return false;
     }
-    return requestLoadLevel(m_currentLevelNumber, outLevelData, LoadRequestType::RESPAWN);
+    return requestLoadLevel(m_currentLevelNumber, outLevel, LoadRequestType::RESPAWN);
 }
 
 void LevelManager::update(float dt, sf::RenderWindow& window) {
+    T3_PROFILE_SCOPE("LevelManager::update");
     if (m_transitionState == TransitionState::NONE) {
         return;
     }
@@ -98,7 +113,7 @@ void LevelManager::update(float dt, sf::RenderWindow& window) {
     sf::Color color = m_fadeOverlay.getFillColor();
     switch (m_transitionState) {
         case TransitionState::FADING_OUT: {
-            float alpha = std::min(255.f, (elapsedTime / m_fadeDuration) * 255.f);
+            float alpha = 255.f * math::easing::ease<FADE_CURVE>(elapsedTime / m_fadeDuration);
             color.a = static_cast<sf::Uint8>(alpha);
             m_fadeOverlay.setFillColor(color);
             if (elapsedTime >= m_fadeDuration) {
@@ -114,35 +129,48 @@ void LevelManager::update(float dt, sf::RenderWindow& window) {
                     default:                          imageToLoadPath = m_generalLoadingScreenPath; break;
                 }
                 if (!imageToLoadPath.empty()) {
-                    if (m_loadingTexture.loadFromFile(imageToLoadPath)) {
-                        m_loadingTexture.setSmooth(true);
-                        m_loadingSprite.setTexture(m_loadingTexture, true);
+                    TextureHandle texture;
+                    if (m_assetManager) {
+                        texture = m_assetManager->getTexture(imageToLoadPath, true);
+                    } else {
+                        auto loose = std::make_shared<sf::Texture>();
+                        if (m_assetPack ? m_assetPack->load(*loose, imageToLoadPath) : loose->loadFromFile(imageToLoadPath)) {
+                            loose->setSmooth(true);
+                            texture = loose;
+                        }
+                    }
+                    if (texture) {
+                        m_loadingTexture = texture;
+                        m_loadingSprite.setTexture(*m_loadingTexture, true);
                         sf::FloatRect bounds = m_loadingSprite.getLocalBounds();
                         m_loadingSprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
                         m_loadingScreenReady = true;
-                        std::cout << "LevelManager: Loaded image " << imageToLoadPath << std::endl;
+                        T3_LOG_DEBUG("LevelManager: Loaded image {}", imageToLoadPath);
                     } else {
-                        std::cerr << "LevelManager Error: Failed to load loading image: " << imageToLoadPath << std::endl;
+                        T3_LOG_ERROR("LevelManager Error: Failed to load loading image: {}", imageToLoadPath);
                         m_loadingScreenReady = false;
                     }
                 } else {
-                    std::cout << "LevelManager: No specific loading image set for this load type." << std::endl;
+                    T3_LOG_DEBUG("LevelManager: No specific loading image set for this load type.");
                     m_loadingScreenReady = false;
                 }
-                if (m_levelDataToFill) {
-                    if (performActualLoad(m_targetLevelNumber, *m_levelDataToFill)) {
+                if (m_levelToFill) {
+                    sf::Clock loadClock;
+                    const bool loaded = performActualLoad(m_targetLevelNumber, *m_levelToFill);
+                    m_lastLoadMs = loadClock.getElapsedTime().asMicroseconds() / 1000.f;
+                    if (loaded) {
                         m_currentLevelNumber = m_targetLevelNumber;
-                         std::cout << "LevelManager: Level " << m_targetLevelNumber << " loaded successfully." << std::endl;
+                         T3_LOG_INFO("LevelManager: Level {} loaded successfully.", m_targetLevelNumber);
                         m_transitionState = TransitionState::FADING_IN;
                         m_transitionClock.restart();
-                        std::cout << "LevelManager: Transitioning to FADING_IN." << std::endl;
+                        T3_LOG_DEBUG("LevelManager: Transitioning to FADING_IN.");
                     } else {
-                        std::cerr << "LevelManager Error: Failed to load level " << m_targetLevelNumber << " data." << std::endl;
+                        T3_LOG_ERROR("LevelManager Error: Failed to load level {} data.", m_targetLevelNumber);
                         m_transitionState = TransitionState::NONE;
-                        m_levelDataToFill = nullptr;
+                        m_levelToFill = nullptr;
                     }
                 } else {
-                     std::cerr << "LevelManager Critical Error: m_levelDataToFill is null during LOADING." << std::endl;
+                     T3_LOG_ERROR("LevelManager Critical Error: m_levelToFill is null during LOADING.");
                      m_transitionState = TransitionState::NONE;
                 }
             }
@@ -151,16 +179,16 @@ void LevelManager::update(float dt, sf::RenderWindow& window) {
         case TransitionState::LOADING:
             break;
         case TransitionState::FADING_IN: {
-            float alpha = std::max(0.f, 255.f - (elapsedTime / m_fadeDuration) * 255.f);
+            float alpha = 255.f * (1.f - math::easing::ease<FADE_CURVE>(elapsedTime / m_fadeDuration));
             color.a = static_cast<sf::Uint8>(alpha);
             m_fadeOverlay.setFillColor(color);
             if (elapsedTime >= m_fadeDuration) {
                 color.a = 0;
                 m_fadeOverlay.setFillColor(color);
                 m_transitionState = TransitionState::NONE;
-                m_levelDataToFill = nullptr;
+                m_levelToFill = nullptr;
                 m_loadingScreenReady = false;
-                std::cout << "LevelManager: FADING_IN complete. Transition finished." << std::endl;
+                T3_LOG_DEBUG("LevelManager: FADING_IN complete. Transition finished.");
             }
             break;
         }
@@ -194,44 +222,103 @@ bool LevelManager::hasNextLevel() const {
     return true;
 }
 
-bool LevelManager::performActualLoad(int levelNumber, LevelData& outLevelData) {
+bool LevelManager::performActualLoad(int levelNumber, LevelTemplatePtr& outLevel) {
+    LevelTemplatePtr levelTemplate = getLevelTemplate(levelNumber);
+    if (!levelTemplate) {
+        return false;
+    }
+    outLevel = std::move(levelTemplate);
+    return true;
+}
+
+LevelTemplatePtr LevelManager::getLevelTemplate(int levelNumber) {
+    auto cached = m_templateCache.find(levelNumber);
+    if (cached != m_templateCache.end()) {
+        T3_LOG_DEBUG("LevelManager: Using cached template for level {}", levelNumber);
+        return cached->second;
+    }
+
+#ifdef T3_EMBEDDED_LEVELS
+    // compiled-in copy first, no file I/O or parsing
+    if (const embedded::Level* embeddedLevel = embedded::findLevel(levelNumber)) {
+        T3_LOG_DEBUG("LevelManager: Using embedded level {}", levelNumber);
+        LevelTemplatePtr levelTemplate = std::make_shared<const LevelTemplate>(embedded::toLevelData(*embeddedLevel));
+        m_templateCache[levelNumber] = levelTemplate;
+        return levelTemplate;
+    }
+#endif
+
     std::string filename = m_levelBasePath + "level" + std::to_string(levelNumber) + ".json";
-    std::cout << "LevelManager: Performing actual load of: " << filename << std::endl;
-    return loadLevelDataFromFile(filename, outLevelData);
+    T3_LOG_INFO("LevelManager: Performing actual load of: {}", filename);
+    LevelData levelData;
+    int previousTarget = m_targetLevelNumber;
+    m_targetLevelNumber = levelNumber;
+    bool loaded = loadLevelDataFromFile(filename, levelData);
+    m_targetLevelNumber = previousTarget;
+    if (!loaded) {
+        return nullptr;
+    }
+    LevelTemplatePtr levelTemplate = std::make_shared<const LevelTemplate>(std::move(levelData));
+    m_templateCache[levelNumber] = levelTemplate;
+    return levelTemplate;
 }
 
 bool LevelManager::loadLevelDataFromFile(const std::string& filename, LevelData& outLevelData) {
-    std::cout << "LevelManager (internal): Reading JSON from: " << filename << std::endl;
+    T3_LOG_DEBUG("LevelManager (internal): Reading JSON from: {}", filename);
     rapidjson::Document* doc = readJsonFile(filename);
     if (!doc) {
-        std::cerr << "LevelManager: Failed to read/parse " << filename << std::endl;
+        T3_LOG_ERROR("LevelManager: Failed to read/parse {}", filename);
         return false;
     }
     bool parseSuccess = parseLevelData(*doc, outLevelData);
     freeJsonDocument(doc);
     if (parseSuccess) {
         outLevelData.levelNumber = m_targetLevelNumber;
-        std::cout << "LevelManager (internal): Successfully parsed data from " << filename << std::endl;
+        T3_LOG_DEBUG("LevelManager (internal): Successfully parsed data from {}", filename);
     } else {
-        std::cerr << "LevelManager (internal): Failed to parse level data structure from " << filename << std::endl;
+        T3_LOG_ERROR("LevelManager (internal): Failed to parse level data structure from {}", filename);
     }
     return parseSuccess;
 }
 
+bool LevelManager::parseLevelJson(const char* json, std::size_t size, LevelData& outLevelData) {
+    rapidjson::Document doc;
+    doc.Parse(json, size);
+    if (doc.HasParseError()) {
+        T3_LOG_ERROR("LevelManager Error parsing JSON (offset {}): {}", doc.GetErrorOffset(), rapidjson::GetParseError_En(doc.GetParseError()));
+        return false;
+    }
+    return parseLevelData(doc, outLevelData);
+}
+
 // MADE PUBLIC and CONST
 phys::bodyType LevelManager::stringToBodyType(const std::string& typeStr) const {
     auto it = m_bodyTypeMap.find(typeStr);
     if (it != m_bodyTypeMap.end()) {
         return it->second;
     }
-    std::cerr << "LevelManager Warning: Unknown bodyType string: '" << typeStr << "'. Defaulting to 'solid'." << std::endl;
+    T3_LOG_WARNING("LevelManager Warning: Unknown bodyType string: '{}'. Defaulting to 'solid'.", typeStr);
     return phys::bodyType::solid;
 }
 
-rapidjson::Document* LevelManager::readJsonFile(const std::string& filepath) {
+rapidjson::Document* LevelManager::readJsonFile(const std::string& filepath) const {
+    if (m_assetPack) {
+        AssetPack::View packed = m_assetPack->find(AssetPack::keyFor(filepath));
+        if (packed) {
+            rapidjson::Document* d = new rapidjson::Document();
+            d->Parse(static_cast<const char*>(packed.data), packed.size);
+            if (d->HasParseError()) {
+                T3_LOG_ERROR("LevelManager Error parsing packed JSON: {} (offset {}): {}", filepath, d->GetErrorOffset(),
+                             rapidjson::GetParseError_En(d->GetParseError()));
+                delete d;
+                return nullptr;
+            }
+            return d;
+        }
+    }
     FILE* fp = fopen(filepath.c_str(), "rb");
     if (!fp) {
-        std::cerr << "LevelManager Error: Could not open JSON file: " << filepath << std::endl;
+        T3_LOG_ERROR("LevelManager Error: Could not open JSON file: {}", filepath);
         return nullptr;
     }
     char readBuffer[65536];
@@ -240,16 +327,15 @@ rapidjson::Document* LevelManager::readJsonFile(const std::string& filepath) {
     d->ParseStream(is);
     fclose(fp);
     if (d->HasParseError()) {
-        std::cerr << "LevelManager Error parsing JSON: " << filepath << std::endl;
-        std::cerr << "Error (offset " << d->GetErrorOffset() << "): "
-                  << rapidjson::GetParseError_En(d->GetParseError()) << std::endl;
+        T3_LOG_ERROR("LevelManager Error parsing JSON: {} (offset {}): {}", filepath, d->GetErrorOffset(),
+                     rapidjson::GetParseError_En(d->GetParseError()));
         delete d;
         return nullptr;
     }
     return d;
 }
 
-void LevelManager::freeJsonDocument(rapidjson::Document* doc) {
+void LevelManager::freeJsonDocument(rapidjson::Document* doc) const {
     if (doc) {
         delete doc;
     }
@@ -259,33 +345,33 @@ bool LevelManager::parseLevelData(const rapidjson::Document& d, LevelData& outLe
     outLevelData.platforms.clear();
     outLevelData.movingPlatformDetails.clear();
     outLevelData.interactiblePlatformDetails.clear();
-    outLevelData.portalPlatformDetails.clear();  
+    outLevelData.portalPlatformDetails.clear();
+    outLevelData.streaming = LevelData::StreamingInfo();
     if (d.HasMember("levelName") && d["levelName"].IsString()) {
         outLevelData.levelName = d["levelName"].GetString();
     } else {
         outLevelData.levelName = "Unnamed Level";
-         std::cerr << "LevelManager Parse Warning: 'levelName' missing or not string." << std::endl;
+         T3_LOG_WARNING("LevelManager Parse Warning: 'levelName' missing or not string.");
     }
 
     if (d.HasMember("levelNumber") && d["levelNumber"].IsInt()) {
            int jsonLevelNum = d["levelNumber"].GetInt();
            if (jsonLevelNum != m_targetLevelNumber && m_targetLevelNumber !=0 ) {
-               std::cerr << "LevelManager Parse Warning: JSON levelNumber (" << jsonLevelNum
-                         << ") mismatches target load (" << m_targetLevelNumber << ")." << std::endl;
+               T3_LOG_WARNING("LevelManager Parse Warning: JSON levelNumber ({}) mismatches target load ({}).", jsonLevelNum, m_targetLevelNumber);
            }
         outLevelData.levelNumber = d["levelNumber"].GetInt();
     } else {
-        std::cerr << "LevelManager Parse Warning: 'levelNumber' missing or not an int." << std::endl;
+        T3_LOG_WARNING("LevelManager Parse Warning: 'levelNumber' missing or not an int.");
     }
 
     if (d.HasMember("playerStart") && d["playerStart"].IsObject()) {
         const auto& ps = d["playerStart"];
         if (ps.HasMember("x") && ps["x"].IsNumber()) outLevelData.playerStartPosition.x = ps["x"].GetFloat();
-        else std::cerr << "LevelManager Parse Warning: playerStart.x missing/not number." << std::endl;
+        else T3_LOG_WARNING("LevelManager Parse Warning: playerStart.x missing/not number.");
         if (ps.HasMember("y") && ps["y"].IsNumber()) outLevelData.playerStartPosition.y = ps["y"].GetFloat();
-        else std::cerr << "LevelManager Parse Warning: playerStart.y missing/not number." << std::endl;
+        else T3_LOG_WARNING("LevelManager Parse Warning: playerStart.y missing/not number.");
     } else {
-        std::cerr << "LevelManager Parse Warning: 'playerStart' missing or not object." << std::endl;
+        T3_LOG_WARNING("LevelManager Parse Warning: 'playerStart' missing or not object.");
         outLevelData.playerStartPosition = {100.f, 100.f};
     }
 
@@ -298,184 +384,274 @@ bool LevelManager::parseLevelData(const rapidjson::Document& d, LevelData& outLe
         if (bc.HasMember("a") && bc["a"].IsUint()) a_json = static_cast<sf::Uint8>(bc["a"].GetUint());
         outLevelData.backgroundColor = sf::Color(r, g_json, b_json, a_json);
     } else {
-        std::cerr << "LevelManager Parse Warning: 'backgroundColor' missing. Using default." << std::endl;
+        T3_LOG_WARNING("LevelManager Parse Warning: 'backgroundColor' missing. Using default.");
          outLevelData.backgroundColor = sf::Color(20, 20, 40);
     }
+    if (d.HasMember("streaming") && d["streaming"].IsObject()) {
+        if (!parseStreamingInfo(d["streaming"], outLevelData.streaming)) {
+            return false;
+        }
+    }
     if (d.HasMember("platforms") && d["platforms"].IsArray()) {
-        const auto& platformsArray = d["platforms"];
-        outLevelData.platforms.reserve(platformsArray.Size());
+        return parsePlatforms(d["platforms"], outLevelData);
+    } else if (outLevelData.streaming.enabled) {
+        return true; // all geometry lives in the chunk files
+    } else {
+        T3_LOG_ERROR("LevelManager Error: Missing platforms array");
+        return false;
+    }
+}
 
-        for (rapidjson::SizeType i = 0; i < platformsArray.Size(); ++i) {
-            const auto& platJson = platformsArray[i];
-            if (!platJson.IsObject()) continue;
+bool LevelManager::parseStreamingInfo(const rapidjson::Value& s, LevelData::StreamingInfo& outStreaming) const {
+    outStreaming = LevelData::StreamingInfo();
+    if (s.HasMember("chunkSize") && s["chunkSize"].IsNumber()) outStreaming.chunkSize = s["chunkSize"].GetFloat();
+    if (s.HasMember("loadRadius") && s["loadRadius"].IsInt()) outStreaming.loadRadius = s["loadRadius"].GetInt();
+    if (s.HasMember("unloadRadius") && s["unloadRadius"].IsInt()) outStreaming.unloadRadius = s["unloadRadius"].GetInt();
+    if (s.HasMember("maxPendingLoads") && s["maxPendingLoads"].IsInt()) outStreaming.maxPendingLoads = s["maxPendingLoads"].GetInt();
+    if (s.HasMember("fallDistance") && s["fallDistance"].IsNumber()) outStreaming.fallDistance = s["fallDistance"].GetFloat();
+    if (s.HasMember("deathChunkRow") && s["deathChunkRow"].IsInt()) {
+        outStreaming.hasDeathChunkRow = true;
+        outStreaming.deathChunkRow = s["deathChunkRow"].GetInt();
+    }
+    if (s.HasMember("startChunk") && s["startChunk"].IsObject()) {
+        const auto& sc = s["startChunk"];
+        if (sc.HasMember("x") && sc["x"].IsInt()) outStreaming.startChunk.x = sc["x"].GetInt();
+        if (sc.HasMember("y") && sc["y"].IsInt()) outStreaming.startChunk.y = sc["y"].GetInt();
+    }
 
-            // Parse Common Properties
-            unsigned int id = 0;
-            if (platJson.HasMember("id") && platJson["id"].IsUint()) {
-                id = platJson["id"].GetUint();
+    if (outStreaming.chunkSize < 64.f) {
+        T3_LOG_ERROR("LevelManager Error: streaming.chunkSize must be at least 64");
+        return false;
+    }
+    if (outStreaming.loadRadius < 0) outStreaming.loadRadius = 0;
+    if (outStreaming.unloadRadius <= outStreaming.loadRadius) {
+        T3_LOG_WARNING("LevelManager Parse Warning: streaming.unloadRadius must be larger than loadRadius, using {}",
+                       outStreaming.loadRadius + 1);
+        outStreaming.unloadRadius = outStreaming.loadRadius + 1;
+    }
+    if (outStreaming.maxPendingLoads < 1) outStreaming.maxPendingLoads = 1;
+
+    if (!s.HasMember("chunks") || !s["chunks"].IsArray()) {
+        T3_LOG_ERROR("LevelManager Error: streaming block without a chunks array");
+        return false;
+    }
+    const auto& chunksArray = s["chunks"];
+    outStreaming.chunks.reserve(chunksArray.Size());
+    for (rapidjson::SizeType i = 0; i < chunksArray.Size(); ++i) {
+        const auto& c = chunksArray[i];
+        if (!c.IsObject() || !c.HasMember("x") || !c["x"].IsInt() || !c.HasMember("y") || !c["y"].IsInt() ||
+            !c.HasMember("file") || !c["file"].IsString()) {
+            T3_LOG_WARNING("LevelManager Parse Warning: skipping malformed chunk entry {}", i);
+            continue;
+        }
+        LevelData::ChunkEntry entry;
+        entry.x = c["x"].GetInt();
+        entry.y = c["y"].GetInt();
+        entry.file = c["file"].GetString();
+        outStreaming.chunks.push_back(entry);
+    }
+    outStreaming.enabled = true;
+    return true;
+}
+
+bool LevelManager::parsePlatforms(const rapidjson::Value& platformsArray, LevelData& outLevelData) const {
+    outLevelData.platforms.reserve(platformsArray.Size());
+
+    for (rapidjson::SizeType i = 0; i < platformsArray.Size(); ++i) {
+        const auto& platJson = platformsArray[i];
+        if (!platJson.IsObject()) continue;
+
+        // Parse Common Properties
+        unsigned int id = 0;
+        if (platJson.HasMember("id") && platJson["id"].IsUint()) {
+            id = platJson["id"].GetUint();
+        } else {
+            id = static_cast<unsigned int>(outLevelData.platforms.size() + 1000);
+            T3_LOG_WARNING("Auto-assigned ID: {} to missing ID platform", id);
+        }
+        // Parse Position
+        sf::Vector2f pos{0, 0};
+        if (platJson.HasMember("position") && platJson["position"].IsObject()) {
+            const auto& posJson = platJson["position"];
+            pos.x = posJson.HasMember("x") ? posJson["x"].GetFloat() : 0;
+            pos.y = posJson.HasMember("y") ? posJson["y"].GetFloat() : 0;
+        }
+
+        // Parse Size 
+        float width = 50.f, height = 50.f; // Default values if not specified
+        if (platJson.HasMember("size") && platJson["size"].IsObject()) {
+            const auto& sizeJson = platJson["size"];
+            width = sizeJson.HasMember("width") ? sizeJson["width"].GetFloat() : width;
+            height = sizeJson.HasMember("height") ? sizeJson["height"].GetFloat() : height;
+        } else { T3_LOG_WARNING("Platform ID {} missing size, using defaults.", id); } // Added warning for missing size
+
+        sf::Vector2f surfaceVel = {0.f, 0.f};
+        if (platJson.HasMember("surfaceVelocity") && platJson["surfaceVelocity"].IsObject()) {
+            const auto& sv = platJson["surfaceVelocity"];
+            if (sv.HasMember("x") && sv["x"].IsNumber()) surfaceVel.x = sv["x"].GetFloat();
+            if (sv.HasMember("y") && sv["y"].IsNumber()) surfaceVel.y = sv["y"].GetFloat();
+        }
+
+        bool initiallyFalling = false;
+        if (platJson.HasMember("initiallyFalling") && platJson["initiallyFalling"].IsBool()) {
+           initiallyFalling = platJson["initiallyFalling"].GetBool();
+        }
+
+        // Parse Body Type
+        phys::bodyType type = phys::bodyType::solid; 
+        if (platJson.HasMember("type") && platJson["type"].IsString()) {
+            type = stringToBodyType(platJson["type"].GetString());
+        }
+
+        // Create Base Platform
+        phys::PlatformShape shape;
+        shape.id = id;
+        shape.position = pos;
+        shape.width = width;
+        shape.height = height;
+        shape.type = type;
+        shape.initiallyFalling = initiallyFalling;
+        shape.surfaceVelocity = surfaceVel;
+        outLevelData.platforms.push_back(shape);
+
+        // Handle Special Types
+        if (type == phys::bodyType::portal) {
+            LevelData::PortalPlatformInfo ppi;
+            ppi.id = id;
+
+            // Parse PortalID (Required)
+            if (platJson.HasMember("portalID") && platJson["portalID"].IsUint()) {
+                ppi.portalID = platJson["portalID"].GetUint();
             } else {
-                id = static_cast<unsigned int>(outLevelData.platforms.size() + 1000);
-                std::cerr << "Auto-assigned ID: " << id << " to missing ID platform\n";
-            }
-            // Parse Position
-            sf::Vector2f pos{0, 0};
-            if (platJson.HasMember("position") && platJson["position"].IsObject()) {
-                const auto& posJson = platJson["position"];
-                pos.x = posJson.HasMember("x") ? posJson["x"].GetFloat() : 0;
-                pos.y = posJson.HasMember("y") ? posJson["y"].GetFloat() : 0;
+                T3_LOG_WARNING("Portal missing portalID, ID: {}", id);
+                continue;
             }
 
-            // Parse Size 
-            float width = 50.f, height = 50.f; // Default values if not specified
-            if (platJson.HasMember("size") && platJson["size"].IsObject()) {
-                const auto& sizeJson = platJson["size"];
-                width = sizeJson.HasMember("width") ? sizeJson["width"].GetFloat() : width;
-                height = sizeJson.HasMember("height") ? sizeJson["height"].GetFloat() : height;
-            } else { std::cerr << "Platform ID " << id << " missing size, using defaults.\n"; } // Added warning for missing size
-
-            sf::Vector2f surfaceVel = {0.f, 0.f};
-            if (platJson.HasMember("surfaceVelocity") && platJson["surfaceVelocity"].IsObject()) {
-                const auto& sv = platJson["surfaceVelocity"];
-                if (sv.HasMember("x") && sv["x"].IsNumber()) surfaceVel.x = sv["x"].GetFloat();
-                if (sv.HasMember("y") && sv["y"].IsNumber()) surfaceVel.y = sv["y"].GetFloat();
+            // Parse Teleport Offset (Optional)
+            if (platJson.HasMember("teleportOffset") && platJson["teleportOffset"].IsObject()) {
+                const auto& offset = platJson["teleportOffset"];
+                ppi.offset.x = offset.HasMember("x") ? offset["x"].GetFloat() : 10.f;
+                ppi.offset.y = offset.HasMember("y") ? offset["y"].GetFloat() : 0.f;
             }
-
-            bool initiallyFalling = false;
-            if (platJson.HasMember("initiallyFalling") && platJson["initiallyFalling"].IsBool()) {
-               initiallyFalling = platJson["initiallyFalling"].GetBool();
+            outLevelData.portalPlatformDetails.push_back(ppi);
+        }
+        if (type == phys::bodyType::moving && platJson.HasMember("movement") && platJson["movement"].IsObject()) {
+            const auto& mov = platJson["movement"];
+            LevelData::MovingPlatformInfo mpi;
+            mpi.id = id;
+            mpi.startPosition = pos; // Use the platform's general 'pos' as default start, override if specified in 'movement'
+            if (mov.HasMember("startPosition") && mov["startPosition"].IsObject()) { 
+                const auto& msp = mov["startPosition"];
+                if (msp.HasMember("x") && msp["x"].IsNumber()) mpi.startPosition.x = msp["x"].GetFloat();
+                if (msp.HasMember("y") && msp["y"].IsNumber()) mpi.startPosition.y = msp["y"].GetFloat();
             }
-
-            // Parse Body Type
-            phys::bodyType type = phys::bodyType::solid; 
-            if (platJson.HasMember("type") && platJson["type"].IsString()) {
-                type = stringToBodyType(platJson["type"].GetString());
+            if (mov.HasMember("axis") && mov["axis"].IsString()) {
+                std::string axisStr = mov["axis"].GetString();
+                if (!axisStr.empty()) mpi.axis = std::tolower(axisStr[0]);
+                else T3_LOG_WARNING("Warning: Moving platform ID {} has empty axis.", id);
             }
-
-            // Create Base Platform
-            outLevelData.platforms.emplace_back(
-                id, pos, width, height, type, initiallyFalling, surfaceVel
-            );
-            
-            phys::PlatformBody& justAddedBody = outLevelData.platforms.back();
-
-            // Handle Special Types
-            if (type == phys::bodyType::portal) {
-                LevelData::PortalPlatformInfo ppi;
-                ppi.id = id;
-
-                // Parse PortalID (Required)
-                if (platJson.HasMember("portalID") && platJson["portalID"].IsUint()) {
-                    ppi.portalID = platJson["portalID"].GetUint();
-                } else {
-                    std::cerr << "Portal missing portalID, ID: " << id << "\n";
-                    continue;
-                }
-
-                // Parse Teleport Offset (Optional)
-                if (platJson.HasMember("teleportOffset") && platJson["teleportOffset"].IsObject()) {
-                    const auto& offset = platJson["teleportOffset"];
-                    ppi.offset.x = offset.HasMember("x") ? offset["x"].GetFloat() : 10.f;
-                    ppi.offset.y = offset.HasMember("y") ? offset["y"].GetFloat() : 0.f;
-                }
-                outLevelData.portalPlatformDetails.push_back(ppi);
+            if (mov.HasMember("distance") && mov["distance"].IsNumber()) {
+                mpi.distance = mov["distance"].GetFloat();
             }
-            if (type == phys::bodyType::moving && platJson.HasMember("movement") && platJson["movement"].IsObject()) {
-                const auto& mov = platJson["movement"];
-                LevelData::MovingPlatformInfo mpi;
-                mpi.id = id;
-                mpi.startPosition = pos; // Use the platform's general 'pos' as default start, override if specified in 'movement'
-                if (mov.HasMember("startPosition") && mov["startPosition"].IsObject()) { 
-                    const auto& msp = mov["startPosition"];
-                    if (msp.HasMember("x") && msp["x"].IsNumber()) mpi.startPosition.x = msp["x"].GetFloat();
-                    if (msp.HasMember("y") && msp["y"].IsNumber()) mpi.startPosition.y = msp["y"].GetFloat();
-                }
-                if (mov.HasMember("axis") && mov["axis"].IsString()) {
-                    std::string axisStr = mov["axis"].GetString();
-                    if (!axisStr.empty()) mpi.axis = std::tolower(axisStr[0]);
-                    else std::cerr << "Warning: Moving platform ID " << id << " has empty axis." << std::endl;
-                }
-                if (mov.HasMember("distance") && mov["distance"].IsNumber()) {
-                    mpi.distance = mov["distance"].GetFloat();
-                }
-                if (mov.HasMember("cycleDuration") && mov["cycleDuration"].IsNumber()) {
-                    mpi.cycleDuration = mov["cycleDuration"].GetFloat();
-                     if (mpi.cycleDuration <= 0.f) {
-                        std::cerr << "Warning: Non-positive cycleDuration for moving platform " << id << ". Defaulting to 4s." << std::endl;
-                        mpi.cycleDuration = 4.f;
-                     }
-                }
-                 if (mov.HasMember("initialDirection") && mov["initialDirection"].IsInt()) {
-                    mpi.initialDirection = mov["initialDirection"].GetInt();
-                    if(mpi.initialDirection != 1 && mpi.initialDirection != -1) {
-                        std::cerr << "Warning: Invalid initialDirection for moving platform " << id << ". Defaulting to 1." << std::endl;
-                        mpi.initialDirection = 1;
-                    }
-                }
-                outLevelData.movingPlatformDetails.push_back(mpi);
+            if (mov.HasMember("cycleDuration") && mov["cycleDuration"].IsNumber()) {
+                mpi.cycleDuration = mov["cycleDuration"].GetFloat();
+                 if (mpi.cycleDuration <= 0.f) {
+                    T3_LOG_WARNING("Warning: Non-positive cycleDuration for moving platform {}. Defaulting to 4s.", id);
+                    mpi.cycleDuration = 4.f;
+                 }
             }
-            // PARSE INTERACTIBLE DETAILS
-            else if (type == phys::bodyType::interactible && platJson.HasMember("interaction") && platJson["interaction"].IsObject()) {
-                const auto& inter = platJson["interaction"];
-                LevelData::InteractiblePlatformInfo ipi;
-                ipi.id = id;
-
-                if (inter.HasMember("type") && inter["type"].IsString()) {
-                    ipi.interactionType = inter["type"].GetString();
-                }
-                if (inter.HasMember("targetBodyType") && inter["targetBodyType"].IsString()) {
-                    ipi.targetBodyTypeStr = inter["targetBodyType"].GetString();
-                } else {
-                    std::cerr << "LevelManager Parse Error: Interactible platform ID " << id << " 'interaction' block missing 'targetBodyType' string. Defaulting to 'solid'." << std::endl;
-                    ipi.targetBodyTypeStr = "solid"; 
-                }
-
-                if (inter.HasMember("targetTileColor") && inter["targetTileColor"].IsObject()) {
-                    const auto& tc = inter["targetTileColor"];
-                    sf::Uint8 r_tc = 0, g_tc = 0, b_tc = 0, a_tc = 255;
-                    if (tc.HasMember("r") && tc["r"].IsUint()) r_tc = static_cast<sf::Uint8>(tc["r"].GetUint());
-                    if (tc.HasMember("g") && tc["g"].IsUint()) g_tc = static_cast<sf::Uint8>(tc["g"].GetUint());
-                    if (tc.HasMember("b") && tc["b"].IsUint()) b_tc = static_cast<sf::Uint8>(tc["b"].GetUint());
-                    if (tc.HasMember("a") && tc["a"].IsUint()) a_tc = static_cast<sf::Uint8>(tc["a"].GetUint());
-                    ipi.targetTileColor = sf::Color(r_tc, g_tc, b_tc, a_tc);
-                    ipi.hasTargetTileColor = true;
+             if (mov.HasMember("initialDirection") && mov["initialDirection"].IsInt()) {
+                mpi.initialDirection = mov["initialDirection"].GetInt();
+                if(mpi.initialDirection != 1 && mpi.initialDirection != -1) {
+                    T3_LOG_WARNING("Warning: Invalid initialDirection for moving platform {}. Defaulting to 1.", id);
+                    mpi.initialDirection = 1;
                 }
+            }
+            outLevelData.movingPlatformDetails.push_back(mpi);
+        }
+        // PARSE INTERACTIBLE DETAILS
+        else if (type == phys::bodyType::interactible && platJson.HasMember("interaction") && platJson["interaction"].IsObject()) {
+            const auto& inter = platJson["interaction"];
+            LevelData::InteractiblePlatformInfo ipi;
+            ipi.id = id;
+
+            if (inter.HasMember("type") && inter["type"].IsString()) {
+                ipi.interactionType = inter["type"].GetString();
+            }
+            ipi.interaction = LevelData::InteractiblePlatformInfo::toInteraction(ipi.interactionType);
+            if (inter.HasMember("targetBodyType") && inter["targetBodyType"].IsString()) {
+                ipi.targetBodyTypeStr = inter["targetBodyType"].GetString();
+            } else {
+                T3_LOG_WARNING("LevelManager Parse Error: Interactible platform ID {} 'interaction' block missing 'targetBodyType' string. Defaulting to 'solid'.", id);
+                ipi.targetBodyTypeStr = "solid"; 
+            }
+            ipi.targetBodyType = stringToBodyType(ipi.targetBodyTypeStr);
+
+            if (inter.HasMember("targetTileColor") && inter["targetTileColor"].IsObject()) {
+                const auto& tc = inter["targetTileColor"];
+                sf::Uint8 r_tc = 0, g_tc = 0, b_tc = 0, a_tc = 255;
+                if (tc.HasMember("r") && tc["r"].IsUint()) r_tc = static_cast<sf::Uint8>(tc["r"].GetUint());
+                if (tc.HasMember("g") && tc["g"].IsUint()) g_tc = static_cast<sf::Uint8>(tc["g"].GetUint());
+                if (tc.HasMember("b") && tc["b"].IsUint()) b_tc = static_cast<sf::Uint8>(tc["b"].GetUint());
+                if (tc.HasMember("a") && tc["a"].IsUint()) a_tc = static_cast<sf::Uint8>(tc["a"].GetUint());
+                ipi.targetTileColor = sf::Color(r_tc, g_tc, b_tc, a_tc);
+                ipi.hasTargetTileColor = true;
+            }
 
-                if (inter.HasMember("oneTime") && inter["oneTime"].IsBool()) {
-                    ipi.oneTime = inter["oneTime"].GetBool();
-                }
-                if (inter.HasMember("cooldown") && inter["cooldown"].IsNumber()) {
-                    ipi.cooldown = inter["cooldown"].GetFloat();
-                }
-                 if (inter.HasMember("linkedID") && inter["linkedID"].IsUint()) { // Added linkedID parsing
-                    ipi.linkedID = inter["linkedID"].GetUint();
-                }
-                outLevelData.interactiblePlatformDetails.push_back(ipi); // Ensure this is added for interactibles
-            
+            if (inter.HasMember("oneTime") && inter["oneTime"].IsBool()) {
+                ipi.oneTime = inter["oneTime"].GetBool();
             }
-            else if (type == phys::bodyType::portal) { // Was nested, should be 'else if'
-                LevelData::PortalPlatformInfo ppi;
-                ppi.id = id;
+            if (inter.HasMember("cooldown") && inter["cooldown"].IsNumber()) {
+                ipi.cooldown = inter["cooldown"].GetFloat();
+            }
+             if (inter.HasMember("linkedID") && inter["linkedID"].IsUint()) { // Added linkedID parsing
+                ipi.linkedID = inter["linkedID"].GetUint();
+            }
+            outLevelData.interactiblePlatformDetails.push_back(ipi); // Ensure this is added for interactibles
+        
+        }
+        else if (type == phys::bodyType::portal) { // Was nested, should be 'else if'
+            LevelData::PortalPlatformInfo ppi;
+            ppi.id = id;
 
-                // Parse portalID (required)
-                if (platJson.HasMember("portalID") && platJson["portalID"].IsUint()) {
-                    ppi.portalID = platJson["portalID"].GetUint();
-                } else {
-                    std::cerr << "Portal ID " << id << " missing portalID, skipping portal details.\n";
-                    continue; 
-                }
+            // Parse portalID (required)
+            if (platJson.HasMember("portalID") && platJson["portalID"].IsUint()) {
+                ppi.portalID = platJson["portalID"].GetUint();
+            } else {
+                T3_LOG_WARNING("Portal ID {} missing portalID, skipping portal details.", id);
+                continue; 
+            }
 
-                // Parse offset (optional, defaults provided in struct)
-                if (platJson.HasMember("teleportOffset") && platJson["teleportOffset"].IsObject()) {
-                    const auto& offset = platJson["teleportOffset"];
-                    if (offset.HasMember("x") && offset["x"].IsNumber()) ppi.offset.x = offset["x"].GetFloat();
-                    if (offset.HasMember("y") && offset["y"].IsNumber()) ppi.offset.y = offset["y"].GetFloat();
-                }
-                outLevelData.portalPlatformDetails.push_back(ppi);
+            // Parse offset (optional, defaults provided in struct)
+            if (platJson.HasMember("teleportOffset") && platJson["teleportOffset"].IsObject()) {
+                const auto& offset = platJson["teleportOffset"];
+                if (offset.HasMember("x") && offset["x"].IsNumber()) ppi.offset.x = offset["x"].GetFloat();
+                if (offset.HasMember("y") && offset["y"].IsNumber()) ppi.offset.y = offset["y"].GetFloat();
             }
-        } 
-    } else {
-        std::cerr << "LevelManager Error: Missing platforms array\n";
-        return false;
+            outLevelData.portalPlatformDetails.push_back(ppi);
+        }
     }
     return true;
 }
+
+LevelTemplatePtr LevelManager::loadChunkTemplate(const std::string& relativePath) const {
+#ifdef T3_EMBEDDED_LEVELS
+    if (const embedded::Level* embeddedChunk = embedded::findFile(relativePath.c_str())) {
+        return std::make_shared<const LevelTemplate>(embedded::toLevelData(*embeddedChunk));
+    }
+#endif
+    const std::string filename = m_levelBasePath + relativePath;
+    rapidjson::Document* doc = readJsonFile(filename);
+    if (!doc) {
+        return nullptr;
+    }
+    LevelData chunkData;
+    bool ok = doc->IsObject() && doc->HasMember("platforms") && (*doc)["platforms"].IsArray()
+              && parsePlatforms((*doc)["platforms"], chunkData);
+    freeJsonDocument(doc);
+    if (!ok) {
+        T3_LOG_ERROR("LevelManager Error: Bad chunk file {}", filename);
+        return nullptr;
+    }
+    return std::make_shared<const LevelTemplate>(std::move(chunkData));
+}
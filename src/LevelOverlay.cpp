@@ -0,0 +1,179 @@
+#include "LevelOverlay.hpp"
+#include "Log.hpp"
+#include "Easing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+    const float FALL_CUTOFF_Y = 600.f; // no floor in a fixed level, falling platforms are gone once they pass this
+}
+
+LevelOverlay::LevelOverlay()
+    : m_nodePool(std::pmr::pool_options{32, 256}, &m_arena),
+      bodies(&m_arena),
+      movingPlatforms(&m_arena),
+      fallingPlatforms(&m_arena),
+      interactibles(&m_nodePool),
+      m_segments(&m_arena) {
+}
+
+void LevelOverlay::reset(LevelTemplatePtr levelTemplate) {
+    clear();
+    m_template = std::move(levelTemplate);
+    if (!m_template) return;
+    appendSegment(m_template, {0.f, 0.f});
+}
+
+void LevelOverlay::clear() {
+    // swapped for empty ones rather than cleared, a cleared vector keeps its buffer and the arena is about to hand it out again
+    bodies = phys::BodyList(&m_arena);
+    movingPlatforms = std::pmr::vector<ActiveMovingPlatform>(&m_arena);
+    fallingPlatforms = std::pmr::vector<ActiveFallingPlatform>(&m_arena);
+    interactibles = std::pmr::map<unsigned int, ActiveInteractiblePlatform>(&m_nodePool);
+    vanishingPlatformCycleTimer = sf::Time::Zero;
+    oddEvenVanishing = 1;
+    m_segments = std::pmr::vector<Segment>(&m_arena);
+    m_template.reset();
+    m_nodePool.release();
+    m_arena.reset();
+}
+
+unsigned int LevelOverlay::appendSegment(LevelTemplatePtr segmentTemplate, const sf::Vector2f& origin) {
+    Segment segment{m_nextSegmentHandle++, std::move(segmentTemplate), bodies.size(), 0, origin};
+    if (!segment.levelTemplate) return segment.handle;
+
+    const LevelTemplate& levelTemplate = *segment.levelTemplate;
+    const std::vector<phys::PlatformShape>& shapes = levelTemplate.getPlatforms();
+    // doubling, an exact fit would leave a dead buffer in the arena for every chunk streamed in
+    if (bodies.size() + shapes.size() > bodies.capacity()) bodies.reserve(std::max(bodies.size() + shapes.size(), bodies.capacity() * 2));
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        const std::size_t bodyIndex = bodies.size();
+        bodies.emplace_back(shapes[i]);
+        phys::PlatformBody& new_body_ref = bodies.back();
+        new_body_ref.setPosition(origin + shapes[i].position);
+
+        if (new_body_ref.getType() == phys::bodyType::moving) {
+            const LevelData::MovingPlatformInfo* detail = levelTemplate.getMovingDetail(i);
+            if (detail) {
+                float t0_offset = 0.f;
+                if (detail->cycleDuration > 0.f && detail->cycleDuration / 2.0f > 1e-5f) {
+                    t0_offset = math::easing::ease<math::easing::Curve::SineInOut>(
+                        0.f, 0.f,
+                        static_cast<float>(detail->initialDirection) * detail->distance,
+                        detail->cycleDuration / 2.0f
+                    );
+                }
+                sf::Vector2f calculatedInitialPos = origin + detail->startPosition;
+                if(detail->axis == 'x') calculatedInitialPos.x += t0_offset;
+                else if(detail->axis == 'y') calculatedInitialPos.y += t0_offset;
+
+                if (std::abs(new_body_ref.getPosition().x - calculatedInitialPos.x) > 0.1f ||
+                    std::abs(new_body_ref.getPosition().y - calculatedInitialPos.y) > 0.1f) {
+                     new_body_ref.setPosition(calculatedInitialPos);
+                }
+
+                movingPlatforms.push_back({bodyIndex, detail, 0.0f, new_body_ref.getPosition(), origin});
+            } else {
+                T3_LOG_WARNING("Warning: Moving platform ID {} (type 'moving' in JSON) missing movement details in LevelData. Will be static.",
+                               shapes[i].id);
+            }
+        }
+        else if (new_body_ref.getType() == phys::bodyType::falling) {
+            // no absolute floor in a streamed world, falling platforms drop a fixed distance instead
+            const bool streamed = m_template && m_template->getData().streaming.enabled;
+            const float cutoffY = streamed ? new_body_ref.getPosition().y + m_template->getData().streaming.fallDistance : FALL_CUTOFF_Y;
+            fallingPlatforms.push_back({bodyIndex, sf::Time::Zero, false, false, cutoffY});
+        }
+        else if (new_body_ref.getType() == phys::bodyType::interactible) {
+            const LevelData::InteractiblePlatformInfo* detail = levelTemplate.getInteractibleDetail(i);
+            if (detail) {
+                interactibles[detail->id] = {detail, false, 0.f};
+            } else {
+                T3_LOG_WARNING("Warning: Interactible platform ID {} (type 'interactible' in JSON) missing interaction details in LevelData. Will be static or unresponsive.",
+                               shapes[i].id);
+            }
+        }
+    }
+
+    segment.bodyCount = shapes.size();
+    m_segments.push_back(std::move(segment));
+    return m_segments.back().handle;
+}
+
+std::pair<std::size_t, std::size_t> LevelOverlay::removeSegment(unsigned int handle) {
+    auto segIt = std::find_if(m_segments.begin(), m_segments.end(),
+                              [handle](const Segment& seg) { return seg.handle == handle; });
+    if (segIt == m_segments.end()) return {0, 0};
+
+    const std::size_t first = segIt->firstBody;
+    const std::size_t count = segIt->bodyCount;
+
+    // interactibles are keyed by id, only drop the ones this segment put there
+    if (segIt->levelTemplate) {
+        for (std::size_t i = 0; i < segIt->levelTemplate->getPlatformCount(); ++i) {
+            const LevelData::InteractiblePlatformInfo* detail = segIt->levelTemplate->getInteractibleDetail(i);
+            if (!detail) continue;
+            auto it = interactibles.find(detail->id);
+            if (it != interactibles.end() && it->second.info == detail) interactibles.erase(it);
+        }
+    }
+
+    movingPlatforms.erase(std::remove_if(movingPlatforms.begin(), movingPlatforms.end(),
+                                         [first, count](const ActiveMovingPlatform& plat) {
+                                             return plat.bodyIndex >= first && plat.bodyIndex < first + count;
+                                         }),
+                          movingPlatforms.end());
+    for (auto& plat : movingPlatforms) {
+        if (plat.bodyIndex >= first + count) plat.bodyIndex -= count;
+    }
+    fallingPlatforms.erase(std::remove_if(fallingPlatforms.begin(), fallingPlatforms.end(),
+                                          [first, count](const ActiveFallingPlatform& plat) {
+                                              return plat.bodyIndex >= first && plat.bodyIndex < first + count;
+                                          }),
+                           fallingPlatforms.end());
+    for (auto& plat : fallingPlatforms) {
+        if (plat.bodyIndex >= first + count) plat.bodyIndex -= count;
+    }
+
+    bodies.erase(bodies.begin() + static_cast<std::ptrdiff_t>(first),
+                 bodies.begin() + static_cast<std::ptrdiff_t>(first + count));
+    segIt = m_segments.erase(segIt);
+    for (; segIt != m_segments.end(); ++segIt) segIt->firstBody -= count;
+
+    return {first, count};
+}
+
+void LevelOverlay::translate(const sf::Vector2f& delta) {
+    for (auto& body : bodies) body.setPosition(body.getPosition() + delta);
+    for (auto& seg : m_segments) seg.origin += delta;
+    for (auto& plat : movingPlatforms) {
+        plat.origin += delta;
+        plat.lastFrameActualPosition += delta;
+    }
+    for (auto& plat : fallingPlatforms) plat.cutoffY += delta.y;
+}
+
+const LevelOverlay::Segment* LevelOverlay::findSegment(std::size_t bodyIndex) const {
+    if (m_segments.size() == 1) return &m_segments.front(); // every non-streamed level
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), bodyIndex,
+                               [](std::size_t index, const Segment& seg) { return index < seg.firstBody; });
+    if (it == m_segments.begin()) return nullptr;
+    --it;
+    return bodyIndex < it->firstBody + it->bodyCount ? &*it : nullptr;
+}
+
+sf::Vector2f LevelOverlay::getSpawnPosition(std::size_t bodyIndex) const {
+    const sf::Vector2f& local = bodies[bodyIndex].getShape().position;
+    const Segment* seg = findSegment(bodyIndex);
+    return seg ? seg->origin + local : local;
+}
+
+std::size_t LevelOverlay::findBodyIndex(unsigned int id) const {
+    for (const auto& seg : m_segments) {
+        if (!seg.levelTemplate) continue;
+        std::size_t index = seg.levelTemplate->findPlatformIndex(id);
+        if (index != LevelTemplate::npos) return seg.firstBody + index;
+    }
+    return LevelTemplate::npos;
+}
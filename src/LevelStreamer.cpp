@@ -0,0 +1,153 @@
+#include "LevelStreamer.hpp"
+#include "LevelManager.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+LevelStreamer::LevelStreamer(const LevelManager& loader)
+    : m_loader(loader) {}
+
+LevelStreamer::~LevelStreamer() {
+    end();
+}
+
+bool LevelStreamer::begin(const LevelTemplatePtr& level) {
+    end();
+    if (!level || !level->getData().streaming.enabled) {
+        return false;
+    }
+    m_level = level;
+    m_info = &m_level->getData().streaming;
+    m_originChunk = m_info->startChunk;
+
+    m_chunkTable.reserve(m_info->chunks.size());
+    for (const auto& entry : m_info->chunks) {
+        if (!m_chunkTable.emplace(makeKey(entry.x, entry.y), ChunkRef{entry.x, entry.y, &entry.file}).second) {
+            T3_LOG_WARNING("LevelStreamer Warning: chunk ({}, {}) listed twice, keeping the first", entry.x, entry.y);
+        }
+    }
+    T3_LOG_INFO("LevelStreamer: Streaming {} chunks of {}px", m_chunkTable.size(), m_info->chunkSize);
+    return true;
+}
+
+void LevelStreamer::end() {
+    m_pending.clear(); // std::async futures join on destruction
+    m_resident.clear();
+    m_failed.clear();
+    m_chunkTable.clear();
+    m_info = nullptr;
+    m_level.reset();
+    m_originChunk = {0, 0};
+}
+
+LevelStreamer::Changes LevelStreamer::update(LevelOverlay& world, const sf::Vector2f& playerPos, const sf::Vector2f& cameraCenter) {
+    Changes changes;
+    if (!isActive()) return changes;
+
+    const sf::Vector2i playerChunk = chunkAt(playerPos);
+    const sf::Vector2i cameraChunk = chunkAt(cameraCenter);
+
+    // Move the origin along with the player before anything new is placed
+    if (std::abs(playerChunk.x - m_originChunk.x) > REBASE_DISTANCE || std::abs(playerChunk.y - m_originChunk.y) > REBASE_DISTANCE) {
+        changes.rebaseDelta = sf::Vector2f(static_cast<float>(m_originChunk.x - playerChunk.x),
+                                           static_cast<float>(m_originChunk.y - playerChunk.y)) * m_info->chunkSize;
+        changes.rebased = true;
+        m_originChunk = playerChunk;
+        world.translate(changes.rebaseDelta);
+    }
+
+    // Unload whatever drifted past the unload radius
+    for (auto it = m_resident.begin(); it != m_resident.end();) {
+        if (focusDistance(it->second.x, it->second.y, playerChunk, cameraChunk) > m_info->unloadRadius) {
+            std::pair<std::size_t, std::size_t> range = world.removeSegment(it->second.segmentHandle);
+            if (range.second > 0) changes.removedRanges.push_back(range);
+            it = m_resident.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Splice in finished loads
+    changes.firstAppendedBody = world.bodies.size();
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->second.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        LevelTemplatePtr chunk = it->second.result.get();
+        const int x = it->second.x;
+        const int y = it->second.y;
+        const ChunkKey key = it->first;
+        it = m_pending.erase(it);
+
+        if (!chunk) {
+            m_failed.insert(key);
+            continue;
+        }
+        if (focusDistance(x, y, playerChunk, cameraChunk) > m_info->unloadRadius) {
+            continue; // walked away while it was loading
+        }
+        unsigned int handle = world.appendSegment(std::move(chunk), chunkOrigin(x, y));
+        m_resident.emplace(key, ResidentChunk{x, y, handle});
+        changes.appended = true;
+    }
+
+    // Queue what is missing around the foci, nearest to the player first
+    std::vector<std::pair<int, ChunkKey>> wanted;
+    auto collect = [&](const sf::Vector2i& focus) {
+        for (int y = focus.y - m_info->loadRadius; y <= focus.y + m_info->loadRadius; ++y) {
+            for (int x = focus.x - m_info->loadRadius; x <= focus.x + m_info->loadRadius; ++x) {
+                const ChunkKey key = makeKey(x, y);
+                if (m_chunkTable.count(key) == 0 || m_resident.count(key) || m_pending.count(key) || m_failed.count(key)) continue;
+                wanted.emplace_back(chunkDistance(playerChunk, x, y), key);
+            }
+        }
+    };
+    collect(playerChunk);
+    if (cameraChunk != playerChunk) collect(cameraChunk);
+    std::sort(wanted.begin(), wanted.end());
+    wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+
+    for (const auto& candidate : wanted) {
+        if (static_cast<int>(m_pending.size()) >= m_info->maxPendingLoads) break;
+        const ChunkRef& ref = m_chunkTable.at(candidate.second);
+        const LevelManager* loader = &m_loader;
+        std::string file = *ref.file;
+        m_pending.emplace(candidate.second, PendingChunk{ref.x, ref.y,
+            std::async(std::launch::async, [loader, file]() { return loader->loadChunkTemplate(file); })});
+    }
+
+    return changes;
+}
+
+sf::Vector2i LevelStreamer::chunkAt(const sf::Vector2f& worldPos) const {
+    if (!m_info) return {0, 0};
+    return sf::Vector2i(m_originChunk.x + static_cast<int>(std::floor(worldPos.x / m_info->chunkSize)),
+                        m_originChunk.y + static_cast<int>(std::floor(worldPos.y / m_info->chunkSize)));
+}
+
+bool LevelStreamer::isBelowDeathRow(const sf::Vector2f& worldPos) const {
+    return m_info && m_info->hasDeathChunkRow && chunkAt(worldPos).y > m_info->deathChunkRow;
+}
+
+float LevelStreamer::getFallDistance() const {
+    return m_info ? m_info->fallDistance : 0.f;
+}
+
+LevelStreamer::ChunkKey LevelStreamer::makeKey(int x, int y) {
+    return (static_cast<ChunkKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+int LevelStreamer::chunkDistance(const sf::Vector2i& a, int x, int y) {
+    return std::max(std::abs(a.x - x), std::abs(a.y - y));
+}
+
+sf::Vector2f LevelStreamer::chunkOrigin(int x, int y) const {
+    return sf::Vector2f(static_cast<float>(x - m_originChunk.x), static_cast<float>(y - m_originChunk.y)) * m_info->chunkSize;
+}
+
+int LevelStreamer::focusDistance(int x, int y, const sf::Vector2i& playerChunk, const sf::Vector2i& cameraChunk) const {
+    return std::min(chunkDistance(playerChunk, x, y), chunkDistance(cameraChunk, x, y));
+}
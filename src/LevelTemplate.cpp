@@ -0,0 +1,41 @@
+#include "LevelTemplate.hpp"
+#include <utility>
+
+LevelTemplate::LevelTemplate(LevelData data)
+    : m_data(std::move(data)) {
+    const std::size_t count = m_data.platforms.size();
+    m_indexByID.reserve(count);
+    m_movingByIndex.assign(count, nullptr);
+    m_interactibleByIndex.assign(count, nullptr);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        m_indexByID.emplace(m_data.platforms[i].id, i); // emplace keeps the first platform for duplicated ids
+    }
+
+    // first detail block per id wins, same as the old per-frame linear lookups
+    std::unordered_map<unsigned int, const LevelData::MovingPlatformInfo*> movingByID;
+    std::unordered_map<unsigned int, const LevelData::InteractiblePlatformInfo*> interactibleByID;
+    for (const auto& detail : m_data.movingPlatformDetails) movingByID.emplace(detail.id, &detail);
+    for (const auto& detail : m_data.interactiblePlatformDetails) interactibleByID.emplace(detail.id, &detail);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const unsigned int id = m_data.platforms[i].id;
+        auto moving = movingByID.find(id);
+        if (moving != movingByID.end()) m_movingByIndex[i] = moving->second;
+        auto interactible = interactibleByID.find(id);
+        if (interactible != interactibleByID.end()) m_interactibleByIndex[i] = interactible->second;
+    }
+}
+
+std::size_t LevelTemplate::findPlatformIndex(unsigned int id) const {
+    auto it = m_indexByID.find(id);
+    return it != m_indexByID.end() ? it->second : npos;
+}
+
+const LevelData::MovingPlatformInfo* LevelTemplate::getMovingDetail(std::size_t platformIndex) const {
+    return platformIndex < m_movingByIndex.size() ? m_movingByIndex[platformIndex] : nullptr;
+}
+
+const LevelData::InteractiblePlatformInfo* LevelTemplate::getInteractibleDetail(std::size_t platformIndex) const {
+    return platformIndex < m_interactibleByIndex.size() ? m_interactibleByIndex[platformIndex] : nullptr;
+}
@@ -0,0 +1,234 @@
+#include "Log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace {
+    constexpr std::size_t LINE_CAPACITY = 1024;
+    constexpr std::int64_t RATE_WINDOW_US = 1000000;
+    constexpr auto IDLE_SLEEP = std::chrono::milliseconds(2);
+
+    // Bounded MPSC ring (Vyukov's): a slot is free for position p when its sequence is p, holds a message when
+    // it's p + 1. Producers race on head with a CAS, the one consumer just walks tail.
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        Log::Record record;
+    };
+
+    Slot slots[Log::QUEUE_CAPACITY];
+    std::atomic<std::uint64_t> head{0};
+    std::uint64_t tail = 0;                       // flush thread, or stop() once it's joined
+    std::atomic<std::uint64_t> dropped{0};
+    std::uint64_t droppedReported = 0;
+    std::atomic<bool> running{false};
+    std::atomic<std::uint32_t> producers{0};      // between beginRecord's running check and commitRecord
+    std::atomic<bool> stopping{false};
+    std::thread flushThread;
+    std::mutex startMutex;                        // start/stop only
+
+    const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+    std::int64_t nowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - processStart).count();
+    }
+
+    struct SlotsInit {
+        SlotsInit() {
+            for (std::size_t i = 0; i < Log::QUEUE_CAPACITY; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    } slotsInit;
+
+    class LineWriter {
+    public:
+        void append(const char* text, std::size_t length) {
+            length = std::min(length, LINE_CAPACITY - 1 - m_used);
+            std::memcpy(m_line + m_used, text, length);
+            m_used += length;
+        }
+        void appendf(const char* format, ...);
+        void finish(std::FILE* stream) {
+            m_line[m_used++] = '\n';
+            std::fwrite(m_line, 1, m_used, stream);
+        }
+
+    private:
+        char m_line[LINE_CAPACITY];
+        std::size_t m_used = 0;
+    };
+
+    void LineWriter::appendf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        const int written = std::vsnprintf(m_line + m_used, LINE_CAPACITY - 1 - m_used, format, args);
+        va_end(args);
+        if (written > 0) m_used = std::min(LINE_CAPACITY - 2, m_used + static_cast<std::size_t>(written));
+    }
+
+    void appendArg(LineWriter& line, const Log::Record& record, std::size_t index) {
+        const Log::Record::Value& value = record.values[index];
+        switch (record.types[index]) {
+            case Log::ArgType::Int: line.appendf("%" PRId64, value.i); break;
+            case Log::ArgType::UInt: line.appendf("%" PRIu64, value.u); break;
+            case Log::ArgType::Double: line.appendf("%g", value.d); break;
+            case Log::ArgType::Bool: line.append(value.u ? "true" : "false", value.u ? 4 : 5); break;
+            case Log::ArgType::Char: line.append(&value.c, 1); break;
+            case Log::ArgType::String: line.append(record.text + value.text.offset, value.text.length); break;
+        }
+    }
+
+    std::FILE* streamFor(LogLevel level) {
+        return level >= LogLevel::Warning ? stderr : stdout;
+    }
+
+    void writeRecord(const Log::Record& record) {
+        LineWriter line;
+        line.appendf("[%9.3f] ", static_cast<double>(record.timeUs) / 1e6);
+        std::size_t arg = 0;
+        for (const char* p = record.site->format; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}') {
+                if (arg < record.argCount) appendArg(line, record, arg++);
+                ++p;
+            } else {
+                line.append(p, 1);
+            }
+        }
+        if (record.suppressed > 0) line.appendf(" (%u more like this suppressed)", record.suppressed);
+        line.finish(streamFor(record.site->level));
+    }
+
+    // Flush thread only (or stop() after joining it).
+    bool drain() {
+        bool any = false;
+        for (;;) {
+            Slot& slot = slots[tail & (Log::QUEUE_CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+            writeRecord(slot.record);
+            slot.sequence.store(tail + Log::QUEUE_CAPACITY, std::memory_order_release);
+            ++tail;
+            any = true;
+        }
+        const std::uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+        if (droppedNow != droppedReported) {
+            std::fprintf(stderr, "Log: %" PRIu64 " messages dropped, queue full\n", droppedNow - droppedReported);
+            droppedReported = droppedNow;
+            any = true;
+        }
+        if (any) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+        }
+        return any;
+    }
+
+    void flushLoop() {
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (!drain()) std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+        drain();
+    }
+
+    bool admit(LogSite& site, std::int64_t now) {
+        std::int64_t windowStart = site.windowStartUs.load(std::memory_order_relaxed);
+        if (now - windowStart >= RATE_WINDOW_US &&
+            site.windowStartUs.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+            site.windowCount.store(0, std::memory_order_relaxed);
+        }
+        if (site.windowCount.fetch_add(1, std::memory_order_relaxed) < Log::RATE_LIMIT) return true;
+        site.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    thread_local Log::Record directRecord; // messages written straight away, while no flush thread runs
+}
+
+void Log::Record::addText(Value& slot, std::string_view value) {
+    const std::size_t length = std::min(value.size(), TEXT_CAPACITY - textUsed);
+    std::memcpy(text + textUsed, value.data(), length);
+    slot.text.offset = textUsed;
+    slot.text.length = static_cast<std::uint16_t>(length);
+    textUsed = static_cast<std::uint16_t>(textUsed + length);
+}
+
+void Log::start() {
+    std::lock_guard<std::mutex> lock(startMutex);
+    if (running.load(std::memory_order_relaxed)) return;
+    static const bool stopAtExit = (std::atexit(Log::stop), true);
+    (void)stopAtExit;
+    stopping.store(false, std::memory_order_relaxed);
+    flushThread = std::thread(flushLoop);
+    running.store(true, std::memory_order_release);
+}
+
+void Log::stop() {
+    std::lock_guard<std::mutex> lock(startMutex);
+    if (!running.load(std::memory_order_relaxed)) return;
+    running.store(false);
+    // a thread that saw running just before it went false may still be filling its slot, and drain() stops at
+    // the first one that isn't committed. Both sides are seq_cst, so it either sees running false or gets counted
+    while (producers.load() != 0) std::this_thread::yield();
+    stopping.store(true, std::memory_order_release);
+    flushThread.join();
+    drain();
+}
+
+bool Log::isRunning() {
+    return running.load(std::memory_order_acquire);
+}
+
+std::uint64_t Log::getDropped() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+Log::Record* Log::beginRecord(LogSite& site) {
+    const std::int64_t now = nowMicros();
+    if (!admit(site, now)) return nullptr;
+
+    Record* record = &directRecord;
+    producers.fetch_add(1);
+    if (running.load()) {
+        std::uint64_t position = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & (QUEUE_CAPACITY - 1)];
+            const std::int64_t diff = static_cast<std::int64_t>(slot.sequence.load(std::memory_order_acquire) - position);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    record = &slot.record;
+                    break;
+                }
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                producers.fetch_sub(1, std::memory_order_release);
+                return nullptr;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+        record->position = position;
+    } else {
+        producers.fetch_sub(1, std::memory_order_release);
+        record->position = ~std::uint64_t(0);
+    }
+    record->site = &site;
+    record->timeUs = now;
+    record->suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    record->argCount = 0;
+    record->textUsed = 0;
+    return record;
+}
+
+void Log::commitRecord(Record* record) {
+    if (record == &directRecord) {
+        writeRecord(*record);
+        std::fflush(streamFor(record->site->level));
+        return;
+    }
+    slots[record->position & (QUEUE_CAPACITY - 1)].sequence.store(record->position + 1, std::memory_order_release);
+    producers.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,121 @@
+#include "PerfHud.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+    constexpr float BUDGET_60_MS = 1000.f / 60.f;
+    constexpr float BUDGET_30_MS = 1000.f / 30.f;
+    const sf::Color BACKGROUND(0, 0, 0, 140);
+    const sf::Color GUIDE(255, 255, 255, 90);
+    const sf::Color FAST(90, 220, 90);      // within a 60 Hz frame
+    const sf::Color SLOW(230, 200, 60);     // within 30 Hz
+    const sf::Color HITCH(230, 70, 60);
+}
+
+void PerfHud::setFont(const sf::Font* font, unsigned int characterSize) {
+    m_font = font;
+    m_characterSize = characterSize;
+    // worst case, every character a quad, so a full buffer never has to grow it
+    m_textVertices.reserve(TEXT_CAPACITY * 6);
+    m_graphVertices.reserve((HISTORY + 3) * 6);
+}
+
+void PerfHud::addFrameTime(float milliseconds) {
+    m_frameTimes[m_nextFrame] = milliseconds;
+    m_nextFrame = (m_nextFrame + 1) % HISTORY;
+    m_frameCount = std::min(m_frameCount + 1, HISTORY);
+}
+
+void PerfHud::print(const char* format, ...) {
+    if (m_textLength + 1 >= TEXT_CAPACITY) return;
+    va_list args;
+    va_start(args, format);
+    const int written = std::vsnprintf(m_text + m_textLength, TEXT_CAPACITY - m_textLength, format, args);
+    va_end(args);
+    if (written > 0) m_textLength = std::min(m_textLength + static_cast<std::size_t>(written), TEXT_CAPACITY - 1);
+}
+
+void PerfHud::record(RenderQueue& queue, const sf::Vector2f& position, const sf::Vector2f& graphSize) {
+    if (!m_visible || !m_font) return;
+    recordText(queue, position);
+    recordGraph(queue, {position.x, position.y + m_textHeight + 6.f}, graphSize);
+}
+
+void PerfHud::addQuad(std::vector<sf::Vertex>& vertices, float left, float top, float width, float height, const sf::Color& color) {
+    const sf::Vector2f a(left, top), b(left + width, top), c(left + width, top + height), d(left, top + height);
+    vertices.emplace_back(a, color);
+    vertices.emplace_back(b, color);
+    vertices.emplace_back(c, color);
+    vertices.emplace_back(a, color);
+    vertices.emplace_back(c, color);
+    vertices.emplace_back(d, color);
+}
+
+void PerfHud::recordText(RenderQueue& queue, const sf::Vector2f& position) {
+    // same layout as sf::Text: first baseline one character size down, kerning between pairs, no styles
+    const float lineSpacing = m_font->getLineSpacing(m_characterSize);
+    float x = position.x;
+    float y = position.y + static_cast<float>(m_characterSize);
+    sf::Uint32 previous = 0;
+    m_textVertices.clear();
+    for (std::size_t i = 0; i < m_textLength; ++i) {
+        const sf::Uint32 character = static_cast<unsigned char>(m_text[i]);
+        if (character == '\n') {
+            x = position.x;
+            y += lineSpacing;
+            previous = 0;
+            continue;
+        }
+        x += m_font->getKerning(previous, character, m_characterSize);
+        previous = character;
+        const sf::Glyph& glyph = m_font->getGlyph(character, m_characterSize, false);
+        if (character != ' ' && glyph.textureRect.width > 0) {
+            const float left = x + glyph.bounds.left;
+            const float top = y + glyph.bounds.top;
+            const float right = left + glyph.bounds.width;
+            const float bottom = top + glyph.bounds.height;
+            const float u0 = static_cast<float>(glyph.textureRect.left);
+            const float v0 = static_cast<float>(glyph.textureRect.top);
+            const float u1 = u0 + static_cast<float>(glyph.textureRect.width);
+            const float v1 = v0 + static_cast<float>(glyph.textureRect.height);
+            m_textVertices.emplace_back(sf::Vector2f(left, top), sf::Color::White, sf::Vector2f(u0, v0));
+            m_textVertices.emplace_back(sf::Vector2f(right, top), sf::Color::White, sf::Vector2f(u1, v0));
+            m_textVertices.emplace_back(sf::Vector2f(right, bottom), sf::Color::White, sf::Vector2f(u1, v1));
+            m_textVertices.emplace_back(sf::Vector2f(left, top), sf::Color::White, sf::Vector2f(u0, v0));
+            m_textVertices.emplace_back(sf::Vector2f(right, bottom), sf::Color::White, sf::Vector2f(u1, v1));
+            m_textVertices.emplace_back(sf::Vector2f(left, bottom), sf::Color::White, sf::Vector2f(u0, v1));
+        }
+        x += glyph.advance;
+    }
+    m_textHeight = y + lineSpacing - static_cast<float>(m_characterSize) - position.y;
+
+    // after the glyph lookups, a new glyph can make the font grow its texture
+    sf::RenderStates states;
+    states.texture = &m_font->getTexture(m_characterSize);
+    queue.draw(m_textVertices.data(), m_textVertices.size(), sf::Triangles, states);
+}
+
+void PerfHud::recordGraph(RenderQueue& queue, const sf::Vector2f& position, const sf::Vector2f& size) {
+    // scaled so a 30 Hz frame is always on it, anything worse stretches the scale up to fit the worst frame
+    float scaleMs = BUDGET_30_MS * 1.5f;
+    for (std::size_t i = 0; i < m_frameCount; ++i) scaleMs = std::max(scaleMs, m_frameTimes[i]);
+    const float pixelsPerMs = size.y / scaleMs;
+    const float barWidth = size.x / static_cast<float>(HISTORY);
+    const float bottom = position.y + size.y;
+
+    m_graphVertices.clear();
+    addQuad(m_graphVertices, position.x, position.y, size.x, size.y, BACKGROUND);
+    // oldest on the left, the newest frame at the right edge
+    for (std::size_t i = 0; i < m_frameCount; ++i) {
+        const float ms = m_frameTimes[(m_nextFrame + HISTORY - m_frameCount + i) % HISTORY];
+        const float height = std::max(1.f, ms * pixelsPerMs);
+        const sf::Color& color = ms <= BUDGET_60_MS ? FAST : (ms <= BUDGET_30_MS ? SLOW : HITCH);
+        const float left = position.x + size.x - static_cast<float>(m_frameCount - i) * barWidth;
+        addQuad(m_graphVertices, left, bottom - height, std::max(1.f, barWidth - 1.f), height, color);
+    }
+    addQuad(m_graphVertices, position.x, bottom - BUDGET_60_MS * pixelsPerMs, size.x, 1.f, GUIDE);
+    addQuad(m_graphVertices, position.x, bottom - BUDGET_30_MS * pixelsPerMs, size.x, 1.f, GUIDE);
+    queue.draw(m_graphVertices.data(), m_graphVertices.size(), sf::Triangles);
+}
@@ -1,24 +1,13 @@
 #include "PlatformBody.hpp"
-#include "PhysicsTypes.hpp" 
+#include "PhysicsTypes.hpp"
 
 namespace phys {
 
-PlatformBody::PlatformBody(
-    unsigned int id,
-    const sf::Vector2f& position,
-    float width,
-    float height,
-    bodyType type,
-    bool initiallyFalling,
-    const sf::Vector2f& surfaceVelocity)
-    : m_id(id),
-      m_position(position),
-      m_velocity({0.f, 0.f}),
-      m_width(width),
-      m_height(height),
-      m_type(type),
-      m_falling(initiallyFalling),
-      m_surfaceVelocity(surfaceVelocity) {}
+PlatformBody::PlatformBody(const PlatformShape& shape)
+    : m_shape(&shape),
+      m_position(shape.position),
+      m_type(shape.type),
+      m_falling(shape.initiallyFalling) {}
 
 void PlatformBody::update(float deltaTime) {
     if (m_falling && m_type == bodyType::falling) { // Example for self-managed falling
@@ -27,7 +16,7 @@ void PlatformBody::update(float deltaTime) {
 }
 
 sf::FloatRect PlatformBody::getAABB() const {
-    return sf::FloatRect(m_position.x, m_position.y, m_width, m_height);
+    return sf::FloatRect(m_position.x, m_position.y, m_shape->width, m_shape->height);
 }
 
-} // namespace phys
\ No newline at end of file
+} // namespace phys
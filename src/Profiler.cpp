@@ -0,0 +1,156 @@
+#include "Profiler.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Fields are atomics only so the dump can read while the owner writes, relaxed stores are plain moves.
+    struct Event {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::uint64_t> start{0};
+        std::atomic<std::uint64_t> end{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    struct ThreadBuffer {
+        std::unique_ptr<Event[]> events{new Event[Profiler::EVENTS_PER_THREAD]};
+        std::atomic<std::uint64_t> written{0};
+        std::string name;   // under registryMutex
+        unsigned int id = 0;
+    };
+
+    // what the TSC read at startup, to convert ticks against steady_clock at dump time
+    struct Epoch {
+        std::uint64_t ticks;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    std::mutex& registryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::vector<std::unique_ptr<ThreadBuffer>>& registry() {
+        static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        return buffers;
+    }
+
+    // at static init, so it comes before any zone main can open
+    const Epoch processStart{Profiler::now(), std::chrono::steady_clock::now()};
+
+    const Epoch& epoch() {
+        return processStart;
+    }
+
+    ThreadBuffer& threadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            registry().push_back(std::make_unique<ThreadBuffer>());
+            buffer = registry().back().get();
+            buffer->id = static_cast<unsigned int>(registry().size());
+            buffer->name = "thread " + std::to_string(buffer->id);
+        }
+        return *buffer;
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+}
+
+bool Profiler::isCompiledIn() {
+#ifdef T3_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex());
+    buffer.name = name;
+}
+
+void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end, const AllocationTracker::Counts& allocated) {
+    ThreadBuffer& buffer = threadBuffer();
+    const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index & (EVENTS_PER_THREAD - 1)];
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    event.allocations.store(allocated.allocations, std::memory_order_relaxed);
+    event.bytes.store(allocated.bytes, std::memory_order_relaxed);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path, double seconds) {
+    const Epoch& origin = epoch();
+    const std::uint64_t nowTicks = now();
+    const double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin.time).count();
+    const double ticksPerUs = elapsedUs > 0.0 ? static_cast<double>(nowTicks - origin.ticks) / elapsedUs : 1.0;
+    const double windowTicks = seconds * 1000000.0 * ticksPerUs;
+    const std::uint64_t cutoff = static_cast<double>(nowTicks - origin.ticks) > windowTicks
+                                     ? nowTicks - static_cast<std::uint64_t>(windowTicks) : origin.ticks;
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        T3_LOG_ERROR("Profiler Error: Could not write {}", path);
+        return false;
+    }
+    // microseconds with ns digits, the default 6 significant digits turn a minute into 6.00000e+07
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    std::size_t written = 0;
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const auto& buffer : registry()) {
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+        writeJsonString(out, buffer->name);
+        out << "}}";
+
+        const std::uint64_t end = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const Event& event = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+            const char* name = event.name.load(std::memory_order_relaxed);
+            // zones opened in other static initializers start before the epoch
+            const std::uint64_t start = std::max(event.start.load(std::memory_order_relaxed), origin.ticks);
+            const std::uint64_t finish = event.end.load(std::memory_order_relaxed);
+            const std::uint64_t allocations = event.allocations.load(std::memory_order_relaxed);
+            const std::uint64_t bytes = event.bytes.load(std::memory_order_relaxed);
+            // the owner kept writing while we read, a slot it lapped since holds a newer zone half written
+            const std::uint64_t lapped = buffer->written.load(std::memory_order_acquire);
+            if (lapped > EVENTS_PER_THREAD && i < lapped - EVENTS_PER_THREAD) continue;
+            if (!name || finish < cutoff || finish < start) continue;
+            out << ",\n{\"name\":";
+            writeJsonString(out, name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"ts\":" << static_cast<double>(start - origin.ticks) / ticksPerUs
+                << ",\"dur\":" << static_cast<double>(finish - start) / ticksPerUs;
+            if (allocations > 0) out << ",\"args\":{\"allocations\":" << allocations << ",\"bytes\":" << bytes << "}";
+            out << "}";
+            ++written;
+        }
+    }
+    out << "\n]}\n";
+    T3_LOG_INFO("Profiler: {} zones from {} thread(s) written to {}", written, registry().size(), path);
+    return static_cast<bool>(out);
+}
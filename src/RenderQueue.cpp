@@ -0,0 +1,235 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr std::uint32_t NO_VIEW = 0xFFFFFFFF; // nothing set yet this frame, draw with whatever the target has
+
+    // FNV-1a, only has to be stable between runs, not strong
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    template <typename T>
+    void hashValue(std::uint64_t& hash, const T& value) {
+        hashBytes(hash, &value, sizeof(value));
+    }
+
+    bool isIdentity(const sf::Transform& transform) {
+        const float* matrix = transform.getMatrix();
+        const float* identity = sf::Transform::Identity.getMatrix();
+        return std::equal(matrix, matrix + 16, identity);
+    }
+}
+
+void RenderQueue::setView(const sf::View& view) {
+    m_views.push_back(view);
+    ++m_segment;
+}
+
+std::uint16_t RenderQueue::textureIndex(const sf::Texture* texture) {
+    if (m_textures.empty()) m_textures.push_back(nullptr);
+    if (!texture) return 0;
+    auto it = std::find(m_textures.begin(), m_textures.end(), texture);
+    if (it != m_textures.end()) return static_cast<std::uint16_t>(it - m_textures.begin());
+    m_textures.push_back(texture);
+    return static_cast<std::uint16_t>(m_textures.size() - 1);
+}
+
+std::uint16_t RenderQueue::blendIndex(const sf::BlendMode& blend) {
+    auto it = std::find(m_blends.begin(), m_blends.end(), blend);
+    if (it != m_blends.end()) return static_cast<std::uint16_t>(it - m_blends.begin());
+    m_blends.push_back(blend);
+    return static_cast<std::uint16_t>(m_blends.size() - 1);
+}
+
+bool RenderQueue::isBatchable(sf::PrimitiveType type) {
+    // strips and fans can't be glued together without degenerate tricks
+    return type == sf::Triangles || type == sf::Lines || type == sf::Points;
+}
+
+void RenderQueue::push(Command command) {
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.view = m_views.empty() ? NO_VIEW : static_cast<std::uint32_t>(m_views.size() - 1);
+    command.sortKey = (static_cast<std::uint64_t>(m_segment) << 32) |
+                      (static_cast<std::uint64_t>(m_layer) << 24) |
+                      (static_cast<std::uint64_t>(command.blend & 0xFF) << 16) |
+                      command.texture;
+    m_commands.push_back(command);
+}
+
+void RenderQueue::draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type, const sf::RenderStates& states) {
+    if (!vertices || count == 0) return;
+    const std::size_t first = m_vertices.size();
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+    if (!isIdentity(states.transform)) {
+        for (std::size_t i = first; i < m_vertices.size(); ++i) {
+            m_vertices[i].position = states.transform.transformPoint(m_vertices[i].position);
+        }
+    }
+    Command command{};
+    command.type = type;
+    command.firstVertex = static_cast<std::uint32_t>(first);
+    command.vertexCount = static_cast<std::uint32_t>(count);
+    command.texture = textureIndex(states.texture);
+    command.blend = blendIndex(states.blendMode);
+    push(command);
+}
+
+void RenderQueue::draw(const sf::VertexArray& vertices, const sf::RenderStates& states) {
+    if (vertices.getVertexCount() == 0) return;
+    draw(&vertices[0], vertices.getVertexCount(), vertices.getPrimitiveType(), states);
+}
+
+void RenderQueue::draw(const sf::Sprite& sprite, const sf::RenderStates& states) {
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const float width = static_cast<float>(std::abs(rect.width));
+    const float height = static_cast<float>(std::abs(rect.height));
+    const float u0 = static_cast<float>(rect.left);
+    const float v0 = static_cast<float>(rect.top);
+    const float u1 = static_cast<float>(rect.left + rect.width);
+    const float v1 = static_cast<float>(rect.top + rect.height);
+    const sf::Color color = sprite.getColor();
+
+    const sf::Vertex quad[6] = {
+        sf::Vertex({0.f, 0.f}, color, {u0, v0}),
+        sf::Vertex({width, 0.f}, color, {u1, v0}),
+        sf::Vertex({width, height}, color, {u1, v1}),
+        sf::Vertex({0.f, 0.f}, color, {u0, v0}),
+        sf::Vertex({width, height}, color, {u1, v1}),
+        sf::Vertex({0.f, height}, color, {u0, v1}),
+    };
+    sf::RenderStates spriteStates = states;
+    spriteStates.transform *= sprite.getTransform();
+    spriteStates.texture = sprite.getTexture();
+    draw(quad, 6, sf::Triangles, spriteStates);
+}
+
+void RenderQueue::drawOpaque(const sf::Drawable& drawable, const sf::RenderStates& states) {
+    ++m_segment;
+    Command command{};
+    command.type = sf::Triangles;
+    command.texture = textureIndex(nullptr);
+    command.blend = blendIndex(states.blendMode);
+    command.opaque = &drawable;
+    command.opaqueStates = states;
+    push(command);
+    ++m_segment;
+}
+
+void RenderQueue::submit(sf::RenderTarget* target) {
+    m_stats = FrameStats();
+    m_stats.commands = m_commands.size();
+    m_stats.hash = FNV_OFFSET;
+
+    // what the frame would have cost drawn in record order
+    const Command* previous = nullptr;
+    for (const Command& command : m_commands) {
+        if (command.opaque) {
+            previous = nullptr;
+            continue;
+        }
+        if (previous && command.texture != previous->texture) ++m_stats.unsortedStateChanges;
+        if (previous && command.blend != previous->blend) ++m_stats.unsortedStateChanges;
+        previous = &command;
+    }
+
+    std::sort(m_commands.begin(), m_commands.end(), [](const Command& a, const Command& b) {
+        return a.sortKey != b.sortKey ? a.sortKey < b.sortKey : a.sequence < b.sequence;
+    });
+
+    std::uint32_t currentView = NO_VIEW;
+    int currentTexture = -1;
+    int currentBlend = -1;
+    std::size_t i = 0;
+    while (i < m_commands.size()) {
+        const Command& head = m_commands[i];
+
+        if (head.view != currentView && head.view != NO_VIEW) {
+            currentView = head.view;
+            ++m_stats.viewChanges;
+            const sf::View& view = m_views[currentView];
+            hashValue(m_stats.hash, view.getCenter());
+            hashValue(m_stats.hash, view.getSize());
+            if (target) target->setView(view);
+        }
+
+        if (head.opaque) {
+            // the drawable sets its own states, the next draw starts from scratch like in the unsorted count
+            currentTexture = -1;
+            currentBlend = -1;
+            ++m_stats.drawCalls;
+            hashValue(m_stats.hash, head.sequence);
+            if (target) target->draw(*head.opaque, head.opaqueStates);
+            ++i;
+            continue;
+        }
+
+        // run of commands the sort put next to each other that can go out as one draw
+        std::size_t end = i + 1;
+        std::size_t runVertices = head.vertexCount;
+        if (isBatchable(head.type)) {
+            while (end < m_commands.size()) {
+                const Command& next = m_commands[end];
+                if (next.opaque || next.type != head.type || next.texture != head.texture ||
+                    next.blend != head.blend || next.view != head.view) break;
+                runVertices += next.vertexCount;
+                ++end;
+            }
+        }
+
+        const sf::Vertex* vertices = &m_vertices[head.firstVertex];
+        if (end - i > 1) {
+            m_merged.clear();
+            for (std::size_t k = i; k < end; ++k) {
+                const Command& part = m_commands[k];
+                m_merged.insert(m_merged.end(), m_vertices.begin() + part.firstVertex,
+                                m_vertices.begin() + part.firstVertex + part.vertexCount);
+            }
+            vertices = m_merged.data();
+        }
+
+        if (head.texture != currentTexture) {
+            if (currentTexture != -1) ++m_stats.textureChanges;
+            currentTexture = head.texture;
+        }
+        if (head.blend != currentBlend) {
+            if (currentBlend != -1) ++m_stats.blendChanges;
+            currentBlend = head.blend;
+        }
+        ++m_stats.drawCalls;
+        m_stats.vertices += runVertices;
+
+        const sf::Texture* texture = m_textures[head.texture];
+        hashValue(m_stats.hash, static_cast<int>(head.type));
+        hashValue(m_stats.hash, head.texture);
+        if (texture) hashValue(m_stats.hash, texture->getSize());
+        hashValue(m_stats.hash, head.blend);
+        hashBytes(m_stats.hash, vertices, runVertices * sizeof(sf::Vertex));
+
+        if (target) {
+            sf::RenderStates states(m_blends[head.blend], sf::Transform::Identity, texture, nullptr);
+            target->draw(vertices, runVertices, head.type, states);
+        }
+        i = end;
+    }
+
+    clear();
+}
+
+void RenderQueue::clear() {
+    m_commands.clear();
+    m_vertices.clear();
+    m_textures.clear();
+    m_blends.clear();
+    m_views.clear();
+    m_segment = 0;
+}
@@ -0,0 +1,200 @@
+#include "ScenarioBench.hpp"
+#include "LevelGenerator.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+    constexpr std::uint64_t STRESS_SEED = 48;
+    constexpr std::size_t STRESS_ROWS = 10;     // rows stay above the death line whatever the size
+    constexpr float STRESS_CELL_WIDTH = 128.f;
+    constexpr float STRESS_CELL_HEIGHT = 160.f;
+    constexpr float STRESS_TOP = 300.f;
+    const char* const CSV_COLUMNS = "scenario,platforms,ticks,restarts,mean_us,p50_us,p99_us,max_us";
+
+    const char* compilerName() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    const char* osName() {
+#if defined(_WIN32)
+        return "windows";
+#elif defined(__APPLE__)
+        return "macos";
+#elif defined(__linux__)
+        return "linux";
+#else
+        return "unknown";
+#endif
+    }
+
+    std::string cpuName() {
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.compare(0, 10, "model name") != 0) continue;
+            const std::size_t colon = line.find(':');
+            if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+        return "unknown";
+    }
+
+    std::string csvSafe(std::string value) {
+        std::replace(value.begin(), value.end(), ',', ' ');
+        return value;
+    }
+}
+
+const std::vector<ScenarioBench::Phase>& ScenarioBench::getScript() {
+    using K = sf::Keyboard;
+    static const std::vector<Phase> script = {
+        {"run",      phys::bodyType::solid,        false, 240, {K::D, K::Unknown},      K::Space, 45},
+        {"moving",   phys::bodyType::moving,       false, 180, {K::Unknown, K::Unknown}, K::Space, 50},
+        {"conveyor", phys::bodyType::conveyorBelt, false, 180, {K::Unknown, K::Unknown}, K::Unknown, 0},
+        {"portal",   phys::bodyType::portal,       true,   60, {K::Unknown, K::Unknown}, K::E, 30},
+        {"interact", phys::bodyType::interactible, false,  90, {K::A, K::Unknown},      K::E, 20},
+        {"sprint",   phys::bodyType::none,         false, 240, {K::D, K::LShift},       K::Up, 30},
+        {"drop",     phys::bodyType::platform,     false,  60, {K::S, K::Unknown},      K::Unknown, 0},
+        {"spring",   phys::bodyType::spring,       false, 120, {K::Unknown, K::Unknown}, K::Unknown, 0},
+    };
+    return script;
+}
+
+const std::vector<std::size_t>& ScenarioBench::getStressSizes() {
+    static const std::vector<std::size_t> sizes = {1000, 10000};
+    return sizes;
+}
+
+std::string ScenarioBench::makeStressLevelJson(std::size_t platformCount) {
+    LevelGenerator::Options options;
+    options.platformCount = platformCount;
+    options.seed = STRESS_SEED;
+    options.levelName = "stress " + std::to_string(platformCount);
+    options.rows = STRESS_ROWS;
+    options.cellWidth = STRESS_CELL_WIDTH;
+    options.cellHeight = STRESS_CELL_HEIGHT;
+    options.top = STRESS_TOP;
+    options.vanishingFields = platformCount / 1000;
+    return LevelGenerator(options).toJson();
+}
+
+ScenarioBench::ScenarioBench(std::uint64_t ticksPerScenario)
+    : m_ticksPerScenario(std::max<std::uint64_t>(1, ticksPerScenario)),
+      m_ticks(static_cast<std::size_t>(m_ticksPerScenario)) {}
+
+void ScenarioBench::begin(const std::string& scenario, std::size_t platforms) {
+    m_current = Result();
+    m_current.scenario = csvSafe(scenario);
+    m_current.platforms = platforms;
+    m_restarts = 0;
+    m_ticks.reset();
+}
+
+void ScenarioBench::end() {
+    const LatencyStats::Summary summary = m_ticks.summarize();
+    m_current.ticks = summary.count;
+    m_current.restarts = m_restarts;
+    m_current.meanUs = summary.mean * 1000.0;
+    m_current.p50Us = summary.p50 * 1000.0;
+    m_current.p99Us = summary.p99 * 1000.0;
+    m_current.maxUs = summary.max * 1000.0;
+    T3_LOG_INFO("Scenario {}: {} platforms, {} ticks, {} restarts, mean {} p50 {} p99 {} max {} us", m_current.scenario,
+                m_current.platforms, m_current.ticks, m_current.restarts, m_current.meanUs, m_current.p50Us,
+                m_current.p99Us, m_current.maxUs);
+    m_results.push_back(m_current);
+}
+
+bool ScenarioBench::writeCsv(const std::string& path, int tickRate) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        T3_LOG_ERROR("ScenarioBench Error: Could not write {}", path);
+        return false;
+    }
+    char date[32] = "unknown";
+    const std::time_t now = std::time(nullptr);
+    if (const std::tm* utc = std::gmtime(&now)) std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", utc);
+
+    out << "# t3scenario 1\n";
+    out << "# date: " << date << "\n";
+    out << "# os: " << osName() << "\n";
+    out << "# cpu: " << cpuName() << "\n";
+    out << "# threads: " << std::thread::hardware_concurrency() << "\n";
+    out << "# compiler: " << compilerName() << "\n";
+#ifdef NDEBUG
+    out << "# build: release\n";
+#else
+    out << "# build: debug\n";
+#endif
+    out << "# tick rate: " << tickRate << " Hz\n";
+    out << "# ticks per scenario: " << m_ticksPerScenario << "\n";
+    out << CSV_COLUMNS << "\n";
+    char line[256];
+    for (const Result& result : m_results) {
+        std::snprintf(line, sizeof(line), "%zu,%llu,%llu,%.3f,%.3f,%.3f,%.3f", result.platforms,
+                      static_cast<unsigned long long>(result.ticks), static_cast<unsigned long long>(result.restarts),
+                      result.meanUs, result.p50Us, result.p99Us, result.maxUs);
+        out << result.scenario << "," << line << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool ScenarioBench::readCsv(const std::string& path, std::vector<Result>& outResults) {
+    std::ifstream in(path);
+    if (!in) {
+        T3_LOG_ERROR("ScenarioBench Error: Could not open {}", path);
+        return false;
+    }
+    outResults.clear();
+    std::string line;
+    bool sawColumns = false;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        if (!sawColumns) {
+            if (line != CSV_COLUMNS) {
+                T3_LOG_ERROR("ScenarioBench Error: {} is not a scenario CSV", path);
+                return false;
+            }
+            sawColumns = true;
+            continue;
+        }
+        std::istringstream fields(line);
+        Result result;
+        char comma = 0;
+        if (!std::getline(fields, result.scenario, ',') ||
+            !(fields >> result.platforms >> comma >> result.ticks >> comma >> result.restarts >> comma >> result.meanUs >>
+              comma >> result.p50Us >> comma >> result.p99Us >> comma >> result.maxUs)) {
+            T3_LOG_ERROR("ScenarioBench Error: {} has a bad line after {} scenarios", path, outResults.size());
+            return false;
+        }
+        outResults.push_back(result);
+    }
+    return sawColumns;
+}
+
+std::size_t ScenarioBench::checkBaseline(const std::vector<Result>& baseline, double tolerance) const {
+    std::size_t regressions = 0;
+    for (const Result& result : m_results) {
+        auto before = std::find_if(baseline.begin(), baseline.end(), [&](const Result& old) { return old.scenario == result.scenario; });
+        if (before == baseline.end()) continue;
+        const double limit = before->p99Us * (1.0 + tolerance);
+        if (result.p99Us > limit) {
+            T3_LOG_ERROR("Scenario {}: p99 {} us, baseline {} us (limit {} us)", result.scenario, result.p99Us, before->p99Us, limit);
+            ++regressions;
+        }
+    }
+    return regressions;
+}
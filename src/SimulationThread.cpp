@@ -0,0 +1,108 @@
+#include "SimulationThread.hpp"
+#include "Profiler.hpp"
+
+#include "SFML/System/Sleep.hpp"
+#include "SFML/System/Time.hpp"
+
+#include <algorithm>
+#include <utility>
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start(StepFunction step) {
+    if (m_thread.joinable()) return;
+    m_step = std::move(step);
+    m_quit = false;
+    m_running = false;
+    m_thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    if (!m_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_quit = true;
+        m_running = false;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void SimulationThread::setRunning(bool running) {
+    if (running) {
+        if (m_running.load()) return;
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_running = true;
+        }
+        m_wake.notify_one();
+    } else {
+        m_running = false;
+        // the step checks m_running under this lock before it starts, so once we have it nothing is in flight
+        // and nothing new will start
+        std::lock_guard<std::mutex> wait(m_stepMutex);
+    }
+}
+
+void SimulationThread::setTickRate(int ticksPerSecond) {
+    m_tickUs = 1000000 / std::max(1, ticksPerSecond);
+}
+
+void SimulationThread::setMaxCatchUpSteps(int steps) {
+    m_maxCatchUpSteps = std::max(1, steps);
+}
+
+LatencyStats::Summary SimulationThread::takeJitter() {
+    std::lock_guard<std::mutex> lock(m_jitterMutex);
+    LatencyStats::Summary summary = m_jitter.summarize();
+    m_jitter.reset();
+    return summary;
+}
+
+void SimulationThread::run() {
+    T3_PROFILE_THREAD("simulation");
+    std::int64_t nextTick = 0;
+    std::int64_t tickUs = 0;
+    std::int64_t maxBacklog = 0;
+    bool wasRunning = false;
+    while (!m_quit.load()) {
+        if (!m_running.load()) {
+            std::unique_lock<std::mutex> lock(m_stateMutex);
+            m_wake.wait(lock, [this] { return m_running.load() || m_quit.load(); });
+            wasRunning = false;
+            continue;
+        }
+        if (!wasRunning) {
+            // (re)started: the first tick is due right away, the time spent paused doesn't count
+            nextTick = LatencyStats::nowMicros();
+            tickUs = m_tickUs.load();
+            maxBacklog = tickUs * m_maxCatchUpSteps.load();
+            wasRunning = true;
+        }
+
+        const std::int64_t wait = nextTick - LatencyStats::nowMicros();
+        if (wait > 0) sf::sleep(sf::microseconds(wait)); // sf::sleep raises the timer resolution on Windows
+
+        {
+            std::lock_guard<std::mutex> stepLock(m_stepMutex);
+            if (!m_running.load()) continue;
+            const std::int64_t startedAt = LatencyStats::nowMicros();
+            if (m_measureJitter.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(m_jitterMutex);
+                m_jitter.add(static_cast<double>(startedAt - nextTick) / 1000.0);
+            }
+            if (!m_step(nextTick)) m_running = false;
+            m_ticks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        nextTick += tickUs;
+        // fell further behind than the catch-up cap (breakpoint, stalled machine): drop the backlog
+        const std::int64_t behind = LatencyStats::nowMicros() - nextTick;
+        if (behind > maxBacklog) {
+            m_droppedUs.fetch_add(behind - maxBacklog, std::memory_order_relaxed);
+            nextTick += behind - maxBacklog;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::clear() {
+    m_cells.clear();
+    m_bounds.clear();
+    m_ranges.clear();
+    m_present.clear();
+    m_stamps.clear();
+    m_itemCount = 0;
+    m_queryStamp = 0;
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsFor(const sf::FloatRect& bounds) const {
+    CellRange range;
+    range.x0 = static_cast<int>(std::floor(bounds.left / m_cellSize));
+    range.y0 = static_cast<int>(std::floor(bounds.top / m_cellSize));
+    // ceil - 1 so a rect ending exactly on a cell border stays out of the next cell
+    range.x1 = std::max(range.x0, static_cast<int>(std::ceil((bounds.left + bounds.width) / m_cellSize)) - 1);
+    range.y1 = std::max(range.y0, static_cast<int>(std::ceil((bounds.top + bounds.height) / m_cellSize)) - 1);
+    return range;
+}
+
+void SpatialGrid::link(std::uint32_t id, const CellRange& range) {
+    for (int cy = range.y0; cy <= range.y1; ++cy) {
+        for (int cx = range.x0; cx <= range.x1; ++cx) {
+            m_cells[key(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::unlink(std::uint32_t id, const CellRange& range) {
+    for (int cy = range.y0; cy <= range.y1; ++cy) {
+        for (int cx = range.x0; cx <= range.x1; ++cx) {
+            auto cell = m_cells.find(key(cx, cy));
+            if (cell == m_cells.end()) continue;
+            std::vector<std::uint32_t>& ids = cell->second;
+            auto it = std::find(ids.begin(), ids.end(), id);
+            if (it != ids.end()) {
+                *it = ids.back();
+                ids.pop_back();
+            }
+            if (ids.empty()) m_cells.erase(cell);
+        }
+    }
+}
+
+void SpatialGrid::insert(std::uint32_t id, const sf::FloatRect& bounds) {
+    if (id >= m_present.size()) {
+        m_bounds.resize(id + 1);
+        m_ranges.resize(id + 1);
+        m_present.resize(id + 1, false);
+        m_stamps.resize(id + 1, 0);
+    }
+    if (m_present[id]) {
+        update(id, bounds);
+        return;
+    }
+    m_bounds[id] = bounds;
+    m_ranges[id] = cellsFor(bounds);
+    m_present[id] = true;
+    ++m_itemCount;
+    link(id, m_ranges[id]);
+}
+
+void SpatialGrid::remove(std::uint32_t id) {
+    if (id >= m_present.size() || !m_present[id]) return;
+    unlink(id, m_ranges[id]);
+    m_present[id] = false;
+    --m_itemCount;
+}
+
+void SpatialGrid::update(std::uint32_t id, const sf::FloatRect& bounds) {
+    if (id >= m_present.size() || !m_present[id]) {
+        insert(id, bounds);
+        return;
+    }
+    m_bounds[id] = bounds;
+    CellRange range = cellsFor(bounds);
+    if (range == m_ranges[id]) return;
+    unlink(id, m_ranges[id]);
+    m_ranges[id] = range;
+    link(id, range);
+}
@@ -0,0 +1,165 @@
+#include "TextureAtlas.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    constexpr unsigned int PADDING = 2;     // transparent gap between frames so filtering never picks up a neighbour
+    constexpr unsigned int WHITE_SIZE = 4;  // only the middle 2x2 is handed out
+}
+
+sf::Image TextureAtlas::scaleDown(const sf::Image& source, const sf::IntRect& area, unsigned int maxFrameSize) {
+    const unsigned int srcW = static_cast<unsigned int>(area.width);
+    const unsigned int srcH = static_cast<unsigned int>(area.height);
+    const float scale = std::min(1.f, static_cast<float>(maxFrameSize) / static_cast<float>(std::max(srcW, srcH)));
+    const unsigned int dstW = std::max(1u, static_cast<unsigned int>(srcW * scale + 0.5f));
+    const unsigned int dstH = std::max(1u, static_cast<unsigned int>(srcH * scale + 0.5f));
+
+    sf::Image result;
+    result.create(dstW, dstH, sf::Color::Transparent);
+    const sf::Uint8* pixels = source.getPixelsPtr();
+    const unsigned int stride = source.getSize().x * 4;
+
+    // box filter, colour weighted by alpha so transparent texels don't darken the edges
+    for (unsigned int y = 0; y < dstH; ++y) {
+        const unsigned int y0 = area.top + y * srcH / dstH;
+        const unsigned int y1 = std::max(y0 + 1, area.top + (y + 1) * srcH / dstH);
+        for (unsigned int x = 0; x < dstW; ++x) {
+            const unsigned int x0 = area.left + x * srcW / dstW;
+            const unsigned int x1 = std::max(x0 + 1, area.left + (x + 1) * srcW / dstW);
+            unsigned long r = 0, g = 0, b = 0, a = 0, count = 0;
+            for (unsigned int sy = y0; sy < y1; ++sy) {
+                const sf::Uint8* row = pixels + sy * stride;
+                for (unsigned int sx = x0; sx < x1; ++sx) {
+                    const sf::Uint8* p = row + sx * 4;
+                    r += p[0] * p[3];
+                    g += p[1] * p[3];
+                    b += p[2] * p[3];
+                    a += p[3];
+                    ++count;
+                }
+            }
+            if (a == 0) continue;
+            result.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(r / a), static_cast<sf::Uint8>(g / a),
+                                            static_cast<sf::Uint8>(b / a), static_cast<sf::Uint8>(a / count)));
+        }
+    }
+    return result;
+}
+
+void TextureAtlas::addSheet(const std::string& name, const sf::Image& sheet, unsigned int columns, unsigned int rows,
+                            const std::vector<sf::Vector2u>& cells, unsigned int maxFrameSize) {
+    const sf::Vector2u size = sheet.getSize();
+    if (columns == 0 || rows == 0 || size.x < columns || size.y < rows) {
+        T3_LOG_ERROR("TextureAtlas Error: {} can't be cut into {}x{} frames", name, columns, rows);
+        return;
+    }
+    const unsigned int cellW = size.x / columns;
+    const unsigned int cellH = size.y / rows;
+
+    std::vector<sf::Vector2u> order = cells;
+    if (order.empty()) {
+        for (unsigned int row = 0; row < rows; ++row)
+            for (unsigned int column = 0; column < columns; ++column) order.push_back({column, row});
+    }
+    for (const sf::Vector2u& cell : order) {
+        if (cell.x >= columns || cell.y >= rows) {
+            T3_LOG_ERROR("TextureAtlas Error: {} has no cell {},{}", name, cell.x, cell.y);
+            continue;
+        }
+        sf::IntRect area(static_cast<int>(cell.x * cellW), static_cast<int>(cell.y * cellH), static_cast<int>(cellW), static_cast<int>(cellH));
+        m_pending.push_back({name, scaleDown(sheet, area, maxFrameSize)});
+    }
+}
+
+void TextureAtlas::addFrames(const std::string& name, const std::vector<const sf::Image*>& frames, unsigned int maxFrameSize) {
+    for (const sf::Image* frame : frames) {
+        if (!frame || frame->getSize().x == 0 || frame->getSize().y == 0) {
+            T3_LOG_ERROR("TextureAtlas Error: {} has an empty frame", name);
+            continue;
+        }
+        sf::IntRect area(0, 0, static_cast<int>(frame->getSize().x), static_cast<int>(frame->getSize().y));
+        m_pending.push_back({name, scaleDown(*frame, area, maxFrameSize)});
+    }
+}
+
+bool TextureAtlas::build() {
+    PendingFrame white;
+    white.image.create(WHITE_SIZE, WHITE_SIZE, sf::Color::White);
+    m_pending.push_back(std::move(white));
+
+    // shelf packing, tallest first, widening the atlas until the shelves fit in a square
+    std::vector<std::size_t> order(m_pending.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return m_pending[a].image.getSize().y > m_pending[b].image.getSize().y;
+    });
+
+    const unsigned int maxSize = sf::Texture::getMaximumSize();
+    if (m_pending.size() > 0xFFFF) {
+        T3_LOG_ERROR("TextureAtlas Error: too many frames ({})", m_pending.size());
+        m_pending.clear();
+        return false;
+    }
+    std::vector<sf::Vector2u> positions(m_pending.size());
+    unsigned int atlasSize = 128;
+    unsigned int usedHeight = 0;
+    for (;;) {
+        unsigned int x = 0, y = 0, shelfHeight = 0;
+        bool fits = true;
+        for (std::size_t i : order) {
+            const sf::Vector2u size = m_pending[i].image.getSize();
+            if (size.x + PADDING > atlasSize) { fits = false; break; }
+            if (x + size.x + PADDING > atlasSize) {
+                y += shelfHeight;
+                x = 0;
+                shelfHeight = 0;
+            }
+            positions[i] = {x, y};
+            x += size.x + PADDING;
+            shelfHeight = std::max(shelfHeight, size.y + PADDING);
+        }
+        usedHeight = y + shelfHeight;
+        if (fits && usedHeight <= atlasSize) break;
+        if (atlasSize >= maxSize) {
+            T3_LOG_ERROR("TextureAtlas Error: sprites don't fit in a {}px texture", maxSize);
+            m_pending.clear();
+            return false;
+        }
+        atlasSize *= 2;
+    }
+
+    sf::Image atlas;
+    atlas.create(atlasSize, usedHeight, sf::Color::Transparent);
+    m_animations.clear();
+    m_frames.assign(1, sf::IntRect()); // id 0, the white block, filled in below
+    for (std::size_t i = 0; i < m_pending.size(); ++i) {
+        const PendingFrame& frame = m_pending[i];
+        atlas.copy(frame.image, positions[i].x, positions[i].y);
+        const sf::IntRect rect(static_cast<int>(positions[i].x), static_cast<int>(positions[i].y),
+                               static_cast<int>(frame.image.getSize().x), static_cast<int>(frame.image.getSize().y));
+        if (i + 1 == m_pending.size()) {
+            m_frames.front() = sf::IntRect(rect.left + 1, rect.top + 1, WHITE_SIZE - 2, WHITE_SIZE - 2);
+        } else {
+            Animation& animation = m_animations[frame.name];
+            animation.frames.push_back(rect);
+            animation.ids.push_back(static_cast<sf::Uint16>(m_frames.size()));
+            m_frames.push_back(rect);
+        }
+    }
+    const std::size_t frameCount = m_pending.size() - 1;
+    m_pending.clear();
+
+    if (!m_texture.loadFromImage(atlas)) {
+        T3_LOG_ERROR("TextureAtlas Error: Could not create the atlas texture");
+        return false;
+    }
+    T3_LOG_INFO("TextureAtlas: {} frames in {} animations, {}x{}", frameCount, m_animations.size(), atlasSize, usedHeight);
+    return true;
+}
+
+const TextureAtlas::Animation* TextureAtlas::find(const std::string& name) const {
+    auto it = m_animations.find(name);
+    return it != m_animations.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,232 @@
+#include "TileBatchRenderer.hpp"
+#include "Interpolation.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace {
+    constexpr std::size_t VERTICES_PER_TILE = 6;
+
+    // The chunks hold colour already multiplied by alpha (that is what alpha blending onto a transparent
+    // target leaves behind), so blitting them must not multiply again.
+    const sf::BlendMode BLEND_PREMULTIPLIED(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+}
+
+void TileBatchRenderer::clear() {
+    m_vertices.clear();
+    m_chunks.clear();
+    m_tileGrid.clear();
+    m_chunkGrid.clear();
+    m_visibleTiles.clear();
+    m_visibleChunks.clear();
+    m_tileCount = 0;
+    m_dynamicCount = 0;
+    m_stats = CullStats();
+}
+
+void TileBatchRenderer::setTexture(const sf::Texture* texture, const std::vector<sf::IntRect>& frames) {
+    m_texture = texture;
+    m_frames = frames;
+}
+
+void TileBatchRenderer::setInterpolation(const std::vector<sf::Vector2f>* previousPositions, float alpha) {
+    m_previousPositions = previousPositions;
+    m_alpha = alpha;
+}
+
+void TileBatchRenderer::rebuild(const std::vector<Tile>& tiles, const MotionBounds& motionBounds) {
+    clear();
+    m_tileCount = tiles.size();
+
+    std::vector<sf::FloatRect> reach(tiles.size());
+    std::vector<std::size_t> staticTiles;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        if (motionBounds) reach[i] = motionBounds(i);
+        if (reach[i].width > 0.f || reach[i].height > 0.f) ++m_dynamicCount;
+        else staticTiles.push_back(i);
+    }
+
+    bool cacheStatic = m_staticCaching && !staticTiles.empty();
+    if (cacheStatic && !rasterizeStatic(tiles, staticTiles)) {
+        T3_LOG_ERROR("TileBatchRenderer Error: Could not create static tile chunks, drawing them as vertices");
+        m_chunks.clear();
+        m_chunkGrid.clear();
+        m_staticCaching = false;
+        cacheStatic = false;
+    }
+
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const bool isStatic = reach[i].width <= 0.f && reach[i].height <= 0.f;
+        if (isStatic && cacheStatic) continue;
+        const sf::FloatRect bounds = isStatic ? tiles[i].getGlobalBounds() : reach[i];
+        if (isStatic && (bounds.width <= 0.f || bounds.height <= 0.f)) continue; // fallen, never comes back
+        m_tileGrid.insert(static_cast<std::uint32_t>(i), bounds);
+    }
+    m_stats.tiles = m_tileGrid.size();
+    m_stats.chunks = m_chunks.size();
+    // cull() refills these every frame, sized for the worst case here so panning around never grows them
+    m_visibleTiles.reserve(m_tileGrid.size());
+    m_visibleChunks.reserve(m_chunks.size());
+    m_vertices.resize(m_tileGrid.size() * VERTICES_PER_TILE); // VertexArray has no reserve(), shrinking keeps the capacity
+    m_vertices.clear();
+}
+
+void TileBatchRenderer::cull(const std::vector<Tile>& tiles, const sf::View& view) {
+    const sf::Vector2f size = view.getSize() + sf::Vector2f(2.f * m_cullMargin, 2.f * m_cullMargin);
+    const sf::FloatRect area(view.getCenter() - size / 2.f, size);
+
+    m_visibleChunks.clear();
+    m_chunkGrid.query(area, [this](std::uint32_t chunk) { m_visibleChunks.push_back(chunk); });
+
+    m_visibleTiles.clear();
+    std::size_t visited = 0;
+    m_tileGrid.query(area, [&](std::uint32_t i) {
+        ++visited;
+        if (i >= tiles.size()) return;
+        const Tile& tile = tiles[i];
+        if (!tile.isVisible()) return;
+        if (!tile.getGlobalBounds().intersects(area)) return;
+        m_visibleTiles.push_back(i);
+    });
+    // the grid hands them back in cell order, keep the tile order so overlaps don't flicker
+    std::sort(m_visibleTiles.begin(), m_visibleTiles.end());
+
+    m_vertices.resize(m_visibleTiles.size() * VERTICES_PER_TILE);
+    const bool blend = m_previousPositions && m_previousPositions->size() == tiles.size();
+    for (std::size_t n = 0; n < m_visibleTiles.size(); ++n) {
+        const std::size_t i = m_visibleTiles[n];
+        const sf::Vector2f position = blend ? interp::blend((*m_previousPositions)[i], tiles[i].position, m_alpha) : tiles[i].position;
+        writeQuad(tiles[i], position, m_vertices, n * VERTICES_PER_TILE);
+    }
+
+    m_stats.visited = visited;
+    m_stats.drawn = m_visibleTiles.size();
+    m_stats.culled = m_stats.tiles - m_stats.drawn;
+    m_stats.visibleChunks = m_visibleChunks.size();
+}
+
+std::size_t TileBatchRenderer::getDrawCallCount() const {
+    return (m_vertices.getVertexCount() > 0 ? 1 : 0) + m_visibleChunks.size();
+}
+
+bool TileBatchRenderer::rasterizeStatic(const std::vector<Tile>& tiles, const std::vector<std::size_t>& staticTiles) {
+    const float chunkSize = static_cast<float>(CHUNK_SIZE);
+
+    // which tiles touch which chunk, a tile on a border goes into every chunk it overlaps
+    std::map<std::pair<int, int>, std::vector<std::size_t>> chunkTiles;
+    for (std::size_t i : staticTiles) {
+        const Tile& tile = tiles[i];
+        if (!tile.isVisible()) continue;
+        const sf::FloatRect bounds = tile.getGlobalBounds();
+        if (bounds.width <= 0.f || bounds.height <= 0.f) continue;
+        const int x0 = static_cast<int>(std::floor(bounds.left / chunkSize));
+        const int y0 = static_cast<int>(std::floor(bounds.top / chunkSize));
+        // ceil - 1 so a tile ending exactly on a chunk border doesn't drag in the next chunk
+        const int x1 = static_cast<int>(std::ceil((bounds.left + bounds.width) / chunkSize)) - 1;
+        const int y1 = static_cast<int>(std::ceil((bounds.top + bounds.height) / chunkSize)) - 1;
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                chunkTiles[{cx, cy}].push_back(i);
+            }
+        }
+    }
+
+    m_chunks.reserve(chunkTiles.size());
+    sf::VertexArray vertices(sf::Triangles);
+    for (const auto& entry : chunkTiles) {
+        StaticChunk chunk;
+        chunk.bounds = sf::FloatRect(entry.first.first * chunkSize, entry.first.second * chunkSize, chunkSize, chunkSize);
+        chunk.texture = std::make_unique<sf::RenderTexture>();
+        if (!chunk.texture->create(CHUNK_SIZE, CHUNK_SIZE)) {
+            return false;
+        }
+        chunk.texture->setView(sf::View(chunk.bounds));
+        chunk.texture->clear(sf::Color::Transparent);
+
+        vertices.resize(entry.second.size() * VERTICES_PER_TILE);
+        for (std::size_t n = 0; n < entry.second.size(); ++n) {
+            const Tile& tile = tiles[entry.second[n]];
+            writeQuad(tile, tile.position, vertices, n * VERTICES_PER_TILE);
+        }
+        chunk.texture->draw(vertices, sf::RenderStates(m_texture));
+        chunk.texture->display();
+        m_chunkGrid.insert(static_cast<std::uint32_t>(m_chunks.size()), chunk.bounds);
+        m_chunks.push_back(std::move(chunk));
+    }
+    return true;
+}
+
+void TileBatchRenderer::writeQuad(const Tile& tile, const sf::Vector2f& position, sf::VertexArray& vertices, std::size_t firstVertex) const {
+    const sf::Color color = tile.getFillColor();
+    const sf::Vector2f topLeft = position;
+    sf::Vector2f topRight(position.x + tile.size.x, position.y);
+    sf::Vector2f bottomRight = position + tile.size;
+    sf::Vector2f bottomLeft(position.x, position.y + tile.size.y);
+    if (!tile.isVisible()) {
+        topRight = bottomRight = bottomLeft = topLeft;
+    }
+
+    const sf::IntRect rect = m_texture && tile.frame < m_frames.size() ? m_frames[tile.frame] : sf::IntRect();
+    const float u0 = static_cast<float>(rect.left);
+    const float v0 = static_cast<float>(rect.top);
+    const float u1 = static_cast<float>(rect.left + rect.width);
+    const float v1 = static_cast<float>(rect.top + rect.height);
+
+    sf::Vertex* quad = &vertices[firstVertex];
+    quad[0] = sf::Vertex(topLeft, color, {u0, v0});
+    quad[1] = sf::Vertex(topRight, color, {u1, v0});
+    quad[2] = sf::Vertex(bottomRight, color, {u1, v1});
+    quad[3] = sf::Vertex(topLeft, color, {u0, v0});
+    quad[4] = sf::Vertex(bottomRight, color, {u1, v1});
+    quad[5] = sf::Vertex(bottomLeft, color, {u0, v1});
+}
+
+void TileBatchRenderer::record(RenderQueue& queue) const {
+    const float size = static_cast<float>(CHUNK_SIZE);
+    sf::Vertex quad[6];
+    for (std::size_t index : m_visibleChunks) {
+        const StaticChunk& chunk = m_chunks[index];
+        const float left = chunk.bounds.left;
+        const float top = chunk.bounds.top;
+        quad[0] = sf::Vertex({left, top}, {0.f, 0.f});
+        quad[1] = sf::Vertex({left + size, top}, {size, 0.f});
+        quad[2] = sf::Vertex({left + size, top + size}, {size, size});
+        quad[3] = quad[0];
+        quad[4] = quad[2];
+        quad[5] = sf::Vertex({left, top + size}, {0.f, size});
+        queue.draw(quad, 6, sf::Triangles, sf::RenderStates(BLEND_PREMULTIPLIED, sf::Transform::Identity, &chunk.texture->getTexture(), nullptr));
+    }
+
+    const std::uint8_t layer = queue.getLayer();
+    queue.setLayer(static_cast<std::uint8_t>(layer + 1));
+    queue.draw(m_vertices, sf::RenderStates(m_texture));
+    queue.setLayer(layer);
+}
+
+void TileBatchRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    sf::RenderStates chunkStates = states;
+    chunkStates.blendMode = BLEND_PREMULTIPLIED;
+    sf::Vertex quad[6];
+    const float size = static_cast<float>(CHUNK_SIZE);
+    for (std::size_t index : m_visibleChunks) {
+        const StaticChunk& chunk = m_chunks[index];
+        const float left = chunk.bounds.left;
+        const float top = chunk.bounds.top;
+        quad[0] = sf::Vertex({left, top}, {0.f, 0.f});
+        quad[1] = sf::Vertex({left + size, top}, {size, 0.f});
+        quad[2] = sf::Vertex({left + size, top + size}, {size, size});
+        quad[3] = quad[0];
+        quad[4] = quad[2];
+        quad[5] = sf::Vertex({left, top + size}, {0.f, size});
+        chunkStates.texture = &chunk.texture->getTexture();
+        target.draw(quad, 6, sf::Triangles, chunkStates);
+    }
+
+    if (m_vertices.getVertexCount() > 0) {
+        states.texture = m_texture;
+        target.draw(m_vertices, states);
+    }
+}
@@ -1,7 +1,6 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <SFML/Window/Event.hpp>
-#include <iostream>
 #include <vector>
 #include <cmath>
 #include <string>
@@ -11,13 +10,38 @@
 #include <limits>
 #include <filesystem>
 #include <map>
+#include <memory_resource>
+#include <bitset>
+#include <cstdint>
+#include <chrono>
 #include "CollisionSystem.hpp"
 #include "Player.hpp"
 #include "PlatformBody.hpp"
 #include "Tile.hpp"
 #include "PhysicsTypes.hpp"
 #include "LevelManager.hpp"
-#include "Optimizer.hpp"
+#include "LevelOverlay.hpp"
+#include "LevelStreamer.hpp"
+#include "AssetPack.hpp"
+#include "AssetManager.hpp"
+#include "TileBatchRenderer.hpp"
+#include "TextureAtlas.hpp"
+#include "Animator.hpp"
+#include "RenderQueue.hpp"
+#include "Interpolation.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+#include "SimulationThread.hpp"
+#include "LatencyStats.hpp"
+#include "GoldenTrace.hpp"
+#include "InputLog.hpp"
+#include "FramePacer.hpp"
+#include "Profiler.hpp"
+#include "PerfHud.hpp"
+#include "AllocationTracker.hpp"
+#include "Log.hpp"
+#include "ScenarioBench.hpp"
+#include "Easing.hpp"
 
 enum class GameState {
     MENU,
@@ -34,6 +58,28 @@ enum class GameState {
 struct GameSettings {
     float musicVolume = 50.f;
     float sfxVolume = 70.f;
+    int tickRate = 60;         // simulation steps per second, 60/120/240. Higher costs CPU, cuts input latency
+    int maxStepsPerFrame = 8;  // catch-up cap after a stall, the rest of the backlog is dropped
+    bool simulationThread = true; // fixed steps on their own thread instead of between frames
+    bool measureLatency = false;  // print input->display latency and tick jitter every few seconds
+    int framePacing = 0;          // into FRAME_PACING_OPTIONS
+    bool perfHud = true;          // overlay with the frame time graph and counters, F3 toggles it
+    bool allocationCheck = false; // quit with an error when a steady PLAYING frame allocates (T3_ALLOC_TRACKING builds)
+};
+
+const int TICK_RATES[] = {60, 120, 240};
+
+struct FramePacingOption {
+    FramePacer::Mode mode;
+    int fps; // Limited only
+};
+const FramePacingOption FRAME_PACING_OPTIONS[] = {
+    {FramePacer::Mode::VSync, 0},
+    {FramePacer::Mode::Uncapped, 0},
+    {FramePacer::Mode::Limited, 60},
+    {FramePacer::Mode::Limited, 120},
+    {FramePacer::Mode::Limited, 144},
+    {FramePacer::Mode::Limited, 240},
 };
 
 // --- Global Variables for Window/Resolution Management ---
@@ -46,49 +92,111 @@ sf::Text resolutionCurrentText;
 void updateResolutionDisplayText();
 
 // --- Global Game Objects ---
+AssetPack assetPack; // first, so everything reading out of it is destroyed before it unmaps
+AssetManager assetManager;
 LevelManager levelManager;
-LevelData currentLevelData;
+LevelTemplatePtr currentLevel;
+LevelOverlay world;
+LevelStreamer levelStreamer(levelManager);
 phys::DynamicBody playerBody;
-std::vector<phys::PlatformBody> bodies;
-std::vector<Tile> tiles;
-
-struct ActiveMovingPlatform {
-    unsigned int id;
-    sf::Vector2f movementAnchorPosition;
-    char axis;
-    float distance;
-    float cycleTime;
-    float cycleDuration;
-    int initialDirection;
-    sf::Vector2f lastFrameActualPosition;
+// tiles and the other per-run vectors below live in world's arena, see releaseRunStorage()
+std::pmr::vector<Tile> tiles(world.getResource());
+TileBatchRenderer tileRenderer;
+RenderQueue renderQueue;
+FramePacer framePacer;
+// Where the tiles/player were before the last simulation step, published with every SimFrame so rendering can
+// blend from there (Interpolation.hpp)
+std::pmr::vector<sf::Vector2f> previousTilePositions(world.getResource());
+sf::Vector2f previousPlayerPosition;
+TextureAtlas spriteAtlas;
+bool spriteAtlasReady = false;
+
+// Tiles that play an atlas animation (traps, goal doors), by index into tiles
+struct TileAnimation {
+    std::size_t tileIndex;
+    Animator animator;
+    bool playOnApproach; // one shot that waits for the player to come close (the door)
 };
-std::vector<ActiveMovingPlatform> activeMovingPlatforms;
-
-struct ActiveInteractiblePlatform {
-    unsigned int id;
-    std::string interactionType;
-    phys::bodyType targetBodyTypeEnum;
-    sf::Color targetTileColor;
-    bool hasTargetTileColor;
-    bool oneTime;
-    float cooldown;
-    bool hasBeenInteractedThisSession;
-    float currentCooldownTimer;
-    unsigned int linkedID = 0;
+std::pmr::vector<TileAnimation> tileAnimations(world.getResource());
+
+// --- Simulation handoff ---
+// The fixed step only talks to the rest of the game through these: keys come in through inputQueue, sounds and
+// the end of a run go out through simEvents, and every step publishes a SimFrame into simFrames that the
+// renderer draws from. Same path whether the steps run inline in the main loop or on simThread.
+struct InputEvent {
+    std::int64_t timeUs;   // LatencyStats::nowMicros() when it was polled
+    sf::Keyboard::Key key; // Unknown + released = let go of everything (focus lost)
+    bool pressed;
 };
-std::map<unsigned int, ActiveInteractiblePlatform> activeInteractibles;
 
-sf::Time vanishingPlatformCycleTimer = sf::Time::Zero;
-int oddEvenVanishing = 1;
+enum class SimOutcome { None, HitTrap, FellOut, ReachedGoal };
+
+struct SimEvent {
+    const char* sfx;       // name in soundBuffers, or nullptr
+    SimOutcome outcome;
+};
+
+// What rendering needs from one step. Slots get reused, so the static tiles are only copied into one when the
+// layout changed since it was last written (layoutGeneration), otherwise a publish only refreshes dynamic tiles.
+struct SimFrame {
+    std::uint64_t tick = 0;
+    std::int64_t publishedUs = 0;
+    std::int64_t lastInputUs = 0;  // newest input the simulation had seen
+    std::uint32_t layoutGeneration = 0;
+    std::vector<Tile> tiles;
+    std::vector<sf::Vector2f> previousTilePositions;
+    std::vector<sf::FloatRect> motionBounds; // for TileBatchRenderer::rebuild, see rebuildTileBatch()
+    sf::Vector2f playerPosition, previousPlayerPosition, playerVelocity, playerSize;
+    bool playerOnGround = false;
+    // debug HUD
+    sf::Vector2i chunk;
+    std::size_t residentChunks = 0, pendingChunks = 0;
+    bool hasGround = false, groundValid = false;
+    unsigned int groundID = 0, groundPortalID = 0;
+    phys::bodyType groundType = phys::bodyType::none;
+    std::size_t collisionChecked = 0, collisionCandidates = 0; // last step's resolveCollisions
+    AllocationTracker::Counts simAllocations;                  // stepping thread's, since it started
+    std::size_t arenaUsed = 0, arenaCapacity = 0;             // world's LevelArena
+};
+
+SpscQueue<InputEvent, 256> inputQueue;
+SpscQueue<SimEvent, 64> simEvents;
+TripleBuffer<SimFrame> simFrames;
+SimulationThread simThread;
+
+// simulation side only
+std::bitset<sf::Keyboard::KeyCount> heldKeys;
+std::bitset<sf::Keyboard::KeyCount> pressedKeys; // went down during this tick, even if already up again
+std::int64_t lastInputUs = 0;
+std::uint64_t simTick = 0;                       // since the level was set up
+int jumpBufferTicksLeft = 0;                     // a jump pressed in the air still happens on landing
+int coyoteTicksLeft = 0;                         // ground left without jumping still counts for a bit
+InputLog inputLog;                               // this run when recording, the run to replay otherwise
+std::string inputRecordPath;                     // T3_RECORD_INPUT
+bool replayingInput = false;                     // T3_REPLAY_INPUT
+std::size_t replayCursor = 0;
+std::string scenarioBenchPath;                   // T3_SCENARIO_BENCH, runs the scenario benchmark instead of the game
+std::string scenarioBaselinePath;                // T3_SCENARIO_BASELINE
+std::uint64_t scenarioTicks = 100000;            // T3_SCENARIO_TICKS, per scenario
+double scenarioTolerance = 0.1;                  // T3_SCENARIO_TOLERANCE / 100, how far over the baseline's p99 still passes
+std::string goldenDir;                           // T3_GOLDEN, checks the replays in there against their traces instead of the game
+bool goldenUpdate = false;                       // T3_GOLDEN_UPDATE, writes the traces instead of checking them
+GoldenTrace::Tolerance goldenTolerance;          // T3_GOLDEN_TOLERANCE
+std::uint32_t tileLayoutGeneration = 0;
+std::pmr::vector<sf::FloatRect> tileMotionBounds(world.getResource());
+std::pmr::vector<std::size_t> dynamicTiles(world.getResource());
+std::pmr::vector<unsigned int> linkedTileIDs(world.getResource()); // rebuildTileBatch() scratch, sorted
+phys::CollisionResolutionInfo lastCollision;
 
 GameSettings gameSettings;
 
 sf::Music menuMusic;
 sf::Music gameMusic;
-std::map<std::string, sf::SoundBuffer> soundBuffers;
+std::map<std::string, SoundBufferHandle, std::less<>> soundBuffers; // std::less<>: looked up by const char*, no temporary string
 sf::Sound sfxPlayer;
 
 // --- Asset Paths ---
+const std::string ASSET_PACK_PATH = "../assets.t3pak";
 const std::string FONT_PATH = "../assets/fonts/ARIALBD.TTF";
 const std::string IMG_MENU_BG = "../assets/images/mainmenu_bg.png";
 const std::string IMG_LOAD_GENERAL = "../assets/images/loading.png";
@@ -102,6 +210,92 @@ const std::string SFX_GOAL = "../assets/audio/sfx_goal.wav";
 const std::string SFX_CLICK = "../assets/audio/sfx_click.wav";
 const std::string SFX_SPRING = "../assets/audio/sfx_spring.wav";
 const std::string SFX_PORTAL = "../assets/audio/sfx_portal.wav";
+const std::string SPRITE_DIR = "../assets/sprites/";
+
+// T3_TICK_RATE / T3_MAX_STEPS override the defaults, mostly for benchmarking the tick rates against each other.
+// T3_SIM_THREAD=0 steps between frames on the main thread again, T3_LATENCY=1 turns the latency report on.
+// T3_FRAME_PACING=vsync|uncapped|<fps> picks the frame pacing, T3_PERF_HUD=0 starts with the overlay hidden.
+// T3_ALLOC_CHECK=1 makes any heap allocation in steady play fatal (exit code 1), pair it with T3_REPLAY_INPUT in CI.
+// T3_RECORD_INPUT=<file> saves the input of the last run played, T3_REPLAY_INPUT=<file> plays one back in
+// place of the keyboard (start the same level).
+// T3_SCENARIO_BENCH=<csv> runs the headless scenario benchmark (see ScenarioBench.hpp) and exits, T3_SCENARIO_TICKS
+// steps per level. T3_SCENARIO_BASELINE=<csv> fails it (exit code 1) when a p99 got more than T3_SCENARIO_TOLERANCE
+// percent (default 10) worse.
+// T3_GOLDEN=<dir> replays <dir>/levelN.t3in on every level, headless, and checks the player against
+// <dir>/levelN.t3trace (see GoldenTrace.hpp), exit code 1 on the first divergent tick. T3_GOLDEN_UPDATE=1 writes
+// the traces instead, T3_GOLDEN_TOLERANCE is how far off (pixels, pixels/s) still matches.
+void applyEnvironmentSettings() {
+    if (const char* env = std::getenv("T3_TICK_RATE")) {
+        const int rate = std::atoi(env);
+        if (std::find(std::begin(TICK_RATES), std::end(TICK_RATES), rate) != std::end(TICK_RATES)) gameSettings.tickRate = rate;
+        else T3_LOG_WARNING("Ignoring T3_TICK_RATE={}, expected 60, 120 or 240", env);
+    }
+    if (const char* env = std::getenv("T3_MAX_STEPS")) {
+        const int steps = std::atoi(env);
+        if (steps > 0) gameSettings.maxStepsPerFrame = steps;
+    }
+    if (const char* env = std::getenv("T3_SIM_THREAD")) gameSettings.simulationThread = std::atoi(env) != 0;
+    if (const char* env = std::getenv("T3_LATENCY")) gameSettings.measureLatency = std::atoi(env) != 0;
+    if (const char* env = std::getenv("T3_PERF_HUD")) gameSettings.perfHud = std::atoi(env) != 0;
+    if (const char* env = std::getenv("T3_ALLOC_CHECK")) gameSettings.allocationCheck = std::atoi(env) != 0;
+    if (gameSettings.allocationCheck && !AllocationTracker::isEnabled()) {
+        T3_LOG_WARNING("Ignoring T3_ALLOC_CHECK, this build doesn't count allocations (configure with -DT3_ALLOC_TRACKING=ON)");
+        gameSettings.allocationCheck = false;
+    }
+    if (const char* env = std::getenv("T3_FRAME_PACING")) {
+        const std::string value = env;
+        const int fps = std::atoi(env);
+        int found = -1;
+        for (int i = 0; i < static_cast<int>(std::size(FRAME_PACING_OPTIONS)); ++i) {
+            const FramePacingOption& option = FRAME_PACING_OPTIONS[i];
+            if ((value == "vsync" && option.mode == FramePacer::Mode::VSync) ||
+                (value == "uncapped" && option.mode == FramePacer::Mode::Uncapped) ||
+                (option.mode == FramePacer::Mode::Limited && option.fps == fps)) found = i;
+        }
+        if (found >= 0) gameSettings.framePacing = found;
+        else T3_LOG_WARNING("Ignoring T3_FRAME_PACING={}, expected vsync, uncapped, 60, 120, 144 or 240", env);
+    }
+    if (const char* env = std::getenv("T3_RECORD_INPUT")) inputRecordPath = env;
+    if (const char* env = std::getenv("T3_REPLAY_INPUT")) {
+        replayingInput = inputLog.load(env);
+        if (replayingInput) {
+            // ticks only line up at the rate it was recorded at
+            gameSettings.tickRate = inputLog.getTickRate();
+            T3_LOG_INFO("Replaying {} input events from {} (level {}, {} Hz)", inputLog.getEntries().size(), env,
+                        inputLog.getLevel(), inputLog.getTickRate());
+        }
+        inputRecordPath.clear();
+    }
+    if (const char* env = std::getenv("T3_SCENARIO_BENCH")) scenarioBenchPath = env;
+    if (const char* env = std::getenv("T3_SCENARIO_BASELINE")) scenarioBaselinePath = env;
+    if (const char* env = std::getenv("T3_SCENARIO_TICKS")) {
+        const long long ticks = std::atoll(env);
+        if (ticks > 0) scenarioTicks = static_cast<std::uint64_t>(ticks);
+    }
+    if (const char* env = std::getenv("T3_SCENARIO_TOLERANCE")) {
+        const double percent = std::atof(env);
+        if (percent >= 0.0) scenarioTolerance = percent / 100.0;
+    }
+    if (!scenarioBenchPath.empty()) {
+        // the script is the input, and every step runs inline where it can be timed
+        replayingInput = false;
+        inputRecordPath.clear();
+        gameSettings.simulationThread = false;
+    }
+    if (const char* env = std::getenv("T3_GOLDEN")) goldenDir = env;
+    if (const char* env = std::getenv("T3_GOLDEN_UPDATE")) goldenUpdate = std::atoi(env) != 0;
+    if (const char* env = std::getenv("T3_GOLDEN_TOLERANCE")) {
+        const double tolerance = std::atof(env);
+        if (tolerance >= 0.0) goldenTolerance.position = goldenTolerance.velocity = static_cast<float>(tolerance);
+    }
+    if (!goldenDir.empty()) {
+        // the committed logs are the input, one level after another inline so every tick gets sampled
+        scenarioBenchPath.clear();
+        replayingInput = false;
+        inputRecordPath.clear();
+        gameSettings.simulationThread = false;
+    }
+}
 
 // --- Function to populate available resolutions ---
 void populateAvailableResolutions() {
@@ -149,6 +343,18 @@ void populateAvailableResolutions() {
     }
 }
 
+void applyFramePacing(sf::Window& window) {
+    const FramePacingOption& option = FRAME_PACING_OPTIONS[gameSettings.framePacing];
+    framePacer.setMode(option.mode);
+    if (option.mode == FramePacer::Mode::Limited) framePacer.setTargetFps(option.fps);
+    framePacer.apply(window);
+}
+
+std::string framePacingName(int index) {
+    const FramePacingOption& option = FRAME_PACING_OPTIONS[index];
+    return option.mode == FramePacer::Mode::Limited ? std::to_string(option.fps) + " FPS" : FramePacer::modeName(option.mode);
+}
+
 void applyAndRecreateWindow(sf::RenderWindow& window, sf::View& uiView, sf::View& mainView) {
     sf::VideoMode mode;
     sf::Uint32 style;
@@ -158,8 +364,7 @@ void applyAndRecreateWindow(sf::RenderWindow& window, sf::View& uiView, sf::View
              mode = sf::VideoMode::getFullscreenModes()[0];
         } else {
             mode = sf::VideoMode(static_cast<unsigned int>(LOGICAL_SIZE.x), static_cast<unsigned int>(LOGICAL_SIZE.y));
-            std::cerr << "Warning: No fullscreen modes available, falling back to windowed "
-                      << LOGICAL_SIZE.x << "x" << LOGICAL_SIZE.y << "." << std::endl;
+            T3_LOG_WARNING("Warning: No fullscreen modes available, falling back to windowed {}x{}.", LOGICAL_SIZE.x, LOGICAL_SIZE.y);
             isFullscreen = false;
         }
         style = sf::Style::Fullscreen;
@@ -176,7 +381,7 @@ void applyAndRecreateWindow(sf::RenderWindow& window, sf::View& uiView, sf::View
 
     window.create(mode, "Project - T", style);
     window.setKeyRepeatEnabled(false);
-    window.setVerticalSyncEnabled(true);
+    applyFramePacing(window);
 
     float windowWidth = static_cast<float>(window.getSize().x);
     float windowHeight = static_cast<float>(window.getSize().y);
@@ -202,32 +407,34 @@ void applyAndRecreateWindow(sf::RenderWindow& window, sf::View& uiView, sf::View
     mainView.setViewport(viewportRect);
 }
 
-void playSfx(const std::string& sfxName) {
+void playSfx(const char* sfxName) {
     auto it = soundBuffers.find(sfxName);
-    if (it != soundBuffers.end()) {
-        sfxPlayer.setBuffer(it->second);
-        sfxPlayer.setVolume(gameSettings.sfxVolume);
-        sfxPlayer.play();
-    } else {
-        std::cerr << "SFX not loaded/found: " << sfxName << std::endl;
+    if (it == soundBuffers.end()) {
+        // once per name, a missing sound shouldn't turn every jump into console output
+        T3_LOG_WARNING("SFX not loaded/found: {}", sfxName);
+        soundBuffers.emplace(sfxName, nullptr);
+        return;
     }
+    if (!it->second) return;
+    sfxPlayer.setBuffer(*it->second);
+    sfxPlayer.setVolume(gameSettings.sfxVolume);
+    sfxPlayer.play();
 }
 
 void loadAudio() {
-    if (!menuMusic.openFromFile(AUDIO_MUSIC_MENU))
-        std::cerr << "Error loading menu music: " << AUDIO_MUSIC_MENU << std::endl;
+    if (!assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU))
+        T3_LOG_ERROR("Error loading menu music: {}", AUDIO_MUSIC_MENU);
     else menuMusic.setLoop(true);
 
-    if (!gameMusic.openFromFile(AUDIO_MUSIC_GAME))
-        std::cerr << "Error loading game music: " << AUDIO_MUSIC_GAME << std::endl;
+    if (!assetPack.openStream(gameMusic, AUDIO_MUSIC_GAME))
+        T3_LOG_ERROR("Error loading game music: {}", AUDIO_MUSIC_GAME);
     else gameMusic.setLoop(true);
 
     auto loadSfxBuffer = [&](const std::string& name, const std::string& path) {
-        sf::SoundBuffer buffer;
-        if (buffer.loadFromFile(path)) {
+        if (SoundBufferHandle buffer = assetManager.getSoundBuffer(path)) {
             soundBuffers[name] = buffer;
         } else {
-            std::cerr << "Error loading SFX: " << path << std::endl;
+            T3_LOG_ERROR("Error loading SFX: {}", path);
         }
     };
 
@@ -257,11 +464,287 @@ sf::Color getTileColorForBodyType(phys::bodyType type, const sf::Color& defaultC
     }
 }
 
-void setupLevelAssets(const LevelData& data, sf::RenderWindow& window) {
-    bodies.clear();
-    tiles.clear();
-    activeMovingPlatforms.clear();
-    activeInteractibles.clear();
+// Decodes the sprite art on the asset workers and packs it into spriteAtlas. The sheets are huge for what's
+// drawn on screen (1024px+ per frame), so frames get scaled down to 64px, lava to 128px since it's wide.
+void buildSpriteAtlas() {
+    const std::vector<std::string> files = {
+        "Mc1_left_side.png", "Mc2_left_side.png", "Mc3_left_side.png",
+        "Mc1_right_side.png", "Mc2_right_side.png", "Mc3_right_side.png",
+        "Door_spritesheet.png", "Skull-spritesheet.png", "Spike.png", "Lava.png"
+    };
+    std::vector<std::string> paths;
+    for (const std::string& file : files) paths.push_back(SPRITE_DIR + file);
+    std::vector<sf::Image> images;
+    sf::Clock atlasClock;
+    std::size_t failed = assetManager.loadImages(paths, images);
+
+    spriteAtlas.addFrames("player_left", {&images[0], &images[1], &images[2]}, 64);
+    spriteAtlas.addFrames("player_right", {&images[3], &images[4], &images[5]}, 64);
+    spriteAtlas.addSheet("door", images[6], 2, 3, {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {0, 2}}, 64);
+    spriteAtlas.addSheet("skull", images[7], 2, 3, {{0, 0}, {0, 1}, {0, 2}}, 64);
+    spriteAtlas.addSheet("spike", images[8], 1, 2, {}, 64);
+    spriteAtlas.addSheet("lava", images[9], 1, 2, {}, 128);
+    spriteAtlasReady = spriteAtlas.build();
+    if (spriteAtlasReady) tileRenderer.setTexture(&spriteAtlas.getTexture(), spriteAtlas.getFrames());
+    if (failed) T3_LOG_WARNING("Sprite atlas: {} ms, {} image(s) missing", atlasClock.getElapsedTime().asMilliseconds(), failed);
+    else T3_LOG_INFO("Sprite atlas: {} ms", atlasClock.getElapsedTime().asMilliseconds());
+}
+
+Tile makeTileForBody(std::size_t bodyIndex) {
+    const phys::PlatformBody& body = world.bodies[bodyIndex];
+    Tile newTile;
+    newTile.position = body.getPosition();
+    newTile.size = sf::Vector2f(body.getWidth(), body.getHeight());
+    newTile.setFillColor(getTileColorForBodyType(body.getType()));
+    return newTile;
+}
+
+// Traps get lava (wide ones) or spikes, goals a door that opens when the player gets close.
+void attachTileAnimation(std::size_t tileIndex) {
+    if (!spriteAtlasReady || tileIndex >= world.bodies.size()) return;
+    const phys::PlatformBody& body = world.bodies[tileIndex];
+    TileAnimation animation{tileIndex, Animator(), false};
+    if (body.getType() == phys::bodyType::trap) {
+        const bool wide = body.getWidth() >= 2.f * body.getHeight();
+        animation.animator = Animator(spriteAtlas.find(wide ? "lava" : "spike"), wide ? 3.f : 4.f);
+    } else if (body.getType() == phys::bodyType::goal) {
+        animation.animator = Animator(spriteAtlas.find("door"), 10.f, false);
+        animation.animator.pause();
+        animation.playOnApproach = true;
+    } else {
+        return;
+    }
+    if (!animation.animator.isValid()) return;
+    tiles[tileIndex].setFillColor(sf::Color::White);
+    tiles[tileIndex].frame = animation.animator.getFrameId();
+    tileAnimations.push_back(animation);
+}
+
+void updateTileAnimations(float deltaSeconds) {
+    const sf::Vector2f playerCenter = playerBody.getPosition() + sf::Vector2f(playerBody.getWidth() / 2.f, playerBody.getHeight() / 2.f);
+    for (TileAnimation& animation : tileAnimations) {
+        Tile& tile = tiles[animation.tileIndex];
+        if (animation.playOnApproach && !animation.animator.isPlaying() && !animation.animator.isFinished()) {
+            const sf::FloatRect bounds = tile.getGlobalBounds();
+            const sf::Vector2f offset = playerCenter - sf::Vector2f(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+            if (offset.x * offset.x + offset.y * offset.y < 96.f * 96.f) animation.animator.play();
+        }
+        animation.animator.update(deltaSeconds);
+        tile.frame = animation.animator.getFrameId();
+    }
+}
+
+// Works out the tile layout again, the renderer picks it up with the next published frame (layoutGeneration).
+// Only tiles the simulation can still touch are dynamic: moving/falling/vanishing/interactible platforms and
+// whatever an interactible links to. Their motion bounds cover every spot they can be drawn at, so the
+// renderer's grid never has to follow them around.
+// Runs on every streamed chunk load/unload, so it only reuses buffers: the bounds are written straight into
+// tileMotionBounds, spawn bounds first, then the moving and falling index lists put in how far those go.
+void rebuildTileBatch() {
+    linkedTileIDs.clear();
+    for (const auto& pair : world.interactibles) {
+        if (pair.second.info && pair.second.info->linkedID != 0) linkedTileIDs.push_back(pair.second.info->linkedID);
+    }
+    std::sort(linkedTileIDs.begin(), linkedTileIDs.end());
+
+    const std::size_t bodyCount = std::min(tiles.size(), world.bodies.size());
+    auto spawnBounds = [&](std::size_t i) {
+        return sf::FloatRect(world.getSpawnPosition(i), {world.bodies[i].getWidth(), world.bodies[i].getHeight()});
+    };
+    tileMotionBounds.assign(tiles.size(), sf::FloatRect());
+    for (std::size_t i = 0; i < bodyCount; ++i) {
+        switch (world.bodies[i].getSpawnType()) {
+            case phys::bodyType::moving:
+            case phys::bodyType::falling:
+            case phys::bodyType::vanishing:
+            case phys::bodyType::interactible:
+                tileMotionBounds[i] = spawnBounds(i);
+                break;
+            default:
+                if (std::binary_search(linkedTileIDs.begin(), linkedTileIDs.end(), world.bodies[i].getID())) tileMotionBounds[i] = spawnBounds(i);
+                break;
+        }
+    }
+    // their texture rect changes every few frames, a baked chunk would freeze them
+    for (const TileAnimation& animation : tileAnimations) {
+        if (animation.tileIndex < bodyCount) tileMotionBounds[animation.tileIndex] = spawnBounds(animation.tileIndex);
+    }
+    for (const ActiveMovingPlatform& moving : world.movingPlatforms) {
+        if (moving.bodyIndex >= bodyCount || world.bodies[moving.bodyIndex].getSpawnType() != phys::bodyType::moving) continue;
+        const LevelData::MovingPlatformInfo& path = *moving.info;
+        const float travel = path.initialDirection * path.distance;
+        sf::FloatRect reach(moving.origin + path.startPosition, tiles[moving.bodyIndex].size);
+        if (path.axis == 'x') { reach.left += std::min(0.f, travel); reach.width += std::abs(travel); }
+        else if (path.axis == 'y') { reach.top += std::min(0.f, travel); reach.height += std::abs(travel); }
+        tileMotionBounds[moving.bodyIndex] = reach;
+    }
+    for (const ActiveFallingPlatform& falling : world.fallingPlatforms) {
+        if (falling.bodyIndex >= bodyCount || world.bodies[falling.bodyIndex].getSpawnType() != phys::bodyType::falling) continue;
+        const sf::FloatRect start = spawnBounds(falling.bodyIndex);
+        tileMotionBounds[falling.bodyIndex] = {start.left, start.top, start.width,
+                                               std::max(start.height, falling.cutoffY - start.top + start.height)};
+    }
+
+    dynamicTiles.clear();
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        if (tileMotionBounds[i].width > 0.f || tileMotionBounds[i].height > 0.f) dynamicTiles.push_back(i);
+    }
+    ++tileLayoutGeneration;
+}
+
+// Marks the current state as the one to blend from, i.e. no interpolation until the next step. Called whenever
+// the tile list is rebuilt or shifted so the old positions don't line up.
+void snapshotPreviousState() {
+    previousTilePositions.resize(tiles.size());
+    for (std::size_t i = 0; i < tiles.size(); ++i) previousTilePositions[i] = tiles[i].position;
+    previousPlayerPosition = playerBody.getPosition();
+}
+
+// Same at the start of every step, static tiles can't have moved since the last full snapshot.
+void snapshotDynamicState() {
+    for (std::size_t i : dynamicTiles) previousTilePositions[i] = tiles[i].position;
+    previousPlayerPosition = playerBody.getPosition();
+}
+
+// Ground pointers only ever point into world.bodies (collision sets them from it, streaming remaps them), so a
+// range check is all the validation they need, no looking for the pointer among all the bodies.
+bool isWorldBody(const phys::PlatformBody* body) {
+    return body && !world.bodies.empty() && body >= world.bodies.data() && body < world.bodies.data() + world.bodies.size();
+}
+
+sf::Vector2f cameraCenterFor(const sf::Vector2f& playerPosition, const sf::Vector2f& playerSize) {
+    return playerPosition + sf::Vector2f(playerSize.x / 2.f, playerSize.y / 2.f - 50.f);
+}
+
+// Hands the step's result to the renderer. Never waits, a frame the renderer didn't pick up in time is skipped.
+void publishSimFrame() {
+    SimFrame& frame = simFrames.back();
+    if (frame.layoutGeneration != tileLayoutGeneration) {
+        frame.tiles.assign(tiles.begin(), tiles.end());
+        frame.previousTilePositions.assign(previousTilePositions.begin(), previousTilePositions.end());
+        frame.motionBounds.assign(tileMotionBounds.begin(), tileMotionBounds.end());
+        frame.layoutGeneration = tileLayoutGeneration;
+    } else {
+        for (std::size_t i : dynamicTiles) {
+            frame.tiles[i] = tiles[i];
+            frame.previousTilePositions[i] = previousTilePositions[i];
+        }
+    }
+    frame.tick = simTick;
+    frame.publishedUs = LatencyStats::nowMicros();
+    frame.lastInputUs = lastInputUs;
+    frame.playerPosition = playerBody.getPosition();
+    frame.previousPlayerPosition = previousPlayerPosition;
+    frame.playerVelocity = playerBody.getVelocity();
+    frame.playerSize = sf::Vector2f(playerBody.getWidth(), playerBody.getHeight());
+    frame.playerOnGround = playerBody.isOnGround();
+    frame.collisionChecked = lastCollision.platformsChecked;
+    frame.collisionCandidates = lastCollision.sweepCandidates;
+    frame.simAllocations = AllocationTracker::thisThread();
+    frame.arenaUsed = world.getArena().getBytesUsed();
+    frame.arenaCapacity = world.getArena().getCapacity();
+
+    if (levelStreamer.isActive()) {
+        frame.chunk = levelStreamer.chunkAt(playerBody.getPosition());
+        frame.residentChunks = levelStreamer.getResidentChunkCount();
+        frame.pendingChunks = levelStreamer.getPendingLoadCount();
+    }
+    const phys::PlatformBody* groundPlat = playerBody.getGroundPlatform();
+    frame.hasGround = groundPlat != nullptr;
+    frame.groundValid = isWorldBody(groundPlat);
+    if (frame.groundValid) {
+        frame.groundID = groundPlat->getID();
+        frame.groundType = groundPlat->getType();
+        frame.groundPortalID = groundPlat->getPortalID();
+    }
+    simFrames.publish();
+}
+
+// Drops the event if main hasn't drained the queue in a long while, there's nothing better to do from here.
+void emitSimEvent(const char* sfx, SimOutcome outcome = SimOutcome::None) {
+    simEvents.push({sfx, outcome});
+}
+
+void applyKey(int key, bool pressed) {
+    if (key == sf::Keyboard::Unknown) {
+        if (!pressed) heldKeys.reset();
+    } else if (key >= 0 && key < sf::Keyboard::KeyCount) {
+        heldKeys.set(static_cast<std::size_t>(key), pressed);
+        if (pressed) pressedKeys.set(static_cast<std::size_t>(key));
+    }
+    if (!inputRecordPath.empty()) inputLog.add(simTick, key, pressed);
+}
+
+// Feeds the step the input that happened up to the end of its tick. Later events stay queued for the tick they
+// fall in, so a catch-up burst doesn't see everything at once and replays line up tick for tick.
+void applyInputUpTo(std::int64_t tickEndUs) {
+    pressedKeys.reset();
+    InputEvent input;
+    while (inputQueue.peek(input) && input.timeUs <= tickEndUs) {
+        inputQueue.pop(input);
+        if (!replayingInput) applyKey(input.key, input.pressed);
+        lastInputUs = std::max(lastInputUs, input.timeUs);
+    }
+    if (!replayingInput) return;
+    const std::vector<InputLog::Entry>& entries = inputLog.getEntries();
+    while (replayCursor < entries.size() && entries[replayCursor].tick <= simTick) {
+        applyKey(entries[replayCursor].key, entries[replayCursor].pressed);
+        ++replayCursor;
+    }
+}
+
+// down now, or went down and up again inside this tick
+bool isHeld(sf::Keyboard::Key key) {
+    return heldKeys.test(static_cast<std::size_t>(key)) || pressedKeys.test(static_cast<std::size_t>(key));
+}
+
+bool wasPressed(sf::Keyboard::Key key) {
+    return pressedKeys.test(static_cast<std::size_t>(key));
+}
+
+// Gives a vector in world's arena an empty one instead, clear() would keep the buffer the arena is about to reuse.
+template <typename T>
+void releaseRunStorage(std::pmr::vector<T>& vector) {
+    vector = std::pmr::vector<T>(world.getResource());
+}
+
+// Only while the simulation is paused, it owns everything touched here otherwise.
+void setupLevelAssets(const LevelTemplatePtr& level, sf::RenderWindow& window) {
+    releaseRunStorage(tiles);
+    releaseRunStorage(previousTilePositions);
+    releaseRunStorage(tileAnimations);
+    releaseRunStorage(tileMotionBounds);
+    releaseRunStorage(dynamicTiles);
+    releaseRunStorage(linkedTileIDs);
+    levelStreamer.end();
+    world.reset(level);
+    // keys let go of while nobody was reading the queue would stay held
+    InputEvent staleInput;
+    while (inputQueue.pop(staleInput)) {}
+    heldKeys.reset();
+    pressedKeys.reset();
+    simTick = 0;
+    jumpBufferTicksLeft = 0;
+    coyoteTicksLeft = 0;
+    replayCursor = 0;
+    if (!inputRecordPath.empty()) {
+        if (!inputLog.empty()) inputLog.save(inputRecordPath);
+        inputLog.clear();
+        inputLog.setInfo(gameSettings.tickRate, level ? level->getData().levelNumber : 0);
+    }
+    if (replayingInput && level && level->getData().levelNumber != inputLog.getLevel()) {
+        T3_LOG_WARNING("Warning: replaying input recorded on level {} on level {}", inputLog.getLevel(), level->getData().levelNumber);
+    }
+    if (!level) {
+        rebuildTileBatch();
+        snapshotPreviousState();
+        publishSimFrame();
+        return;
+    }
+    const LevelData& data = level->getData();
+    if (data.streaming.enabled) {
+        levelStreamer.begin(level);
+    }
 
     playerBody.setPosition(data.playerStartPosition);
     playerBody.setVelocity({0.f, 0.f});
@@ -269,82 +752,62 @@ void setupLevelAssets(const LevelData& data, sf::RenderWindow& window) {
     playerBody.setGroundPlatform(nullptr);
     playerBody.setLastPosition(data.playerStartPosition);
 
-    bodies.reserve(data.platforms.size());
-    for (const auto& p_body_template : data.platforms) {
-        bodies.push_back(p_body_template);
-        phys::PlatformBody& new_body_ref = bodies.back();
-
-        if (new_body_ref.getType() == phys::bodyType::moving) {
-            bool foundDetail = false;
-            for(const auto& detail : data.movingPlatformDetails){
-                if(detail.id == new_body_ref.getID()){
-                    sf::Vector2f movementAnchor = detail.startPosition;
-                    float t0_offset = 0.f;
-                    if (detail.cycleDuration > 0.f && detail.cycleDuration / 2.0f > 1e-5f) {
-                        t0_offset = math::easing::sineEaseInOut(
-                            0.f, 0.f,
-                            static_cast<float>(detail.initialDirection) * detail.distance,
-                            detail.cycleDuration / 2.0f
-                        );
-                    }
-                    sf::Vector2f calculatedInitialPos = movementAnchor;
-                    if(detail.axis == 'x') calculatedInitialPos.x += t0_offset;
-                    else if(detail.axis == 'y') calculatedInitialPos.y += t0_offset;
+    tiles.reserve(world.bodies.size());
+    for (std::size_t i = 0; i < world.bodies.size(); ++i) {
+        tiles.push_back(makeTileForBody(i));
+        attachTileAnimation(i);
+    }
+    rebuildTileBatch();
+    snapshotPreviousState();
+    publishSimFrame();
+}
 
-                    if (std::abs(new_body_ref.getPosition().x - calculatedInitialPos.x) > 0.1f ||
-                        std::abs(new_body_ref.getPosition().y - calculatedInitialPos.y) > 0.1f) {
-                         new_body_ref.setPosition(calculatedInitialPos);
-                    }
+// Lets the streamer load/unload chunks around the player and camera, then brings the tiles and the player's
+// platform pointers in line with whatever moved in world.bodies. The camera follows the player on its own.
+void streamLevelAround(const sf::Vector2f& cameraCenter) {
+    auto indexOf = [](const phys::PlatformBody* body) -> std::size_t {
+        if (!isWorldBody(body)) return LevelTemplate::npos;
+        return static_cast<std::size_t>(body - world.bodies.data());
+    };
+    std::size_t groundIndex = indexOf(playerBody.getGroundPlatform());
+    std::size_t ignoredIndex = indexOf(playerBody.getGroundPlatformTemporarilyIgnored());
 
-                    activeMovingPlatforms.push_back({
-                        detail.id, movementAnchor, detail.axis, detail.distance,
-                        0.0f,
-                        detail.cycleDuration, detail.initialDirection,
-                        new_body_ref.getPosition()
-                    });
-                    foundDetail = true;
-                    break;
-                }
-            }
-            if(!foundDetail){
-                std::cerr << "Warning: Moving platform ID " << p_body_template.getID()
-                          << " (type 'moving' in JSON) missing movement details in LevelData. Will be static." << std::endl;
-            }
-        }
-        else if (new_body_ref.getType() == phys::bodyType::interactible) {
-            bool foundDetail = false;
-            for (const auto& detail : data.interactiblePlatformDetails) {
-                if (detail.id == new_body_ref.getID()) {
-                    activeInteractibles[detail.id] = {
-                        detail.id, detail.interactionType,
-                        levelManager.stringToBodyType(detail.targetBodyTypeStr),
-                        detail.targetTileColor, detail.hasTargetTileColor,
-                        detail.oneTime, detail.cooldown,
-                        false,
-                        0.f,
-                        detail.linkedID
-                    };
-                    foundDetail = true;
-                    break;
-                }
-            }
-            if (!foundDetail) {
-                std::cerr << "Warning: Interactible platform ID " << p_body_template.getID()
-                          << " (type 'interactible' in JSON) missing interaction details in LevelData. Will be static or unresponsive." << std::endl;
-            }
+    LevelStreamer::Changes changes = levelStreamer.update(world, playerBody.getPosition(), cameraCenter);
+    if (!changes.any()) return;
+
+    if (changes.rebased) {
+        playerBody.setPosition(playerBody.getPosition() + changes.rebaseDelta);
+        playerBody.setLastPosition(playerBody.getLastPosition() + changes.rebaseDelta);
+        for (auto& tile : tiles) tile.move(changes.rebaseDelta);
+    }
+
+    auto remap = [](std::size_t index, std::size_t first, std::size_t count) {
+        if (index == LevelTemplate::npos || index < first) return index;
+        return index < first + count ? LevelTemplate::npos : index - count;
+    };
+    for (const auto& range : changes.removedRanges) {
+        tiles.erase(tiles.begin() + static_cast<std::ptrdiff_t>(range.first),
+                    tiles.begin() + static_cast<std::ptrdiff_t>(range.first + range.second));
+        groundIndex = remap(groundIndex, range.first, range.second);
+        ignoredIndex = remap(ignoredIndex, range.first, range.second);
+        for (TileAnimation& animation : tileAnimations) {
+            animation.tileIndex = remap(animation.tileIndex, range.first, range.second);
         }
+        tileAnimations.erase(std::remove_if(tileAnimations.begin(), tileAnimations.end(),
+                                            [](const TileAnimation& animation) { return animation.tileIndex == LevelTemplate::npos; }),
+                             tileAnimations.end());
     }
 
-    tiles.reserve(bodies.size());
-    for (const auto& body : bodies) {
-        Tile newTile(sf::Vector2f(body.getWidth(), body.getHeight()));
-        newTile.setPosition(body.getPosition());
-        newTile.setFillColor(getTileColorForBodyType(body.getType()));
-        tiles.push_back(newTile);
+    for (std::size_t i = changes.firstAppendedBody; i < world.bodies.size(); ++i) {
+        tiles.push_back(makeTileForBody(i));
+        attachTileAnimation(i);
     }
+    rebuildTileBatch();
+    snapshotPreviousState();
 
-    vanishingPlatformCycleTimer = sf::Time::Zero;
-    oddEvenVanishing = 1;
+    playerBody.setGroundPlatform(groundIndex != LevelTemplate::npos ? &world.bodies[groundIndex] : nullptr);
+    if (groundIndex == LevelTemplate::npos) playerBody.setOnGround(false);
+    playerBody.setGroundPlatformTemporarilyIgnored(ignoredIndex != LevelTemplate::npos ? &world.bodies[ignoredIndex] : nullptr);
 }
 
 void updateResolutionDisplayText() {
@@ -366,32 +829,284 @@ void updateResolutionDisplayText() {
     resolutionCurrentText.setPosition(LOGICAL_SIZE.x / 2.f, 320.f);
 }
 
+// Scenario script: puts the player on the first platform of this type from `from` on (wrapping), or in its
+// middle. LevelTemplate::npos when the level has none.
+std::size_t placePlayerOnNext(phys::bodyType type, bool inside, std::size_t from) {
+    const std::size_t count = world.bodies.size();
+    for (std::size_t n = 0; n < count; ++n) {
+        const std::size_t i = (from + n) % count;
+        const phys::PlatformBody& body = world.bodies[i];
+        if (body.getType() != type) continue;
+        sf::Vector2f position = body.getPosition() + sf::Vector2f((body.getWidth() - playerBody.getWidth()) / 2.f, 0.f);
+        position.y += inside ? (body.getHeight() - playerBody.getHeight()) / 2.f : -playerBody.getHeight() - 1.f;
+        playerBody.setPosition(position);
+        playerBody.setLastPosition(position);
+        playerBody.setVelocity({0.f, 0.f});
+        playerBody.setOnGround(false);
+        playerBody.setGroundPlatform(nullptr);
+        return i;
+    }
+    return LevelTemplate::npos;
+}
+
+// T3_SCENARIO_BENCH. Every shipped level, then the stress levels, T3_SCENARIO_TICKS steps each, back to back on
+// this thread with the scenario script pressing keys through inputQueue like the keyboard would. Only the step
+// is timed, placing the player and setting the level up again after a death or goal aren't. 1 = a level
+// didn't load, the CSV couldn't be written or a p99 went over the baseline.
+template <typename StepFunction>
+int runScenarioBench(StepFunction& stepSimulation, sf::RenderWindow& window) {
+    std::vector<std::pair<std::string, LevelTemplatePtr>> scenarios;
+    levelManager.setCurrentLevelNumber(0);
+    while (levelManager.hasNextLevel()) {
+        const int number = levelManager.getCurrentLevelNumber() + 1;
+        levelManager.setCurrentLevelNumber(number);
+        LevelTemplatePtr level = levelManager.getLevelTemplate(number);
+        if (!level) {
+            T3_LOG_ERROR("Scenario bench: level {} didn't load", number);
+            return 1;
+        }
+        scenarios.emplace_back("level" + std::to_string(number), std::move(level));
+    }
+    for (std::size_t size : ScenarioBench::getStressSizes()) {
+        const std::string json = ScenarioBench::makeStressLevelJson(size);
+        LevelData data;
+        if (!levelManager.parseLevelJson(json.data(), json.size(), data)) {
+            T3_LOG_ERROR("Scenario bench: stress level of {} platforms didn't parse", size);
+            return 1;
+        }
+        scenarios.emplace_back("stress" + std::to_string(size), std::make_shared<const LevelTemplate>(std::move(data)));
+    }
+
+    ScenarioBench bench(scenarioTicks);
+    const std::vector<ScenarioBench::Phase>& script = ScenarioBench::getScript();
+    auto press = [](sf::Keyboard::Key key, bool pressed) {
+        if (key != sf::Keyboard::Unknown) inputQueue.push({LatencyStats::nowMicros(), key, pressed});
+    };
+    T3_LOG_INFO("Scenario bench: {} scenarios, {} ticks each at {} Hz", scenarios.size(), bench.getTicksPerScenario(), gameSettings.tickRate);
+
+    for (const auto& scenario : scenarios) {
+        const LevelTemplatePtr& level = scenario.second;
+        setupLevelAssets(level, window);
+        bench.begin(scenario.first, level->getPlatformCount());
+        std::vector<std::size_t> nextTarget(script.size(), 0); // per phase, so each visit finds a different platform
+        std::size_t phase = 0;
+        int phaseTick = 0;
+        std::uint64_t ticks = 0;
+        while (ticks < bench.getTicksPerScenario()) {
+            const ScenarioBench::Phase& current = script[phase];
+            if (phaseTick == 0) {
+                if (current.target != phys::bodyType::none) {
+                    const std::size_t target = placePlayerOnNext(current.target, current.inside, nextTarget[phase]);
+                    if (target == LevelTemplate::npos) {
+                        phase = (phase + 1) % script.size();
+                        continue;
+                    }
+                    nextTarget[phase] = target + 1;
+                }
+                for (sf::Keyboard::Key key : current.hold) press(key, true);
+            }
+            if (current.tapEvery > 0 && phaseTick % current.tapEvery == 0) {
+                press(current.tap, true);
+                press(current.tap, false);
+            }
+
+            const std::int64_t tickEndUs = LatencyStats::nowMicros();
+            const auto stepStart = std::chrono::steady_clock::now();
+            const bool alive = stepSimulation(tickEndUs);
+            bench.addTick(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - stepStart).count());
+            ++ticks;
+            SimEvent simEvent;
+            while (simEvents.pop(simEvent)) {}
+
+            if (!alive) {
+                // same level again, the phase starts over on it
+                bench.addRestart();
+                setupLevelAssets(level, window);
+                phaseTick = 0;
+                continue;
+            }
+            if (++phaseTick == current.ticks) {
+                inputQueue.push({LatencyStats::nowMicros(), sf::Keyboard::Unknown, false});
+                phaseTick = 0;
+                phase = (phase + 1) % script.size();
+            }
+        }
+        bench.end();
+    }
+    setupLevelAssets(nullptr, window);
+
+    int exitCode = 0;
+    if (bench.writeCsv(scenarioBenchPath, gameSettings.tickRate)) T3_LOG_INFO("Scenario bench: results in {}", scenarioBenchPath);
+    else exitCode = 1;
+    if (!scenarioBaselinePath.empty()) {
+        std::vector<ScenarioBench::Result> baseline;
+        if (!ScenarioBench::readCsv(scenarioBaselinePath, baseline)) return 1;
+        const std::size_t regressions = bench.checkBaseline(baseline, scenarioTolerance);
+        if (regressions > 0) {
+            T3_LOG_ERROR("Scenario bench: {} scenario(s) over {}'s p99 by more than {}%", regressions, scenarioBaselinePath, scenarioTolerance * 100.0);
+            exitCode = 1;
+        } else {
+            T3_LOG_INFO("Scenario bench: every p99 within {}% of {}", scenarioTolerance * 100.0, scenarioBaselinePath);
+        }
+    } else {
+        T3_LOG_WARNING("Scenario bench: no T3_SCENARIO_BASELINE, p99 not checked (keep a CSV from this machine to gate on it)");
+    }
+    return exitCode;
+}
+
+// T3_GOLDEN. Every shipped level gets its input log from goldenDir replayed on this thread, for a second past the
+// last event or until the run ends, with the player sampled after every step. The samples go to the level's trace
+// with T3_GOLDEN_UPDATE, and are compared with it otherwise. resetRun puts back what the step keeps outside the
+// level (tick length, jump hold). 1 = a level has no input log or trace, or diverged.
+template <typename StepFunction, typename ResetFunction>
+int runGoldenCheck(StepFunction& stepSimulation, ResetFunction& resetRun, sf::RenderWindow& window) {
+    std::size_t levels = 0, failures = 0, missingTraces = 0;
+    levelManager.setCurrentLevelNumber(0);
+    while (levelManager.hasNextLevel()) {
+        const int number = levelManager.getCurrentLevelNumber() + 1;
+        levelManager.setCurrentLevelNumber(number);
+        ++levels;
+        const std::string basePath = goldenDir + "/level" + std::to_string(number);
+        LevelTemplatePtr level = levelManager.getLevelTemplate(number);
+        if (!level) {
+            T3_LOG_ERROR("Golden: level {} didn't load", number);
+            ++failures;
+            continue;
+        }
+        if (!inputLog.load(basePath + ".t3in")) {
+            T3_LOG_ERROR("Golden: level {} has no input log, record one with T3_RECORD_INPUT={}.t3in", number, basePath);
+            ++failures;
+            continue;
+        }
+        gameSettings.tickRate = inputLog.getTickRate();
+        resetRun();
+        replayingInput = true;
+        setupLevelAssets(level, window);
+
+        const std::vector<InputLog::Entry>& entries = inputLog.getEntries();
+        const std::uint64_t ticks = (entries.empty() ? 0 : entries.back().tick) + static_cast<std::uint64_t>(gameSettings.tickRate);
+        GoldenTrace run;
+        run.setInfo(gameSettings.tickRate, number);
+        for (std::uint64_t n = 0; n < ticks; ++n) {
+            const std::uint64_t tick = simTick;
+            const bool alive = stepSimulation(0);
+            const phys::PlatformBody* ground = playerBody.getGroundPlatform();
+            std::uint8_t flags = 0;
+            if (lastCollision.onGround) flags |= GoldenTrace::OnGround;
+            if (lastCollision.hitCeiling) flags |= GoldenTrace::HitCeiling;
+            if (lastCollision.hitWallLeft) flags |= GoldenTrace::HitWallLeft;
+            if (lastCollision.hitWallRight) flags |= GoldenTrace::HitWallRight;
+            run.add({tick, playerBody.getPosition(), playerBody.getVelocity(), isWorldBody(ground) ? ground->getID() : 0u, flags});
+            SimEvent simEvent;
+            while (simEvents.pop(simEvent)) {}
+            if (!alive) break;
+        }
+
+        const std::string tracePath = basePath + ".t3trace";
+        if (goldenUpdate) {
+            if (run.save(tracePath)) T3_LOG_INFO("Golden: level {} traced, {} ticks to {}", number, run.getSamples().size(), tracePath);
+            else ++failures;
+            continue;
+        }
+        if (!std::filesystem::exists(tracePath)) {
+            T3_LOG_ERROR("Golden: level {} has no trace, {} is missing", number, tracePath);
+            ++missingTraces;
+            ++failures;
+            continue;
+        }
+        GoldenTrace golden;
+        if (!golden.load(tracePath)) {
+            ++failures;
+            continue;
+        }
+        std::string what;
+        const std::size_t at = golden.findDivergence(run, goldenTolerance, what);
+        if (at == GoldenTrace::npos) {
+            T3_LOG_INFO("Golden: level {} matches, {} ticks", number, run.getSamples().size());
+            continue;
+        }
+        const std::vector<GoldenTrace::Sample>& samples = at < run.getSamples().size() ? run.getSamples() : golden.getSamples();
+        T3_LOG_ERROR("Golden: level {} diverges at tick {}: {}", number, samples[at].tick, what);
+        ++failures;
+    }
+    replayingInput = false;
+    setupLevelAssets(nullptr, window);
+
+    if (levels == 0) {
+        T3_LOG_ERROR("Golden: no levels to check");
+        return 1;
+    }
+    if (missingTraces > 0) {
+        // nothing was checked against those, they only come from golden_update on a build linked to SFML
+        T3_LOG_ERROR("Golden: {} of {} level(s) have no trace, record them with the golden_update target and commit them",
+                     missingTraces, levels);
+    }
+    if (failures > 0) {
+        T3_LOG_ERROR("Golden: {} of {} level(s) failed", failures, levels);
+        return 1;
+    }
+    T3_LOG_INFO("Golden: {} level(s) {}", levels, goldenUpdate ? "traced" : "match their traces");
+    return 0;
+}
+
 int main(void) {
+    Log::start();
+    T3_PROFILE_THREAD("main");
     sf::RenderWindow window;
     sf::View uiView;
     sf::View mainView;
 
     sf::Clock gameClock;
     sf::Time timeSinceLastFixedUpdate = sf::Time::Zero;
-    const sf::Time TIME_PER_FIXED_UPDATE = sf::seconds(1.f / 60.f);
+    applyEnvironmentSettings();
+    sf::Time timePerFixedUpdate = sf::seconds(1.f / static_cast<float>(gameSettings.tickRate));
+    float renderAlpha = 1.f;          // how far the frame is between the previous and current step
+    int stepsLastFrame = 0;
+    sf::Time droppedSimTime = sf::Time::Zero;
 
     bool running = true;
-    bool interactKeyPressedThisFrame = false;
+    std::uint32_t renderedLayoutGeneration = 0; // of the tiles laid out in tileRenderer
+    std::uint64_t lastRenderedTick = 0;
+    std::int64_t displayedInputUs = 0;          // newest input in the frame that went on screen
+    std::int64_t lastMeasuredInputUs = 0;
+    LatencyStats inputLatency;
+    LatencyStats tickJitter;                    // inline steps only, simThread keeps its own
+    sf::Clock latencyReportClock;
+    AllocationTracker::Counts lastAllocationTotal = AllocationTracker::total();
+    AllocationTracker::Counts frameAllocations;             // every thread, for the HUD
+    // T3_ALLOC_CHECK: only the main and simulation threads, SFML's audio threads are none of our business
+    AllocationTracker::Counts lastCheckedMainAllocations = AllocationTracker::thisThread();
+    AllocationTracker::Counts lastSimAllocations;
+    AllocationTracker::Counts simAllocationsShown;          // by the steps that went into this frame
+    std::uint32_t checkedLayoutGeneration = 0;
+    int steadyFrames = 0;
+    std::uint64_t checkedFrames = 0;
+    int exitCode = 0;
+    float levelSetupMs = 0.f;
 
     sf::Time currentJumpHoldDuration = sf::Time::Zero;
     int turboMultiplier = 1;
 
     // --- UI Elements ---
-    sf::Font menuFont;
+    FontHandle menuFont;
     sf::Text menuTitleText, startButtonText, settingsButtonText, creditsButtonText, exitButtonText;
-    sf::Texture menuBgTexture; sf::Sprite menuBgSprite;
+    TextureHandle menuBgTexture; sf::Sprite menuBgSprite;
     sf::Text settingsTitleText, musicVolumeLabelText, musicVolValText, sfxVolumeLabelText, sfxVolValText, settingsBackText;
     sf::Text musicVolDownText, musicVolUpText, sfxVolDownText, sfxVolUpText;
     sf::Text resolutionLabelText, resolutionPrevText, resolutionNextText, fullscreenToggleText;
+    sf::Text tickRateLabelText, tickRateDownText, tickRateValText, tickRateUpText;
+    sf::Text pacingLabelText, pacingDownText, pacingValText, pacingUpText;
     sf::Text creditsTitleText, creditsNamesText, creditsBackText;
     sf::Text gameOverStatusText, gameOverOption1Text, gameOverOption2Text;
-    sf::Text debugText;
-    sf::RectangleShape playerShape;
+    PerfHud perfHud;
+    sf::RectangleShape playerShape; // only drawn if the sprite atlas didn't build
+    sf::Sprite playerSprite;
+    Animator playerWalk;
+    const TextureAtlas::Animation* playerWalkLeft = nullptr;  // looked up once, not by name every frame
+    const TextureAtlas::Animation* playerWalkRight = nullptr;
+    bool playerFacingLeft = false;
+    sf::Sprite skullSprite;
+    Animator skullSpin;
 
     // --- Game Constants ---
     const float PLAYER_MOVE_SPEED = 200.f;
@@ -401,11 +1116,21 @@ int main(void) {
     const sf::Time MAX_JUMP_HOLD_TIME = sf::seconds(0.18f);
     const float PLAYER_DEATH_Y_LIMIT = 2000.f;
     const float SPRING_BOUNCE_VELOCITY = 2.0f * JUMP_INITIAL_VELOCITY;
+    const float FALLING_PLATFORM_SPEED = 200.f;
+    const sf::Time JUMP_BUFFER_TIME = sf::seconds(0.1f); // jump pressed up to this long before landing
+    const sf::Time COYOTE_TIME = sf::seconds(0.08f);     // jump pressed up to this long after walking off an edge
+    const double PROFILE_DUMP_SECONDS = 10.0;            // how much history F9 writes out
+    const int ALLOC_CHECK_WARMUP_FRAMES = 120;           // caches, glyphs and buffers get to fill up before T3_ALLOC_CHECK looks
 
     // --- Initialization ---
-    populateAvailableResolutions();
+    // the scenario benchmark and the golden check never open a window, so nothing below that needs one (or GL,
+    // or audio) runs for them
+    const bool headless = !scenarioBenchPath.empty() || !goldenDir.empty();
     const sf::Vector2f tileSize(32.f, 32.f);
-    applyAndRecreateWindow(window, uiView, mainView);
+    if (!headless) {
+        populateAvailableResolutions();
+        applyAndRecreateWindow(window, uiView, mainView);
+    }
 
     GameState currentState = GameState::MENU;
     levelManager.setMaxLevels(5);
@@ -415,107 +1140,624 @@ int main(void) {
     levelManager.setNextLevelLoadingScreenImage(IMG_LOAD_NEXT);
     levelManager.setRespawnLoadingScreenImage(IMG_LOAD_RESPAWN);
 
-    loadAudio();
+    if (!assetPack.open(ASSET_PACK_PATH)) {
+        T3_LOG_INFO("No asset pack at {}, loading loose files.", ASSET_PACK_PATH);
+    }
+    levelManager.setAssetPack(&assetPack);
+    assetManager.setAssetPack(&assetPack);
+    levelManager.setAssetManager(&assetManager);
 
     playerBody = phys::DynamicBody({0,0}, tileSize.x, tileSize.y);
+    sf::Color defaultBtnColor = sf::Color::White;
+    sf::Color hoverBtnColor = sf::Color::Yellow;
+    sf::Color exitBtnHoverColor = sf::Color::Red;
+
+    if (!headless) {
+        // Decode everything the menu and the first loading screen need on the workers at once,
+        // loadAudio() and the UI setup below then just pick up the cached results.
+        for (const std::string& image : {IMG_MENU_BG, IMG_LOAD_GENERAL, IMG_LOAD_NEXT, IMG_LOAD_RESPAWN}) {
+            assetManager.preloadTexture(image);
+        }
+        for (const std::string& sfx : {SFX_JUMP, SFX_DEATH, SFX_GOAL, SFX_CLICK, SFX_SPRING, SFX_PORTAL}) {
+            assetManager.preloadSoundBuffer(sfx);
+        }
+        std::size_t failedAssets = assetManager.finishPreloads();
+        const AssetManager::Stats& assetStats = assetManager.getStats();
+        if (failedAssets) {
+            T3_LOG_WARNING("Startup assets: {} decoded in {} ms on {} thread(s), {} failed", assetStats.preloaded, assetStats.lastPreloadMs,
+                           assetStats.workers, failedAssets);
+        } else {
+            T3_LOG_INFO("Startup assets: {} decoded in {} ms on {} thread(s)", assetStats.preloaded, assetStats.lastPreloadMs, assetStats.workers);
+        }
+
+        loadAudio();
+        buildSpriteAtlas();
+
+        menuFont = assetManager.getFont(FONT_PATH);
+        if (!menuFont) {
+            T3_LOG_ERROR("FATAL: Failed to load font: {}. Trying fallback.", FONT_PATH);
+            #if defined(_WIN32)
+            if (!(menuFont = assetManager.getFont("C:/Windows/Fonts/arialbd.ttf"))) { T3_LOG_ERROR("Windows fallback font failed."); return -1; }
+            #elif defined(__APPLE__)
+            if (!(menuFont = assetManager.getFont("/System/Library/Fonts/Supplemental/Arial Bold.ttf"))) { if(!(menuFont = assetManager.getFont("/Library/Fonts/Arial Bold.ttf"))) { T3_LOG_ERROR("macOS fallback font failed."); return -1; }}
+            #else
+            if (!(menuFont = assetManager.getFont("/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf"))) {
+                if (!(menuFont = assetManager.getFont("/usr/share/fonts/TTF/DejaVuSans-Bold.ttf"))){
+                     T3_LOG_ERROR("Linux fallback font failed."); return -1;
+                }
+            }
+            #endif
+            if (menuFont->getInfo().family.empty()) { T3_LOG_ERROR("All font loading attempts failed."); return -1; }
+            T3_LOG_INFO("Loaded a fallback font: {}", menuFont->getInfo().family);
+        }
 
-    if (!menuFont.loadFromFile(FONT_PATH)) {
-        std::cerr << "FATAL: Failed to load font: " << FONT_PATH << ". Trying fallback." << std::endl;
-        #if defined(_WIN32)
-        if (!menuFont.loadFromFile("C:/Windows/Fonts/arialbd.ttf")) { std::cerr << "Windows fallback font failed.\n"; return -1; }
-        #elif defined(__APPLE__)
-        if (!menuFont.loadFromFile("/System/Library/Fonts/Supplemental/Arial Bold.ttf")) { if(!menuFont.loadFromFile("/Library/Fonts/Arial Bold.ttf")) {std::cerr << "macOS fallback font failed.\n"; return -1; }}
-        #else
-        if (!menuFont.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf")) {
-            if (!menuFont.loadFromFile("/usr/share/fonts/TTF/DejaVuSans-Bold.ttf")){
-                 std::cerr << "Linux fallback font failed.\n"; return -1;
+        auto setupTextUI = [&](sf::Text& text, const sf::String& str, float yPos, unsigned int charSize = 30, float xOffset = 0.f) {
+            text.setFont(*menuFont);
+            text.setString(str);
+            text.setCharacterSize(charSize);
+            text.setFillColor(sf::Color::White);
+            sf::FloatRect text_bounds = text.getLocalBounds();
+            text.setOrigin(text_bounds.left + text_bounds.width / 2.f, text_bounds.top + text_bounds.height / 2.f);
+            text.setPosition(LOGICAL_SIZE.x / 2.f + xOffset, yPos);
+        };
+
+        menuBgTexture = assetManager.getTexture(IMG_MENU_BG);
+        if (menuBgTexture) {
+            menuBgSprite.setTexture(*menuBgTexture);
+            if (menuBgTexture->getSize().x > 0 && menuBgTexture->getSize().y > 0) {
+                menuBgSprite.setScale(LOGICAL_SIZE.x / static_cast<float>(menuBgTexture->getSize().x),
+                                      LOGICAL_SIZE.y / static_cast<float>(menuBgTexture->getSize().y));
             }
+            menuBgSprite.setPosition(0.f,0.f);
+        }
+        else {
+            T3_LOG_WARNING("Warning: Menu BG image not found: {}", IMG_MENU_BG);
+        }
+
+        // --- UI Text Setup ---
+        setupTextUI(menuTitleText, "Project - T", 100.f, 48);
+        setupTextUI(startButtonText, "Start Game", 250.f);
+        setupTextUI(settingsButtonText, "Settings", 300.f);
+        setupTextUI(creditsButtonText, "Credits", 350.f);
+        setupTextUI(exitButtonText, "Exit", 400.f);
+
+        setupTextUI(settingsTitleText, "Settings", 70.f, 40);
+        setupTextUI(musicVolumeLabelText, "Music Volume:", 150.f, 24, -100.f);
+        setupTextUI(musicVolDownText, "<", 150.f, 24, 20.f);
+        setupTextUI(musicVolValText, "", 150.f, 24, 80.f);
+        setupTextUI(musicVolUpText, ">", 150.f, 24, 140.f);
+        setupTextUI(sfxVolumeLabelText, "SFX Volume:", 200.f, 24, -100.f);
+        setupTextUI(sfxVolDownText, "<", 200.f, 24, 20.f);
+        setupTextUI(sfxVolValText, "", 200.f, 24, 80.f);
+        setupTextUI(sfxVolUpText, ">", 200.f, 24, 140.f);
+        setupTextUI(resolutionLabelText, "Resolution:", 270.f, 24, -100.f);
+        setupTextUI(resolutionPrevText, "<", 320.f, 24, -30.f);
+        resolutionCurrentText.setFont(*menuFont);
+        resolutionCurrentText.setCharacterSize(24);
+        resolutionCurrentText.setFillColor(sf::Color::White);
+        updateResolutionDisplayText();
+        setupTextUI(resolutionNextText, ">", 320.f, 24, 30.f);
+        setupTextUI(fullscreenToggleText, "Toggle Fullscreen", 370.f, 24);
+        setupTextUI(tickRateLabelText, "Tick Rate:", 410.f, 24, -100.f);
+        setupTextUI(tickRateDownText, "<", 410.f, 24, 20.f);
+        setupTextUI(tickRateValText, "", 410.f, 24, 80.f);
+        setupTextUI(tickRateUpText, ">", 410.f, 24, 140.f);
+        setupTextUI(pacingLabelText, "Frame Pacing:", 450.f, 24, -100.f);
+        setupTextUI(pacingDownText, "<", 450.f, 24, 10.f);
+        setupTextUI(pacingValText, "", 450.f, 24, 50.f);
+        setupTextUI(pacingUpText, ">", 450.f, 24, 170.f);
+        setupTextUI(settingsBackText, "Back to Menu", 500.f);
+
+        setupTextUI(creditsTitleText, "Credits", 100.f, 40);
+        setupTextUI(creditsNamesText, "Jan\nZean\nJecer\nGian", 250.f, 28);
+        setupTextUI(creditsBackText, "Back to Menu", 450.f);
+
+        setupTextUI(gameOverStatusText, "", 150.f, 36);
+        setupTextUI(gameOverOption1Text, "", 280.f);
+        setupTextUI(gameOverOption2Text, "Main Menu", 330.f);
+
+        playerShape.setFillColor(sf::Color(220, 220, 250, 255));
+        playerShape.setSize(sf::Vector2f(playerBody.getWidth(), playerBody.getHeight()));
+        if (spriteAtlasReady) {
+            playerWalkLeft = spriteAtlas.find("player_left");
+            playerWalkRight = spriteAtlas.find("player_right");
+            playerWalk = Animator(playerWalkRight, 8.f);
+            playerSprite.setTexture(spriteAtlas.getTexture());
+            skullSpin = Animator(spriteAtlas.find("skull"), 6.f);
+            skullSprite.setTexture(spriteAtlas.getTexture());
+            skullSprite.setPosition(LOGICAL_SIZE.x / 2.f, 80.f);
+        }
+
+        perfHud.setFont(menuFont.get(), 14);
+        perfHud.setVisible(gameSettings.perfHud);
+
+        menuMusic.setVolume(gameSettings.musicVolume);
+        gameMusic.setVolume(gameSettings.musicVolume);
+        if (menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) {
+            menuMusic.play();
         }
-        #endif
-        if (menuFont.getInfo().family.empty()) {std::cerr << "All font loading attempts failed.\n"; return -1;}
-        std::cout << "Loaded a fallback font: " << menuFont.getInfo().family << std::endl;
     }
 
-    auto setupTextUI = [&](sf::Text& text, const sf::String& str, float yPos, unsigned int charSize = 30, float xOffset = 0.f) {
-        text.setFont(menuFont);
-        text.setString(str);
-        text.setCharacterSize(charSize);
-        text.setFillColor(sf::Color::White);
-        sf::FloatRect text_bounds = text.getLocalBounds();
-        text.setOrigin(text_bounds.left + text_bounds.width / 2.f, text_bounds.top + text_bounds.height / 2.f);
-        text.setPosition(LOGICAL_SIZE.x / 2.f + xOffset, yPos);
+    // One fixed step of the game. Runs on simThread, or inline between frames with T3_SIM_THREAD=0. Touches
+    // nothing the main thread owns: input comes from inputQueue, sounds and the end of the run go out as
+    // SimEvents, and the result is published for the renderer. tickEndUs is the point in real time this tick
+    // stands for, input after it waits for the next one. false = the run ended, stop stepping.
+    auto ticksFor = [&](sf::Time window) {
+        return std::max(1, static_cast<int>(std::lround(window.asSeconds() / timePerFixedUpdate.asSeconds())));
     };
 
-    if (menuBgTexture.loadFromFile(IMG_MENU_BG)) {
-        menuBgSprite.setTexture(menuBgTexture);
-        if (menuBgTexture.getSize().x > 0 && menuBgTexture.getSize().y > 0) {
-            menuBgSprite.setScale(LOGICAL_SIZE.x / static_cast<float>(menuBgTexture.getSize().x),
-                                  LOGICAL_SIZE.y / static_cast<float>(menuBgTexture.getSize().y));
+    auto stepSimulation = [&](std::int64_t tickEndUs) -> bool {
+        T3_PROFILE_ZONE(stepZone, "step.input");
+        const float fixed_dt_seconds = timePerFixedUpdate.asSeconds();
+        applyInputUpTo(tickEndUs);
+        const bool interactThisStep = wasPressed(sf::Keyboard::E);
+
+        if (levelStreamer.isActive()) {
+            T3_PROFILE_SCOPE("step.streaming");
+            streamLevelAround(cameraCenterFor(playerBody.getPosition(), {playerBody.getWidth(), playerBody.getHeight()}));
+        }
+        snapshotDynamicState();
+        playerBody.setLastPosition(playerBody.getPosition());
+        updateTileAnimations(fixed_dt_seconds);
+
+        // --- Handle Input for Player ---
+        float horizontalInput = 0.f;
+        if (isHeld(sf::Keyboard::LShift) || isHeld(sf::Keyboard::RShift)) turboMultiplier = 2;
+        else turboMultiplier = 1;
+
+        if (isHeld(sf::Keyboard::A) || isHeld(sf::Keyboard::Left)) horizontalInput = -1.f;
+        else if (isHeld(sf::Keyboard::D) || isHeld(sf::Keyboard::Right)) horizontalInput = 1.f;
+
+        bool jumpIntentThisFrame = (isHeld(sf::Keyboard::W) || isHeld(sf::Keyboard::Up) || isHeld(sf::Keyboard::Space));
+        bool dropIntentThisFrame = (isHeld(sf::Keyboard::S) || isHeld(sf::Keyboard::Down));
+
+        // jump buffer and coyote time, counted in ticks so they come out the same at any frame rate
+        if (wasPressed(sf::Keyboard::W) || wasPressed(sf::Keyboard::Up) || wasPressed(sf::Keyboard::Space)) jumpBufferTicksLeft = ticksFor(JUMP_BUFFER_TIME);
+        if (playerBody.isOnGround() && !dropIntentThisFrame) coyoteTicksLeft = ticksFor(COYOTE_TIME);
+        // only while falling, a spring launch isn't a ledge
+        const bool canJump = playerBody.isOnGround() || (coyoteTicksLeft > 0 && playerBody.getVelocity().y >= 0.f);
+        bool newJumpPressThisFrame = ((jumpIntentThisFrame || jumpBufferTicksLeft > 0) && canJump && currentJumpHoldDuration == sf::Time::Zero);
+        if (newJumpPressThisFrame) {
+            jumpBufferTicksLeft = 0;
+            coyoteTicksLeft = 0;
+        } else {
+            if (jumpBufferTicksLeft > 0) --jumpBufferTicksLeft;
+            if (!playerBody.isOnGround() && coyoteTicksLeft > 0) --coyoteTicksLeft;
         }
-        menuBgSprite.setPosition(0.f,0.f);
-    }
-    else {
-        std::cerr << "Warning: Menu BG image not found: " << IMG_MENU_BG << std::endl;
-    }
 
-    // --- UI Text Setup ---
-    setupTextUI(menuTitleText, "Project - T", 100.f, 48);
-    setupTextUI(startButtonText, "Start Game", 250.f);
-    setupTextUI(settingsButtonText, "Settings", 300.f);
-    setupTextUI(creditsButtonText, "Credits", 350.f);
-    setupTextUI(exitButtonText, "Exit", 400.f);
-
-    setupTextUI(settingsTitleText, "Settings", 70.f, 40);
-    setupTextUI(musicVolumeLabelText, "Music Volume:", 150.f, 24, -100.f);
-    setupTextUI(musicVolDownText, "<", 150.f, 24, 20.f);
-    setupTextUI(musicVolValText, "", 150.f, 24, 80.f);
-    setupTextUI(musicVolUpText, ">", 150.f, 24, 140.f);
-    setupTextUI(sfxVolumeLabelText, "SFX Volume:", 200.f, 24, -100.f);
-    setupTextUI(sfxVolDownText, "<", 200.f, 24, 20.f);
-    setupTextUI(sfxVolValText, "", 200.f, 24, 80.f);
-    setupTextUI(sfxVolUpText, ">", 200.f, 24, 140.f);
-    setupTextUI(resolutionLabelText, "Resolution:", 270.f, 24, -100.f);
-    setupTextUI(resolutionPrevText, "<", 320.f, 24, -30.f);
-    resolutionCurrentText.setFont(menuFont);
-    resolutionCurrentText.setCharacterSize(24);
-    resolutionCurrentText.setFillColor(sf::Color::White);
-    updateResolutionDisplayText();
-    setupTextUI(resolutionNextText, ">", 320.f, 24, 30.f);
-    setupTextUI(fullscreenToggleText, "Toggle Fullscreen", 370.f, 24);
-    setupTextUI(settingsBackText, "Back to Menu", 450.f);
-
-    setupTextUI(creditsTitleText, "Credits", 100.f, 40);
-    setupTextUI(creditsNamesText, "Jan\nZean\nJecer\nGian", 250.f, 28);
-    setupTextUI(creditsBackText, "Back to Menu", 450.f);
-
-    setupTextUI(gameOverStatusText, "", 150.f, 36);
-    setupTextUI(gameOverOption1Text, "", 280.f);
-    setupTextUI(gameOverOption2Text, "Main Menu", 330.f);
+        if (newJumpPressThisFrame && !playerBody.getGroundPlatformTemporarilyIgnored()) {
+            const phys::PlatformBody* groundPlat = playerBody.getGroundPlatform();
+            if (!isWorldBody(groundPlat) || groundPlat->getType() != phys::bodyType::spring) {
+                 emitSimEvent("jump");
+            }
+        }
+        playerBody.setTryingToDrop(dropIntentThisFrame && playerBody.isOnGround());
+
+        // --- Update Moving Platforms ---
+        // Phases first, then eased a chunk at a time (easeBatch vectorizes), then the platforms get placed. A
+        // platform an interactible turned into something else stays where it is and its clock stops.
+        T3_PROFILE_NEXT(stepZone, "step.movingPlatforms");
+        constexpr std::size_t EASE_CHUNK = 64;
+        float movePhases[EASE_CHUNK];
+        bool movingBack[EASE_CHUNK];
+        for (std::size_t first = 0; first < world.movingPlatforms.size(); first += EASE_CHUNK) {
+            const std::size_t count = std::min(EASE_CHUNK, world.movingPlatforms.size() - first);
+            for (std::size_t k = 0; k < count; ++k) {
+                ActiveMovingPlatform& activePlat = world.movingPlatforms[first + k];
+                movePhases[k] = 0.f;
+                movingBack[k] = false;
+                const phys::PlatformBody& movingBody = world.bodies[activePlat.bodyIndex];
+                if (movingBody.getType() != phys::bodyType::moving) continue;
+                activePlat.lastFrameActualPosition = movingBody.getPosition();
+                activePlat.cycleTime += fixed_dt_seconds;
+                float effectiveCycleDur = activePlat.info->cycleDuration > 1e-5f ? activePlat.info->cycleDuration : 1.f;
+                activePlat.cycleTime = std::fmod(activePlat.cycleTime, effectiveCycleDur);
+
+                // there for the first half of the cycle, back for the second
+                float singleMovePhaseDur = effectiveCycleDur / 2.0f;
+                if (singleMovePhaseDur > 1e-5f) {
+                    movingBack[k] = activePlat.cycleTime >= singleMovePhaseDur;
+                    movePhases[k] = (movingBack[k] ? activePlat.cycleTime - singleMovePhaseDur : activePlat.cycleTime) / singleMovePhaseDur;
+                }
+            }
+            math::easing::easeBatch<math::easing::Curve::SineInOut>(movePhases, movePhases, count);
+            for (std::size_t k = 0; k < count; ++k) {
+                const ActiveMovingPlatform& activePlat = world.movingPlatforms[first + k];
+                phys::PlatformBody& movingBody = world.bodies[activePlat.bodyIndex];
+                if (movingBody.getType() != phys::bodyType::moving) continue;
+                const LevelData::MovingPlatformInfo& path = *activePlat.info;
+                const float travel = path.initialDirection * path.distance;
+                const float offset = travel * (movingBack[k] ? 1.f - movePhases[k] : movePhases[k]);
+                sf::Vector2f newPos = activePlat.origin + path.startPosition;
+                if(path.axis == 'x') newPos.x += offset;
+                else if(path.axis == 'y') newPos.y += offset;
+
+                movingBody.setPosition(newPos);
+                if (activePlat.bodyIndex < tiles.size()) {
+                    tiles[activePlat.bodyIndex].setPosition(newPos);
+                }
+            }
+        }
 
-    sf::Color defaultBtnColor = sf::Color::White;
-    sf::Color hoverBtnColor = sf::Color::Yellow;
-    sf::Color exitBtnHoverColor = sf::Color::Red;
+        // --- Update Interactible Cooldowns ---
+        T3_PROFILE_NEXT(stepZone, "step.cooldowns");
+        for (auto& pair : world.interactibles) {
+            ActiveInteractiblePlatform& interactible = pair.second;
+            if (interactible.currentCooldownTimer > 0.f) {
+                interactible.currentCooldownTimer -= fixed_dt_seconds;
+                if (interactible.currentCooldownTimer < 0.f) interactible.currentCooldownTimer = 0.f;
+            }
+        }
+
+        // --- Update Falling Platforms ---
+        T3_PROFILE_NEXT(stepZone, "step.fallingPlatforms");
+        for (ActiveFallingPlatform& falling : world.fallingPlatforms) {
+            if (falling.fallen || tiles.size() <= falling.bodyIndex) continue;
+
+            phys::PlatformBody& current_body = world.bodies[falling.bodyIndex];
+            Tile& current_tile = tiles[falling.bodyIndex];
+
+            if (!falling.falling && !current_body.isFalling() && falling.delayTimer == sf::Time::Zero) {
+                bool playerOnThis = playerBody.isOnGround() && playerBody.getGroundPlatform() == &current_body;
+                if (playerOnThis) falling.delayTimer = sf::seconds(0.5f);
+            }
+            if (falling.delayTimer > sf::Time::Zero) {
+                falling.delayTimer -= timePerFixedUpdate;
+                if (falling.delayTimer <= sf::Time::Zero) falling.falling = true;
+            }
+            if (!falling.falling) continue;
+
+            current_body.setFalling(true);
+            current_body.setPosition(current_body.getPosition() + sf::Vector2f(0.f, FALLING_PLATFORM_SPEED * fixed_dt_seconds));
+            current_tile.setPosition(current_body.getPosition());
+
+            if (current_body.getPosition().y > falling.cutoffY) {
+                falling.falling = false;
+                falling.fallen = true;
+                if (playerBody.getGroundPlatform() == &current_body) {
+                    playerBody.setOnGround(false);
+                    playerBody.setGroundPlatform(nullptr);
+                }
+                current_body.setPosition({-9999.f, -9999.f});
+                current_body.setType(phys::bodyType::none);
+                current_tile.setHidden(true);
+            }
+        }
+
+        // --- Update Platform States (Vanishing) ---
+        T3_PROFILE_NEXT(stepZone, "step.platformStates");
+        // every vanishing platform is at the same point of the same fade, only the way it's going differs
+        const float vanishingPhaseTime = std::fmod(world.vanishingPlatformCycleTimer.asSeconds(), 1.0f);
+        const float fadeInAlpha = math::easing::ease<math::easing::Curve::SineInOut>(vanishingPhaseTime, 0.f, 255.f, 1.f);
+        const sf::Color baseVanishingColor = getTileColorForBodyType(phys::bodyType::vanishing);
+        for (size_t i_body = 0; i_body < world.bodies.size(); ++i_body) {
+            if (tiles.size() <= i_body) continue;
+
+            phys::PlatformBody& current_body = world.bodies[i_body];
+            Tile& current_tile = tiles[i_body];
+
+            const phys::bodyType spawnType = current_body.getSpawnType();
+            const sf::Vector2f originalPos = world.getSpawnPosition(i_body);
+
+            if (spawnType == phys::bodyType::vanishing) {
+                bool is_even_id = (current_body.getID() % 2 == 0);
+                bool should_be_fading_out_now = (world.oddEvenVanishing == 1 && is_even_id) || (world.oddEvenVanishing == -1 && !is_even_id);
+
+                const float alpha_val = should_be_fading_out_now ? 255.f - fadeInAlpha : fadeInAlpha;
+                sf::Uint8 finalAlphaByte = static_cast<sf::Uint8>(alpha_val);
+
+                if (alpha_val <= 10.f) {
+                    if (current_body.getType() != phys::bodyType::none) {
+                        if (playerBody.getGroundPlatform() == &current_body) {
+                            playerBody.setOnGround(false);
+                            playerBody.setGroundPlatform(nullptr);
+                        }
+                        current_body.setType(phys::bodyType::none);
+                    }
+                    if (current_body.getPosition() != sf::Vector2f(-9999.f, -9999.f)) current_body.setPosition({-9999.f, -9999.f});
+                    if (current_tile.getPosition() != sf::Vector2f(-9999.f, -9999.f)) current_tile.setPosition({-9999.f, -9999.f});
+                    finalAlphaByte = 0;
+                } else {
+                    if (current_body.getType() == phys::bodyType::none) {
+                        current_body.setType(phys::bodyType::vanishing);
+                    }
+                    if (current_body.getPosition() != originalPos) current_body.setPosition(originalPos);
+                    if (current_tile.getPosition() != originalPos) current_tile.setPosition(originalPos);
+                }
+                current_tile.setFillColor(sf::Color(baseVanishingColor.r, baseVanishingColor.g, baseVanishingColor.b, finalAlphaByte));
+            }
+        }
+
+        world.vanishingPlatformCycleTimer += timePerFixedUpdate;
+        if (world.vanishingPlatformCycleTimer.asSeconds() >= 1.0f) {
+            world.vanishingPlatformCycleTimer -= sf::seconds(1.0f);
+            world.oddEvenVanishing *= -1;
+        }
+
+        // --- Player Velocity Update ---
+        T3_PROFILE_NEXT(stepZone, "step.playerVelocity");
+        sf::Vector2f pVel = playerBody.getVelocity();
+        pVel.x = horizontalInput * PLAYER_MOVE_SPEED * static_cast<float>(turboMultiplier);
+
+        if (!playerBody.isOnGround()) {
+            pVel.y += GRAVITY_ACCELERATION * fixed_dt_seconds;
+            pVel.y = std::min(pVel.y, MAX_FALL_SPEED);
+        }
+
+        if (newJumpPressThisFrame) {
+            pVel.y = JUMP_INITIAL_VELOCITY;
+            currentJumpHoldDuration = sf::microseconds(1);
+        } else if (jumpIntentThisFrame && currentJumpHoldDuration > sf::Time::Zero && currentJumpHoldDuration < MAX_JUMP_HOLD_TIME) {
+            const phys::PlatformBody* groundPlatForJumpExtend = playerBody.getGroundPlatform();
+            if (playerBody.getVelocity().y < 0.f && (!isWorldBody(groundPlatForJumpExtend) || groundPlatForJumpExtend->getType() != phys::bodyType::spring) ) {
+                 pVel.y = JUMP_INITIAL_VELOCITY;
+            }
+            currentJumpHoldDuration += timePerFixedUpdate;
+        } else {
+            currentJumpHoldDuration = sf::Time::Zero;
+        }
+        playerBody.setVelocity(pVel);
+
+        // --- Collision Resolution ---
+        T3_PROFILE_NEXT(stepZone, "step.collision");
+        phys::CollisionResolutionInfo resolutionResult = phys::CollisionSystem::resolveCollisions(playerBody, world.bodies, fixed_dt_seconds);
+        lastCollision = resolutionResult;
+        pVel = playerBody.getVelocity();
+
+        // --- Post-Collision Player Logic ---
+        T3_PROFILE_NEXT(stepZone, "step.postCollision");
+        if (playerBody.isOnGround()) {
+            currentJumpHoldDuration = sf::Time::Zero;
+            const phys::PlatformBody* currentGroundPlatform = playerBody.getGroundPlatform();
+
+            if (currentGroundPlatform) {
+                if (isWorldBody(currentGroundPlatform)) {
+                    const phys::PlatformBody& pf = *currentGroundPlatform;
+                    if (pf.getType() == phys::bodyType::conveyorBelt) {
+                        playerBody.setPosition(playerBody.getPosition() + pf.getSurfaceVelocity() * fixed_dt_seconds);
+                    } else if (pf.getType() == phys::bodyType::moving) {
+                         for(const auto& activePlat : world.movingPlatforms) {
+                            if (&world.bodies[activePlat.bodyIndex] == &pf) {
+                                sf::Vector2f platformFrameDisplacement = pf.getPosition() - activePlat.lastFrameActualPosition;
+                                playerBody.setPosition(playerBody.getPosition() + platformFrameDisplacement);
+                                break;
+                            }
+                        }
+                    } else if (pf.getType() == phys::bodyType::spring) {
+                        pVel.y = SPRING_BOUNCE_VELOCITY;
+                        playerBody.setOnGround(false);
+                        playerBody.setGroundPlatform(nullptr);
+                        emitSimEvent("spring");
+                    }
+                } else {
+                     playerBody.setOnGround(false);
+                     playerBody.setGroundPlatform(nullptr);
+                }
+            }
+        }
 
-    playerShape.setFillColor(sf::Color(220, 220, 250, 255));
-    playerShape.setSize(sf::Vector2f(playerBody.getWidth(), playerBody.getHeight()));
+        if (resolutionResult.hitCeiling && pVel.y < 0.f) {
+            pVel.y = 0.f;
+            currentJumpHoldDuration = MAX_JUMP_HOLD_TIME;
+        }
+        playerBody.setVelocity(pVel);
+
+        // --- Trap Check ---
+        T3_PROFILE_NEXT(stepZone, "step.triggers");
+        bool trapHit = false;
+        for (const auto& body_check_trap : world.bodies) {
+            if (body_check_trap.getType() == phys::bodyType::trap && body_check_trap.getAABB().intersects(playerBody.getAABB())) {
+                trapHit = true;
+                break;
+            }
+        }
+        if (trapHit) {
+            emitSimEvent("death", SimOutcome::HitTrap);
+            return false;
+        }
 
-    debugText.setFont(menuFont);
-    debugText.setCharacterSize(14);
-    debugText.setFillColor(sf::Color::White);
-    debugText.setPosition(10.f, 10.f);
+        // --- Interaction (Goal, Portal, Interactibles) ---
+        if (interactThisStep) {
+            for (const auto& platform_body_check_goal : world.bodies) {
+                if (platform_body_check_goal.getType() == phys::bodyType::goal && playerBody.getAABB().intersects(platform_body_check_goal.getAABB())) {
+                    emitSimEvent("goal", SimOutcome::ReachedGoal);
+                    return false;
+                }
+            }
 
-    menuMusic.setVolume(gameSettings.musicVolume);
-    gameMusic.setVolume(gameSettings.musicVolume);
-    if (menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) {
-        menuMusic.play();
+            for (const auto& current_portal_body : world.bodies) {
+                if (current_portal_body.getType() == phys::bodyType::portal && playerBody.getAABB().intersects(current_portal_body.getAABB())) {
+
+                    unsigned int source_body_id = current_portal_body.getID();
+                    unsigned int portal_link_id = current_portal_body.getPortalID();
+                    sf::Vector2f exit_offset_from_this_portal = current_portal_body.getTeleportOffset();
+
+                    if (portal_link_id == 0) {
+                        continue;
+                    }
+
+                    const phys::PlatformBody* target_portal_body_ptr = nullptr;
+                    for (const auto& potential_target_body : world.bodies) {
+                        if (potential_target_body.getType() == phys::bodyType::portal &&
+                            potential_target_body.getPortalID() == portal_link_id &&
+                            potential_target_body.getID() != source_body_id) {
+                            target_portal_body_ptr = &potential_target_body;
+                            break;
+                        }
+                    }
+
+                    if (target_portal_body_ptr) {
+                        sf::Vector2f target_portal_position = target_portal_body_ptr->getPosition();
+                        sf::Vector2f new_player_position = target_portal_position + exit_offset_from_this_portal;
+
+                        new_player_position.x += (target_portal_body_ptr->getWidth() / 2.f) - (playerBody.getWidth() / 2.f);
+                        new_player_position.y += (target_portal_body_ptr->getHeight() / 2.f) - (playerBody.getHeight() / 2.f);
+
+                        playerBody.setPosition(new_player_position);
+                        playerBody.setVelocity({0.f, 0.f});
+                        playerBody.setLastPosition(new_player_position);
+
+                        emitSimEvent("portal");
+                        goto end_fixed_update_for_interaction;
+                    }
+                }
+            }
+
+            for (size_t k = 0; k < world.bodies.size(); ++k) {
+                phys::PlatformBody& interact_body_ref = world.bodies[k];
+                if (interact_body_ref.getType() != phys::bodyType::goal &&
+                    interact_body_ref.getType() != phys::bodyType::portal &&
+                    interact_body_ref.getType() == phys::bodyType::interactible &&
+                    playerBody.getAABB().intersects(interact_body_ref.getAABB())) {
+
+                    auto it = world.interactibles.find(interact_body_ref.getID());
+                    if (it != world.interactibles.end()) {
+                        ActiveInteractiblePlatform& interactState = it->second;
+                        const LevelData::InteractiblePlatformInfo& interaction = *interactState.info;
+                        if (interactState.currentCooldownTimer > 0.f || (interaction.oneTime && interactState.hasBeenInteractedThisSession)) {
+                            continue;
+                        }
+
+                        if (interaction.interaction == LevelData::InteractiblePlatformInfo::Interaction::changeSelf) {
+                            emitSimEvent("click");
+                            interact_body_ref.setType(interaction.targetBodyType);
+
+                            if (tiles.size() > k) {
+                                if (interaction.hasTargetTileColor) {
+                                    tiles[k].setFillColor(interaction.targetTileColor);
+                                } else {
+                                    tiles[k].setFillColor(getTileColorForBodyType(interaction.targetBodyType));
+                                }
+                            }
+
+                            if (interaction.targetBodyType == phys::bodyType::none) {
+                                if (playerBody.getGroundPlatform() == &interact_body_ref) {
+                                    playerBody.setOnGround(false);
+                                    playerBody.setGroundPlatform(nullptr);
+                                }
+                                interact_body_ref.setPosition({-10000.f, -10000.f});
+                                if (tiles.size() > k) tiles[k].setFillColor(sf::Color::Transparent);
+                            }
+
+                            if (interaction.linkedID != 0) {
+                                std::size_t linked_idx = world.findBodyIndex(interaction.linkedID);
+                                if (linked_idx != LevelTemplate::npos) {
+                                        phys::PlatformBody& linked_body_ref = world.bodies[linked_idx];
+                                        Tile& linked_tile_ref = tiles[linked_idx];
+
+                                        if (linked_body_ref.getType() == phys::bodyType::solid || linked_body_ref.getType() == phys::bodyType::platform ) {
+                                            if (playerBody.getGroundPlatform() == &linked_body_ref) {
+                                                playerBody.setOnGround(false);
+                                                playerBody.setGroundPlatform(nullptr);
+                                            }
+                                            linked_body_ref.setType(phys::bodyType::none);
+                                            linked_body_ref.setPosition({-10000.f, -10000.f});
+                                            linked_tile_ref.setFillColor(sf::Color::Transparent);
+                                            linked_tile_ref.setPosition({-10000.f, -10000.f});
+
+                                        } else if (linked_body_ref.getType() == phys::bodyType::none) {
+                                            const sf::Vector2f originalLinkedPos = world.getSpawnPosition(linked_idx);
+                                            phys::bodyType originalLinkedType = linked_body_ref.getSpawnType();
+
+                                            linked_body_ref.setPosition(originalLinkedPos);
+                                            linked_body_ref.setType(originalLinkedType);
+                                            linked_tile_ref.setPosition(originalLinkedPos);
+                                            linked_tile_ref.setFillColor(getTileColorForBodyType(originalLinkedType));
+                                        } else if (linked_body_ref.getType() != phys::bodyType::portal &&
+                                                   interaction.targetBodyType == phys::bodyType::portal &&
+                                                   linked_body_ref.getID() == interaction.linkedID) {
+                                            const sf::Vector2f originalLinkedPos = world.getSpawnPosition(linked_idx);
+                                            linked_body_ref.setPosition(originalLinkedPos);
+                                            linked_body_ref.setType(phys::bodyType::portal);
+                                            linked_tile_ref.setPosition(originalLinkedPos);
+                                            linked_tile_ref.setFillColor(getTileColorForBodyType(phys::bodyType::portal));
+                                        }
+                                }
+                            }
+
+
+                            if (interaction.oneTime) interactState.hasBeenInteractedThisSession = true;
+                            else interactState.currentCooldownTimer = interaction.cooldown;
+                            goto end_fixed_update_for_interaction;
+                        }
+                    }
+                }
+            }
+        }
+        end_fixed_update_for_interaction:;
+
+        // --- Death by Falling ---
+        T3_PROFILE_NEXT(stepZone, "step.publish");
+        bool fellOutOfLevel = levelStreamer.isActive() ? levelStreamer.isBelowDeathRow(playerBody.getPosition())
+                                                       : playerBody.getPosition().y > PLAYER_DEATH_Y_LIMIT;
+        if (fellOutOfLevel) {
+            emitSimEvent("death", SimOutcome::FellOut);
+            return false;
+        }
+
+        ++simTick;
+        publishSimFrame();
+        return true;
+    };
+
+    auto handleSimOutcome = [&](SimOutcome outcome) {
+        switch (outcome) {
+            case SimOutcome::HitTrap:
+            case SimOutcome::FellOut:
+                currentState = outcome == SimOutcome::HitTrap ? GameState::GAME_OVER_LOSE_DEATH : GameState::GAME_OVER_LOSE_FALL;
+                if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.pause();
+                if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
+                break;
+            case SimOutcome::ReachedGoal:
+                if (levelManager.hasNextLevel()) {
+                    if (levelManager.requestLoadNextLevel(currentLevel)) {
+                        currentState = GameState::TRANSITIONING;
+                    } else {
+                        currentState = GameState::MENU;
+                        if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
+                        if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
+                    }
+                } else {
+                    currentState = GameState::GAME_OVER_WIN;
+                    if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
+                    if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
+                }
+                break;
+            case SimOutcome::None:
+                break;
+        }
+    };
+
+    // golden check: every replay starts from the same state, whatever ran before it
+    auto resetGoldenRun = [&]() {
+        timePerFixedUpdate = sf::seconds(1.f / static_cast<float>(gameSettings.tickRate));
+        currentJumpHoldDuration = sf::Time::Zero;
+        turboMultiplier = 1;
+    };
+
+    if (!goldenDir.empty()) return runGoldenCheck(stepSimulation, resetGoldenRun, window);
+    if (headless) return runScenarioBench(stepSimulation, window);
+
+    if (gameSettings.simulationThread) {
+        simThread.setMeasureJitter(gameSettings.measureLatency);
+        simThread.start(stepSimulation);
     }
+    T3_LOG_INFO("Simulation: {} Hz {}{}", gameSettings.tickRate, gameSettings.simulationThread ? "on its own thread" : "inline",
+                gameSettings.measureLatency ? ", measuring latency" : "");
 
     // --- MAIN GAME LOOP ---
     while (running) {
-        interactKeyPressedThisFrame = false;
+        // Limited pacing sleeps here, right before the input is read
+        framePacer.waitForFrameStart();
         sf::Time frameDeltaTime = gameClock.restart();
+        perfHud.addFrameTime(frameDeltaTime.asMicroseconds() / 1000.f);
+        // everything allocated since the last frame started, HUD included
+        const AllocationTracker::Counts allocationTotal = AllocationTracker::total();
+        frameAllocations = allocationTotal - lastAllocationTotal;
+        lastAllocationTotal = allocationTotal;
 
         // --- Event Handling ---
+        T3_PROFILE_ZONE(frameZone, "frame.events");
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
@@ -523,16 +1765,25 @@ int main(void) {
             }
              if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
                 if(currentState == GameState::PLAYING && levelManager.hasNextLevel()){
-                     if(levelManager.requestLoadNextLevel(currentLevelData)){
+                     if(levelManager.requestLoadNextLevel(currentLevel)){
                         currentState = GameState::TRANSITIONING;
                         playSfx("goal");
                     }
                 } else if (currentState == GameState::PLAYING && !levelManager.hasNextLevel()) {
                     currentState = GameState::GAME_OVER_WIN;
                     if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-                    if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
+                    if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
                 }
             }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                perfHud.toggle();
+                gameSettings.perfHud = perfHud.isVisible();
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9) {
+                // the last few seconds of every thread's zones, open in ui.perfetto.dev or chrome://tracing
+                if (Profiler::isCompiledIn()) Profiler::writeChromeTrace("t3trace-" + std::to_string(std::time(nullptr)) + ".json", PROFILE_DUMP_SECONDS);
+                else T3_LOG_INFO("Profiler: not built in, configure with -DT3_PROFILER=ON");
+            }
 
             sf::Vector2i pixelPos = sf::Mouse::getPosition(window);
             sf::Vector2f worldPosUi = window.mapPixelToCoords(pixelPos, uiView);
@@ -543,13 +1794,13 @@ int main(void) {
                         playSfx("click");
                         if (startButtonText.getGlobalBounds().contains(worldPosUi)) {
                             levelManager.setCurrentLevelNumber(0);
-                            if (levelManager.requestLoadNextLevel(currentLevelData)) {
+                            if (levelManager.requestLoadNextLevel(currentLevel)) {
                                 currentState = GameState::TRANSITIONING;
                                 if(menuMusic.getStatus() == sf::Music::Playing) menuMusic.stop();
-                                if(gameMusic.getStatus() != sf::Music::Playing && gameMusic.openFromFile(AUDIO_MUSIC_GAME)) {
+                                if(gameMusic.getStatus() != sf::Music::Playing && assetPack.openStream(gameMusic, AUDIO_MUSIC_GAME)) {
                                      gameMusic.setVolume(gameSettings.musicVolume); gameMusic.play();
                                 }
-                            } else { std::cerr << "MENU: Failed request to load initial level." << std::endl; }
+                            } else { T3_LOG_ERROR("MENU: Failed request to load initial level."); }
                         } else if (settingsButtonText.getGlobalBounds().contains(worldPosUi)) {
                             currentState = GameState::SETTINGS;
                             updateResolutionDisplayText();
@@ -587,6 +1838,16 @@ int main(void) {
                         } else if (fullscreenToggleText.getGlobalBounds().contains(worldPosUi)) {
                             isFullscreen = !isFullscreen;
                             applyAndRecreateWindow(window, uiView, mainView); updateResolutionDisplayText();
+                        } else if (tickRateDownText.getGlobalBounds().contains(worldPosUi) || tickRateUpText.getGlobalBounds().contains(worldPosUi)) {
+                            const int count = static_cast<int>(std::size(TICK_RATES));
+                            int index = static_cast<int>(std::find(std::begin(TICK_RATES), std::end(TICK_RATES), gameSettings.tickRate) - std::begin(TICK_RATES));
+                            index = (index + (tickRateUpText.getGlobalBounds().contains(worldPosUi) ? 1 : count - 1)) % count;
+                            gameSettings.tickRate = TICK_RATES[index];
+                            timePerFixedUpdate = sf::seconds(1.f / static_cast<float>(gameSettings.tickRate));
+                        } else if (pacingDownText.getGlobalBounds().contains(worldPosUi) || pacingUpText.getGlobalBounds().contains(worldPosUi)) {
+                            const int count = static_cast<int>(std::size(FRAME_PACING_OPTIONS));
+                            gameSettings.framePacing = (gameSettings.framePacing + (pacingUpText.getGlobalBounds().contains(worldPosUi) ? 1 : count - 1)) % count;
+                            applyFramePacing(window);
                         }
                      }
                      if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) currentState = GameState::MENU;
@@ -599,18 +1860,22 @@ int main(void) {
                     if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) currentState = GameState::MENU;
                     break;
                 case GameState::PLAYING:
+                    // the simulation only sees the keyboard through the queue. Full means it's stalled, the key is lost
+                    if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) {
+                        inputQueue.push({LatencyStats::nowMicros(), event.key.code, event.type == sf::Event::KeyPressed});
+                    } else if (event.type == sf::Event::LostFocus) {
+                        inputQueue.push({LatencyStats::nowMicros(), sf::Keyboard::Unknown, false});
+                    }
                     if (event.type == sf::Event::KeyPressed) {
                         if (event.key.code == sf::Keyboard::Escape) {
                             currentState = GameState::MENU;
                             if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.pause();
-                            if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
+                            if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
                         } else if (event.key.code == sf::Keyboard::R) {
                             playSfx("click");
-                            if (levelManager.requestRespawnCurrentLevel(currentLevelData)) {
+                            if (levelManager.requestRespawnCurrentLevel(currentLevel)) {
                                 currentState = GameState::TRANSITIONING;
-                            } else {std::cerr << "PLAYING: Failed respawn request.\n";}
-                        } else if (event.key.code == sf::Keyboard::E) {
-                            interactKeyPressedThisFrame = true;
+                            } else { T3_LOG_ERROR("PLAYING: Failed respawn request."); }
                         }
                     }
                     break;
@@ -621,49 +1886,49 @@ int main(void) {
                         playSfx("click");
                         if (gameOverOption1Text.getGlobalBounds().contains(worldPosUi)) {
                             if (currentState == GameState::GAME_OVER_LOSE_FALL || currentState == GameState::GAME_OVER_LOSE_DEATH) {
-                                if (levelManager.requestRespawnCurrentLevel(currentLevelData)) {
+                                if (levelManager.requestRespawnCurrentLevel(currentLevel)) {
                                     currentState = GameState::TRANSITIONING;
                                     if(menuMusic.getStatus() == sf::Music::Playing) menuMusic.stop();
-                                    if(gameMusic.getStatus() != sf::Music::Playing && gameMusic.openFromFile(AUDIO_MUSIC_GAME)) {
+                                    if(gameMusic.getStatus() != sf::Music::Playing && assetPack.openStream(gameMusic, AUDIO_MUSIC_GAME)) {
                                          gameMusic.setVolume(gameSettings.musicVolume); gameMusic.play();
                                     }
                                 } else {
                                     currentState = GameState::MENU;
                                     if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-                                    if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
+                                    if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
                                     levelManager.setCurrentLevelNumber(0);
                                 }
                             } else if (currentState == GameState::GAME_OVER_WIN) {
                                 levelManager.setCurrentLevelNumber(0);
-                                if (levelManager.requestLoadNextLevel(currentLevelData)) {
+                                if (levelManager.requestLoadNextLevel(currentLevel)) {
                                     currentState = GameState::TRANSITIONING;
                                     if(menuMusic.getStatus() == sf::Music::Playing) menuMusic.stop();
-                                    if(gameMusic.getStatus() != sf::Music::Playing && gameMusic.openFromFile(AUDIO_MUSIC_GAME)) {
+                                    if(gameMusic.getStatus() != sf::Music::Playing && assetPack.openStream(gameMusic, AUDIO_MUSIC_GAME)) {
                                          gameMusic.setVolume(gameSettings.musicVolume); gameMusic.play();
                                     }
                                 } else {
                                     currentState = GameState::MENU;
-                                    if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
+                                    if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
                                 }
                             }
                         } else if (gameOverOption2Text.getGlobalBounds().contains(worldPosUi)) {
                             currentState = GameState::MENU;
                             if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-                            if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
+                            if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
                             levelManager.setCurrentLevelNumber(0);
                         }
                     }
                      if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
                         currentState = GameState::MENU;
                         if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-                        if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
+                        if(menuMusic.getStatus() != sf::Music::Playing && assetPack.openStream(menuMusic, AUDIO_MUSIC_MENU)) menuMusic.play();
                         levelManager.setCurrentLevelNumber(0);
                      }
                     break;
                 case GameState::TRANSITIONING:
                     break;
                 default:
-                    std::cerr << "Warning: Unhandled GameState in event loop: " << static_cast<int>(currentState) << std::endl;
+                    T3_LOG_WARNING("Warning: Unhandled GameState in event loop: {}", currentState);
                     currentState = GameState::MENU;
                     break;
             }
@@ -672,479 +1937,84 @@ int main(void) {
         if (!running) break;
 
         timeSinceLastFixedUpdate += frameDeltaTime;
+        // after a stall (or time spent in the menus) don't try to catch up on all of it, that only makes the
+        // next frame slower still. Anything past the cap is dropped, the game just runs slow for a moment.
+        const sf::Time maxBacklog = timePerFixedUpdate * static_cast<sf::Int64>(gameSettings.maxStepsPerFrame);
+        if (timeSinceLastFixedUpdate > maxBacklog) {
+            droppedSimTime += timeSinceLastFixedUpdate - maxBacklog;
+            timeSinceLastFixedUpdate = maxBacklog;
+        }
 
         // --- Game Logic Update ---
+        T3_PROFILE_NEXT(frameZone, "frame.update");
         if (currentState == GameState::PLAYING) {
-            playerShape.setSize(sf::Vector2f(playerBody.getWidth(), playerBody.getHeight()));
-
-            while (timeSinceLastFixedUpdate >= TIME_PER_FIXED_UPDATE) {
-                timeSinceLastFixedUpdate -= TIME_PER_FIXED_UPDATE;
-                const float fixed_dt_seconds = TIME_PER_FIXED_UPDATE.asSeconds();
-
-                playerBody.setLastPosition(playerBody.getPosition());
-
-                // --- Handle Input for Player ---
-                float horizontalInput = 0.f;
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) || sf::Keyboard::isKeyPressed(sf::Keyboard::RShift)) turboMultiplier = 2;
-                else turboMultiplier = 1;
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) horizontalInput = -1.f;
-                else if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) horizontalInput = 1.f;
-
-                bool jumpIntentThisFrame = (sf::Keyboard::isKeyPressed(sf::Keyboard::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::Space));
-                bool dropIntentThisFrame = (sf::Keyboard::isKeyPressed(sf::Keyboard::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Down));
-                bool newJumpPressThisFrame = (jumpIntentThisFrame && playerBody.isOnGround() && currentJumpHoldDuration == sf::Time::Zero);
-
-                if (newJumpPressThisFrame && !playerBody.getGroundPlatformTemporarilyIgnored()) {
-                    const phys::PlatformBody* groundPlat = playerBody.getGroundPlatform();
-                    bool safeToAccessGroundPlat = false;
-                    if (groundPlat) {
-                        for (const auto& body_ref : bodies) { if (&body_ref == groundPlat) { safeToAccessGroundPlat = true; break; } }
-                    }
-                    if (!safeToAccessGroundPlat || groundPlat->getType() != phys::bodyType::spring) {
-                         playSfx("jump");
-                    }
-                }
-                playerBody.setTryingToDrop(dropIntentThisFrame && playerBody.isOnGround());
-
-                // --- Update Moving Platforms ---
-                for(auto& activePlat : activeMovingPlatforms) {
-                    phys::PlatformBody* movingBodyPtr = nullptr; size_t tileIdx = (size_t)-1;
-                    for(size_t i_plat=0; i_plat < bodies.size(); ++i_plat) {
-                        if(bodies[i_plat].getID() == activePlat.id && bodies[i_plat].getType() == phys::bodyType::moving) {
-                            movingBodyPtr = &bodies[i_plat];
-                            tileIdx = i_plat;
-                            break;
-                        }
-                    }
-
-                    if (movingBodyPtr) {
-                        activePlat.lastFrameActualPosition = movingBodyPtr->getPosition();
-                        activePlat.cycleTime += fixed_dt_seconds;
-                        float effectiveCycleDur = activePlat.cycleDuration > 1e-5f ? activePlat.cycleDuration : 1.f;
-                        activePlat.cycleTime = std::fmod(activePlat.cycleTime, effectiveCycleDur);
-
-                        float singleMovePhaseDur = effectiveCycleDur / 2.0f;
-                        float offset = 0.f;
-                        if (singleMovePhaseDur > 1e-5f) {
-                            float currentPhaseTime = activePlat.cycleTime;
-                            if (currentPhaseTime < singleMovePhaseDur) {
-                                offset = math::easing::sineEaseInOut(currentPhaseTime, 0.f, activePlat.initialDirection * activePlat.distance, singleMovePhaseDur);
-                            } else {
-                                currentPhaseTime -= singleMovePhaseDur;
-                                offset = math::easing::sineEaseInOut(currentPhaseTime, activePlat.initialDirection * activePlat.distance, -(activePlat.initialDirection * activePlat.distance), singleMovePhaseDur);
-                            }
-                        }
-                        sf::Vector2f newPos = activePlat.movementAnchorPosition;
-                        if(activePlat.axis == 'x') newPos.x += offset;
-                        else if(activePlat.axis == 'y') newPos.y += offset;
-
-                        movingBodyPtr->setPosition(newPos);
-                        if (tileIdx < tiles.size()) {
-                            tiles[tileIdx].setPosition(newPos);
-                        }
-                    }
-                }
-
-                // --- Update Interactible Cooldowns ---
-                for (auto& pair : activeInteractibles) {
-                    ActiveInteractiblePlatform& interactible = pair.second;
-                    if (interactible.currentCooldownTimer > 0.f) {
-                        interactible.currentCooldownTimer -= fixed_dt_seconds;
-                        if (interactible.currentCooldownTimer < 0.f) interactible.currentCooldownTimer = 0.f;
-                    }
-                }
-
-                // --- Update Platform States (Falling, Vanishing) ---
-                for (size_t i_body = 0; i_body < bodies.size(); ++i_body) {
-                    if (tiles.size() <= i_body) continue;
-
-                    phys::PlatformBody& current_body = bodies[i_body];
-                    Tile& current_tile = tiles[i_body];
-
-                    const phys::PlatformBody* template_body_ptr = nullptr;
-                    sf::Vector2f originalPos = {-9999.f, -9999.f};
-
-                    for(const auto& templ : currentLevelData.platforms) {
-                        if(templ.getID() == current_body.getID()){
-                            template_body_ptr = &templ;
-                            originalPos = templ.getPosition();
-                            break;
-                        }
-                    }
-
-                    if (!template_body_ptr) {
-                        continue;
-                    }
-
-                    if (template_body_ptr->getType() == phys::bodyType::falling) {
-                        if (!current_body.isFalling()) {
-                              bool playerOnThis = playerBody.isOnGround() && playerBody.getGroundPlatform() == &current_body;
-                              if (playerOnThis && !current_tile.isFalling() && !current_tile.hasFallen()) {
-                                  current_tile.startFalling(sf::seconds(0.5f));
-                              }
-                        }
-
-                        current_tile.update(TIME_PER_FIXED_UPDATE);
-
-                        if (current_tile.isFalling() && !current_body.isFalling()) {
-                            current_body.setFalling(true);
-                        }
-                        if (current_tile.isFalling() && current_body.isFalling()) {
-                            current_body.setPosition(current_tile.getPosition());
-                        }
-
-                        if (current_tile.hasFallen() && current_body.getType() != phys::bodyType::none) {
-                            if (playerBody.getGroundPlatform() == &current_body) {
-                                playerBody.setOnGround(false);
-                                playerBody.setGroundPlatform(nullptr);
-                            }
-                            current_body.setPosition({-9999.f, -9999.f});
-                            current_body.setType(phys::bodyType::none);
-                            current_tile.setFillColor(sf::Color::Transparent);
-                        }
-                    }
-                    else if (template_body_ptr->getType() == phys::bodyType::vanishing) {
-                        bool is_even_id = (current_body.getID() % 2 == 0);
-                        bool should_be_fading_out_now = (oddEvenVanishing == 1 && is_even_id) || (oddEvenVanishing == -1 && !is_even_id);
-
-                        float phaseTime = std::fmod(vanishingPlatformCycleTimer.asSeconds(), 1.0f);
-                        sf::Color baseVanishingColor = getTileColorForBodyType(phys::bodyType::vanishing);
-                        float alpha_val;
-
-                        if (should_be_fading_out_now) {
-                            alpha_val = math::easing::sineEaseInOut(phaseTime, 255.f, -255.f, 1.f);
-                        } else {
-                            alpha_val = math::easing::sineEaseInOut(phaseTime, 0.f, 255.f, 1.f);
-                        }
-                        alpha_val = std::max(0.f, std::min(255.f, alpha_val));
-                        sf::Uint8 finalAlphaByte = static_cast<sf::Uint8>(alpha_val);
-
-                        if (alpha_val <= 10.f) {
-                            if (current_body.getType() != phys::bodyType::none) {
-                                if (playerBody.getGroundPlatform() == &current_body) {
-                                    playerBody.setOnGround(false);
-                                    playerBody.setGroundPlatform(nullptr);
-                                }
-                                current_body.setType(phys::bodyType::none);
-                            }
-                            if (current_body.getPosition() != sf::Vector2f(-9999.f, -9999.f)) current_body.setPosition({-9999.f, -9999.f});
-                            if (current_tile.getPosition() != sf::Vector2f(-9999.f, -9999.f)) current_tile.setPosition({-9999.f, -9999.f});
-                            finalAlphaByte = 0;
-                        } else {
-                            if (current_body.getType() == phys::bodyType::none) {
-                                current_body.setType(phys::bodyType::vanishing);
-                            }
-                            if (originalPos.x > -9998.f) {
-                                if (current_body.getPosition() != originalPos) current_body.setPosition(originalPos);
-                                if (current_tile.getPosition() != originalPos) current_tile.setPosition(originalPos);
-                            } else {
-                                if (current_body.getType() != phys::bodyType::none) current_body.setType(phys::bodyType::none);
-                                if(current_body.getPosition() != sf::Vector2f(-9999.f, -9999.f)) current_body.setPosition({-9999.f, -9999.f});
-                                if(current_tile.getPosition() != sf::Vector2f(-9999.f, -9999.f)) current_tile.setPosition({-9999.f, -9999.f});
-                                finalAlphaByte = 0;
-                            }
-                        }
-                        current_tile.setFillColor(sf::Color(baseVanishingColor.r, baseVanishingColor.g, baseVanishingColor.b, finalAlphaByte));
-                    }
-                }
-
-                vanishingPlatformCycleTimer += TIME_PER_FIXED_UPDATE;
-                if (vanishingPlatformCycleTimer.asSeconds() >= 1.0f) {
-                    vanishingPlatformCycleTimer -= sf::seconds(1.0f);
-                    oddEvenVanishing *= -1;
-                }
-
-                // --- Player Velocity Update ---
-                sf::Vector2f pVel = playerBody.getVelocity();
-                pVel.x = horizontalInput * PLAYER_MOVE_SPEED * static_cast<float>(turboMultiplier);
-
-                if (!playerBody.isOnGround()) {
-                    pVel.y += GRAVITY_ACCELERATION * fixed_dt_seconds;
-                    pVel.y = std::min(pVel.y, MAX_FALL_SPEED);
-                }
-
-                if (newJumpPressThisFrame) {
-                    pVel.y = JUMP_INITIAL_VELOCITY;
-                    currentJumpHoldDuration = sf::microseconds(1);
-                } else if (jumpIntentThisFrame && currentJumpHoldDuration > sf::Time::Zero && currentJumpHoldDuration < MAX_JUMP_HOLD_TIME) {
-                    const phys::PlatformBody* groundPlatForJumpExtend = playerBody.getGroundPlatform();
-                    bool safeToAccessGroundPlatForJumpExtend = false;
-                    if(groundPlatForJumpExtend){
-                        for(const auto& body_ref : bodies){ if(&body_ref == groundPlatForJumpExtend){ safeToAccessGroundPlatForJumpExtend = true; break; } }
-                    }
-                    if (playerBody.getVelocity().y < 0.f && (!safeToAccessGroundPlatForJumpExtend || groundPlatForJumpExtend->getType() != phys::bodyType::spring) ) {
-                         pVel.y = JUMP_INITIAL_VELOCITY;
-                    }
-                    currentJumpHoldDuration += TIME_PER_FIXED_UPDATE;
-                } else {
-                    currentJumpHoldDuration = sf::Time::Zero;
-                }
-                playerBody.setVelocity(pVel);
-
-                // --- Collision Resolution ---
-                phys::CollisionResolutionInfo resolutionResult = phys::CollisionSystem::resolveCollisions(playerBody, bodies, fixed_dt_seconds);
-                pVel = playerBody.getVelocity();
-
-                // --- Post-Collision Player Logic ---
-                if (playerBody.isOnGround()) {
-                    currentJumpHoldDuration = sf::Time::Zero;
-                    const phys::PlatformBody* currentGroundPlatform = playerBody.getGroundPlatform();
-
-                    if (currentGroundPlatform) {
-                        bool safeToAccessCurrentGroundPlatform = false;
-                        for (const auto& body_ref : bodies) { if (&body_ref == currentGroundPlatform) { safeToAccessCurrentGroundPlatform = true; break; } }
-
-                        if (safeToAccessCurrentGroundPlatform) {
-                            const phys::PlatformBody& pf = *currentGroundPlatform;
-                            if (pf.getType() == phys::bodyType::conveyorBelt) {
-                                playerBody.setPosition(playerBody.getPosition() + pf.getSurfaceVelocity() * fixed_dt_seconds);
-                            } else if (pf.getType() == phys::bodyType::moving) {
-                                 for(const auto& activePlat : activeMovingPlatforms) {
-                                    if (activePlat.id == pf.getID()) {
-                                        phys::PlatformBody* movingPhysBody = nullptr;
-                                        for(auto& b_ref : bodies) if(b_ref.getID() == activePlat.id && b_ref.getType() == phys::bodyType::moving) {movingPhysBody = &b_ref; break;}
-
-                                        if(movingPhysBody){
-                                            sf::Vector2f platformFrameDisplacement = movingPhysBody->getPosition() - activePlat.lastFrameActualPosition;
-                                            playerBody.setPosition(playerBody.getPosition() + platformFrameDisplacement);
-                                        }
-                                        break;
-                                    }
-                                }
-                            } else if (pf.getType() == phys::bodyType::spring) {
-                                pVel.y = SPRING_BOUNCE_VELOCITY;
-                                playerBody.setOnGround(false);
-                                playerBody.setGroundPlatform(nullptr);
-                                playSfx("spring");
-                            }
-                        } else {
-                             playerBody.setOnGround(false);
-                             playerBody.setGroundPlatform(nullptr);
-                        }
-                    }
-                }
-
-                if (resolutionResult.hitCeiling && pVel.y < 0.f) {
-                    pVel.y = 0.f;
-                    currentJumpHoldDuration = MAX_JUMP_HOLD_TIME;
-                }
-                playerBody.setVelocity(pVel);
-
-                // --- Trap Check ---
-                bool trapHit = false;
-                for (const auto& body_check_trap : bodies) {
-                    if (body_check_trap.getType() == phys::bodyType::trap && body_check_trap.getAABB().intersects(playerBody.getAABB())) {
-                        trapHit = true;
-                        break;
-                    }
-                }
-                if (trapHit) {
-                    playSfx("death");
-                    currentState = GameState::GAME_OVER_LOSE_DEATH;
-                    if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.pause();
-                    if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
-                    break;
-                }
-
-                // --- Interaction (Goal, Portal, Interactibles) ---
-                if (interactKeyPressedThisFrame) {
-                    for (const auto& platform_body_check_goal : bodies) {
-                        if (platform_body_check_goal.getType() == phys::bodyType::goal && playerBody.getAABB().intersects(platform_body_check_goal.getAABB())) {
-                            playSfx("goal");
-                            if (levelManager.hasNextLevel()) {
-                                if (levelManager.requestLoadNextLevel(currentLevelData)) {
-                                    currentState = GameState::TRANSITIONING;
-                                } else {
-                                    currentState = GameState::MENU;
-                                    if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-                                    if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
-                                }
-                            } else {
-                                currentState = GameState::GAME_OVER_WIN;
-                                if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-                                if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
-                            }
-                            goto end_fixed_update_for_interaction;
-                        }
-                    }
-
-                    for (const auto& current_portal_body : bodies) {
-                        if (current_portal_body.getType() == phys::bodyType::portal && playerBody.getAABB().intersects(current_portal_body.getAABB())) {
-
-                            unsigned int source_body_id = current_portal_body.getID();
-                            unsigned int portal_link_id = current_portal_body.getPortalID();
-                            sf::Vector2f exit_offset_from_this_portal = current_portal_body.getTeleportOffset();
-
-                            if (portal_link_id == 0) {
-                                continue;
-                            }
-
-                            const phys::PlatformBody* target_portal_body_ptr = nullptr;
-                            for (const auto& potential_target_body : bodies) {
-                                if (potential_target_body.getType() == phys::bodyType::portal &&
-                                    potential_target_body.getPortalID() == portal_link_id &&
-                                    potential_target_body.getID() != source_body_id) {
-                                    target_portal_body_ptr = &potential_target_body;
-                                    break;
-                                }
-                            }
-
-                            if (target_portal_body_ptr) {
-                                sf::Vector2f target_portal_position = target_portal_body_ptr->getPosition();
-                                sf::Vector2f new_player_position = target_portal_position + exit_offset_from_this_portal;
-
-                                new_player_position.x += (target_portal_body_ptr->getWidth() / 2.f) - (playerBody.getWidth() / 2.f);
-                                new_player_position.y += (target_portal_body_ptr->getHeight() / 2.f) - (playerBody.getHeight() / 2.f);
-
-                                playerBody.setPosition(new_player_position);
-                                playerBody.setVelocity({0.f, 0.f});
-                                playerBody.setLastPosition(new_player_position);
-
-                                playSfx("portal");
-                                goto end_fixed_update_for_interaction;
-                            }
-                        }
-                    }
-
-                    for (size_t k = 0; k < bodies.size(); ++k) {
-                        phys::PlatformBody& interact_body_ref = bodies[k];
-                        if (interact_body_ref.getType() != phys::bodyType::goal &&
-                            interact_body_ref.getType() != phys::bodyType::portal &&
-                            interact_body_ref.getType() == phys::bodyType::interactible &&
-                            playerBody.getAABB().intersects(interact_body_ref.getAABB())) {
-
-                            auto it = activeInteractibles.find(interact_body_ref.getID());
-                            if (it != activeInteractibles.end()) {
-                                ActiveInteractiblePlatform& interactState = it->second;
-                                if (interactState.currentCooldownTimer > 0.f || (interactState.oneTime && interactState.hasBeenInteractedThisSession)) {
-                                    continue;
-                                }
-
-                                if (interactState.interactionType == "changeSelf") {
-                                    playSfx("click");
-                                    interact_body_ref.setType(interactState.targetBodyTypeEnum);
-
-                                    if (tiles.size() > k) {
-                                        if (interactState.hasTargetTileColor) {
-                                            tiles[k].setFillColor(interactState.targetTileColor);
-                                        } else {
-                                            tiles[k].setFillColor(getTileColorForBodyType(interactState.targetBodyTypeEnum));
-                                        }
-                                    }
-
-                                    if (interactState.targetBodyTypeEnum == phys::bodyType::none) {
-                                        if (playerBody.getGroundPlatform() == &interact_body_ref) {
-                                            playerBody.setOnGround(false);
-                                            playerBody.setGroundPlatform(nullptr);
-                                        }
-                                        interact_body_ref.setPosition({-10000.f, -10000.f});
-                                        if (tiles.size() > k) tiles[k].setFillColor(sf::Color::Transparent);
-                                    }
-
-                                    if (interactState.linkedID != 0) {
-                                        for (size_t linked_idx = 0; linked_idx < bodies.size(); ++linked_idx) {
-                                            if (bodies[linked_idx].getID() == interactState.linkedID) {
-                                                phys::PlatformBody& linked_body_ref = bodies[linked_idx];
-                                                Tile& linked_tile_ref = tiles[linked_idx];
-
-                                                if (linked_body_ref.getType() == phys::bodyType::solid || linked_body_ref.getType() == phys::bodyType::platform ) {
-                                                    if (playerBody.getGroundPlatform() == &linked_body_ref) {
-                                                        playerBody.setOnGround(false);
-                                                        playerBody.setGroundPlatform(nullptr);
-                                                    }
-                                                    linked_body_ref.setType(phys::bodyType::none);
-                                                    linked_body_ref.setPosition({-10000.f, -10000.f});
-                                                    linked_tile_ref.setFillColor(sf::Color::Transparent);
-                                                    linked_tile_ref.setPosition({-10000.f, -10000.f});
-
-                                                } else if (linked_body_ref.getType() == phys::bodyType::none) {
-                                                    sf::Vector2f originalLinkedPos = {-9999.f, -9999.f};
-                                                    phys::bodyType originalLinkedType = phys::bodyType::solid;
-                                                    
-                                                    for(const auto& templ : currentLevelData.platforms){
-                                                        if(templ.getID() == linked_body_ref.getID()){
-                                                            originalLinkedPos = templ.getPosition();
-                                                            originalLinkedType = templ.getType();
-                                                            break;
-                                                        }
-                                                    }
-
-                                                    if(originalLinkedPos.x > -9998.f){
-                                                       linked_body_ref.setPosition(originalLinkedPos);
-                                                       linked_body_ref.setType(originalLinkedType);
-                                                       linked_tile_ref.setPosition(originalLinkedPos);
-                                                       linked_tile_ref.setFillColor(getTileColorForBodyType(originalLinkedType));
-                                                    }
-                                                } else if (linked_body_ref.getType() != phys::bodyType::portal &&
-                                                           interactState.targetBodyTypeEnum == phys::bodyType::portal &&
-                                                           linked_body_ref.getID() == interactState.linkedID) {
-                                                    sf::Vector2f originalLinkedPos = {-9999.f, -9999.f};
-                                                    for(const auto& templ : currentLevelData.platforms){
-                                                        if(templ.getID() == linked_body_ref.getID()){
-                                                            originalLinkedPos = templ.getPosition();
-                                                            break;
-                                                        }
-                                                    }
-                                                    if(originalLinkedPos.x > -9998.f){
-                                                       linked_body_ref.setPosition(originalLinkedPos);
-                                                       linked_body_ref.setType(phys::bodyType::portal);
-                                                       linked_tile_ref.setPosition(originalLinkedPos);
-                                                       linked_tile_ref.setFillColor(getTileColorForBodyType(phys::bodyType::portal));
-                                                    }
-                                                }
-                                                break;
-                                            }
-                                        }
-                                    }
-
-
-                                    if (interactState.oneTime) interactState.hasBeenInteractedThisSession = true;
-                                    else interactState.currentCooldownTimer = interactState.cooldown;
-                                    goto end_fixed_update_for_interaction;
-                                }
-                            }
-                        }
-                    }
-                }
-                end_fixed_update_for_interaction:;
-
-                // --- Death by Falling ---
-                if (playerBody.getPosition().y > PLAYER_DEATH_Y_LIMIT) {
-                    playSfx("death");
-                    currentState = GameState::GAME_OVER_LOSE_FALL;
-                    if(gameMusic.getStatus() == sf::Music::Playing) gameMusic.pause();
-                    if(menuMusic.getStatus() != sf::Music::Playing && menuMusic.openFromFile(AUDIO_MUSIC_MENU)) menuMusic.play();
-                    break;
+            if (!gameSettings.simulationThread) {
+                // the simulation trails real time by what's left in the accumulator, each step covers one tick of that
+                const std::int64_t stepsStartUs = LatencyStats::nowMicros();
+                stepsLastFrame = 0;
+                while (timeSinceLastFixedUpdate >= timePerFixedUpdate) {
+                    // how far behind its spot in real time this step runs, the threaded version keeps this near 0
+                    if (gameSettings.measureLatency) tickJitter.add((timeSinceLastFixedUpdate - timePerFixedUpdate).asMicroseconds() / 1000.0);
+                    timeSinceLastFixedUpdate -= timePerFixedUpdate;
+                    ++stepsLastFrame;
+                    if (!stepSimulation(stepsStartUs - timeSinceLastFixedUpdate.asMicroseconds())) break;
                 }
-
+                renderAlpha = timeSinceLastFixedUpdate.asSeconds() / timePerFixedUpdate.asSeconds();
             }
         }
         else if (currentState == GameState::TRANSITIONING) {
             levelManager.update(frameDeltaTime.asSeconds(), window);
             if (!levelManager.isTransitioning()) {
-                setupLevelAssets(currentLevelData, window);
+                T3_PROFILE_SCOPE("setupLevelAssets");
+                sf::Clock setupClock;
+                setupLevelAssets(currentLevel, window);
+                levelSetupMs = setupClock.getElapsedTime().asMicroseconds() / 1000.f;
                 currentState = GameState::PLAYING;
                 if(menuMusic.getStatus() == sf::Music::Playing) menuMusic.stop();
-                if(gameMusic.getStatus() != sf::Music::Playing && gameMusic.openFromFile(AUDIO_MUSIC_GAME)) {
+                if(gameMusic.getStatus() != sf::Music::Playing && assetPack.openStream(gameMusic, AUDIO_MUSIC_GAME)) {
                     gameMusic.setVolume(gameSettings.musicVolume);
                     gameMusic.play();
                 }
+                // every way back into PLAYING goes through here, a run that ended stays paused until then
+                if (gameSettings.simulationThread) {
+                    simThread.setTickRate(gameSettings.tickRate);
+                    simThread.setMaxCatchUpSteps(gameSettings.maxStepsPerFrame);
+                    simThread.setRunning(true);
+                }
             }
         }
 
+        // --- Simulation Events ---
+        SimEvent simEvent;
+        while (simEvents.pop(simEvent)) {
+            if (simEvent.sfx) playSfx(simEvent.sfx);
+            if (simEvent.outcome != SimOutcome::None && currentState == GameState::PLAYING) handleSimOutcome(simEvent.outcome);
+        }
+        // left PLAYING (menu, respawn, game over): wait out the step in flight, the world is ours until the next level
+        if (gameSettings.simulationThread && currentState != GameState::PLAYING) simThread.setRunning(false);
+
         // --- Drawing ---
-        window.setTitle("Project - T");
+        T3_PROFILE_NEXT(frameZone, "frame.draw");
         window.clear( (currentState == GameState::PLAYING ||
                         currentState == GameState::TRANSITIONING ||
                         currentState == GameState::GAME_OVER_LOSE_DEATH ||
                         currentState == GameState::GAME_OVER_LOSE_FALL ||
                         currentState == GameState::GAME_OVER_WIN)
-                       && currentLevelData.platforms.size() > 0
-                       ? currentLevelData.backgroundColor
+                       && currentLevel && (currentLevel->getPlatformCount() > 0 || levelStreamer.isActive())
+                       ? currentLevel->getData().backgroundColor
                        : sf::Color::Black);
 
 
+        auto drawSkull = [&]() {
+            if (!skullSpin.isValid()) return;
+            skullSpin.update(frameDeltaTime.asSeconds());
+            const sf::IntRect frame = skullSpin.getFrameRect();
+            skullSprite.setTextureRect(frame);
+            skullSprite.setOrigin(frame.width / 2.f, frame.height / 2.f);
+            skullSprite.setScale(1.5f, 1.5f);
+            window.draw(skullSprite);
+        };
+
         sf::Vector2i currentMousePixelPos = sf::Mouse::getPosition(window);
         sf::Vector2f currentMouseWorldUiPos = window.mapPixelToCoords(currentMousePixelPos, uiView);
 
@@ -1173,6 +2043,10 @@ int main(void) {
                 resolutionPrevText.setFillColor(resolutionPrevText.getGlobalBounds().contains(currentMouseWorldUiPos) && !isFullscreen ? hoverBtnColor : defaultBtnColor);
                 resolutionNextText.setFillColor(resolutionNextText.getGlobalBounds().contains(currentMouseWorldUiPos) && !isFullscreen ? hoverBtnColor : defaultBtnColor);
                 fullscreenToggleText.setFillColor(fullscreenToggleText.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
+                tickRateDownText.setFillColor(tickRateDownText.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
+                tickRateUpText.setFillColor(tickRateUpText.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
+                pacingDownText.setFillColor(pacingDownText.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
+                pacingUpText.setFillColor(pacingUpText.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
 
                 window.draw(settingsTitleText);
                 musicVolValText.setString(std::to_string(static_cast<int>(gameSettings.musicVolume))+"%");
@@ -1181,6 +2055,10 @@ int main(void) {
                 window.draw(sfxVolumeLabelText); window.draw(sfxVolDownText); window.draw(sfxVolValText); window.draw(sfxVolUpText);
                 window.draw(resolutionLabelText); window.draw(resolutionPrevText); window.draw(resolutionCurrentText); window.draw(resolutionNextText);
                 window.draw(fullscreenToggleText);
+                tickRateValText.setString(std::to_string(gameSettings.tickRate) + " Hz");
+                window.draw(tickRateLabelText); window.draw(tickRateDownText); window.draw(tickRateValText); window.draw(tickRateUpText);
+                pacingValText.setString(framePacingName(gameSettings.framePacing));
+                window.draw(pacingLabelText); window.draw(pacingDownText); window.draw(pacingValText); window.draw(pacingUpText);
                 window.draw(settingsBackText);
                 break;
             case GameState::CREDITS:
@@ -1189,48 +2067,126 @@ int main(void) {
                 creditsBackText.setFillColor(creditsBackText.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
                 window.draw(creditsTitleText); window.draw(creditsNamesText); window.draw(creditsBackText);
                 break;
-            case GameState::PLAYING:
-                mainView.setCenter(playerBody.getPosition() + sf::Vector2f(playerBody.getWidth() / 2.f, playerBody.getHeight() / 2.f - 50.f));
-                window.setView(mainView);
-
-                playerShape.setPosition(playerBody.getPosition());
-                for (const auto& t : tiles) {
-                    if (t.getFillColor().a > 0 && !t.hasFallen()) {
-                         window.draw(t);
+            case GameState::PLAYING: {
+                // newest finished step, it stays ours until the next acquire
+                simFrames.acquire();
+                const SimFrame& frame = simFrames.front();
+                if (frame.layoutGeneration != renderedLayoutGeneration) {
+                    T3_PROFILE_SCOPE("draw.tileRebuild");
+                    // new level or streamed chunks. Here and not in the step: baking the chunks needs the GL context
+                    tileRenderer.rebuild(frame.tiles, [&frame](std::size_t i) {
+                        return i < frame.motionBounds.size() ? frame.motionBounds[i] : sf::FloatRect();
+                    });
+                    renderedLayoutGeneration = frame.layoutGeneration;
+                }
+                if (gameSettings.simulationThread) {
+                    // the next tick is due one tick after this one was published, blend by how far along that is
+                    const float sincePublish = static_cast<float>(LatencyStats::nowMicros() - frame.publishedUs) / 1000000.f;
+                    renderAlpha = std::min(1.f, std::max(0.f, sincePublish * static_cast<float>(gameSettings.tickRate)));
+                    stepsLastFrame = static_cast<int>(frame.tick - std::min(frame.tick, lastRenderedTick));
+                }
+                lastRenderedTick = frame.tick;
+                displayedInputUs = frame.lastInputUs;
+                if (gameSettings.simulationThread) {
+                    simAllocationsShown = frame.simAllocations - lastSimAllocations;
+                    lastSimAllocations = frame.simAllocations;
+                }
+
+                const sf::Vector2f playerRenderPosition = interp::blend(frame.previousPlayerPosition, frame.playerPosition, renderAlpha);
+                mainView.setCenter(cameraCenterFor(playerRenderPosition, frame.playerSize));
+                renderQueue.setView(mainView);
+
+                // layers: 0 baked chunks, 1 dynamic tiles, 2 player. The player shares the atlas with the
+                // dynamic tiles, so the queue folds both into one draw.
+                tileRenderer.setInterpolation(&frame.previousTilePositions, renderAlpha);
+                tileRenderer.cull(frame.tiles, mainView);
+                renderQueue.setLayer(0);
+                tileRenderer.record(renderQueue);
+                renderQueue.setLayer(2);
+                if (playerWalk.isValid()) {
+                    // walk cycle while moving on the ground, first frame standing still or in the air
+                    const float velocityX = frame.playerVelocity.x;
+                    if (velocityX < -1.f) playerFacingLeft = true;
+                    else if (velocityX > 1.f) playerFacingLeft = false;
+                    playerWalk.setAnimation(playerFacingLeft ? playerWalkLeft : playerWalkRight);
+                    if (std::abs(velocityX) > 1.f && frame.playerOnGround) {
+                        playerWalk.play();
+                        playerWalk.update(frameDeltaTime.asSeconds());
+                    } else {
+                        playerWalk.restart();
+                        playerWalk.pause();
                     }
+                    const sf::IntRect walkFrame = playerWalk.getFrameRect();
+                    playerSprite.setTextureRect(walkFrame);
+                    playerSprite.setScale(frame.playerSize.x / walkFrame.width, frame.playerSize.y / walkFrame.height);
+                    playerSprite.setPosition(playerRenderPosition);
+                    renderQueue.draw(playerSprite);
+                } else {
+                    playerShape.setSize(frame.playerSize);
+                    playerShape.setPosition(playerRenderPosition);
+                    renderQueue.drawOpaque(playerShape);
                 }
-                window.draw(playerShape);
 
-                window.setView(uiView);
-                {
-                    std::string debugString = "Lvl: " + std::to_string(currentLevelData.levelNumber) +
-                                             " Pos: " + std::to_string(static_cast<int>(playerBody.getPosition().x)) + "," + std::to_string(static_cast<int>(playerBody.getPosition().y)) +
-                                             " Vel: " + std::to_string(static_cast<int>(playerBody.getVelocity().x)) + "," + std::to_string(static_cast<int>(playerBody.getVelocity().y)) +
-                                             " Ground: " + (playerBody.isOnGround() ? "Y" : "N");
-
-                    const phys::PlatformBody* groundPlat = playerBody.getGroundPlatform();
-                    if (groundPlat) {
-                        bool platformStillExistsAndMatches = false;
-                        for (const auto& body_ref : bodies) {
-                            if (&body_ref == groundPlat) {
-                                platformStillExistsAndMatches = true;
-                                break;
-                            }
-                        }
-                        if (platformStillExistsAndMatches) {
-                            debugString += " (ID:" + std::to_string(groundPlat->getID()) +
-                                           (groundPlat->getType() == phys::bodyType::none ? " TYPE_NONE" : (" Type:" + std::to_string(static_cast<int>(groundPlat->getType())))) + ")";
-                            if (groundPlat->getType() == phys::bodyType::portal) {
-                                debugString += " LinkID:" + std::to_string(groundPlat->getPortalID());
-                            }
+                renderQueue.setView(uiView);
+                if (perfHud.isVisible()) {
+                    // printf into the HUD's own buffer, so the overlay doesn't allocate while counting allocations
+                    perfHud.beginText();
+                    perfHud.print("Lvl: %d Pos: %d,%d Vel: %d,%d Ground: %s", currentLevel ? currentLevel->getData().levelNumber : 0,
+                                  static_cast<int>(frame.playerPosition.x), static_cast<int>(frame.playerPosition.y),
+                                  static_cast<int>(frame.playerVelocity.x), static_cast<int>(frame.playerVelocity.y),
+                                  frame.playerOnGround ? "Y" : "N");
+                    if (levelStreamer.isActive()) {
+                        perfHud.print(" Chunk: %d,%d (%u resident, %u loading)", frame.chunk.x, frame.chunk.y,
+                                      static_cast<unsigned int>(frame.residentChunks), static_cast<unsigned int>(frame.pendingChunks));
+                    }
+                    if (frame.hasGround) {
+                        if (frame.groundValid) {
+                            if (frame.groundType == phys::bodyType::none) perfHud.print(" (ID:%u TYPE_NONE)", frame.groundID);
+                            else perfHud.print(" (ID:%u Type:%d)", frame.groundID, static_cast<int>(frame.groundType));
+                            if (frame.groundType == phys::bodyType::portal) perfHud.print(" LinkID:%u", frame.groundPortalID);
                         } else {
-                            debugString += " (GroundRef: INVALID)";
+                            perfHud.print(" (GroundRef: INVALID)");
                         }
                     }
-                    debugText.setString(debugString);
+                    const TileBatchRenderer::CullStats& cullStats = tileRenderer.getCullStats();
+                    perfHud.print("\nTiles: %u drawn, %u visited, %u culled, chunks %u/%u, %u draws",
+                                  static_cast<unsigned int>(cullStats.drawn), static_cast<unsigned int>(cullStats.visited),
+                                  static_cast<unsigned int>(cullStats.culled), static_cast<unsigned int>(cullStats.visibleChunks),
+                                  static_cast<unsigned int>(cullStats.chunks), static_cast<unsigned int>(tileRenderer.getDrawCallCount()));
+                    const RenderQueue::FrameStats& renderStats = renderQueue.getLastFrameStats();
+                    perfHud.print("\nRender: %u cmds -> %u draws, %u verts, %u state changes (%u unsorted)",
+                                  static_cast<unsigned int>(renderStats.commands), static_cast<unsigned int>(renderStats.drawCalls),
+                                  static_cast<unsigned int>(renderStats.vertices), static_cast<unsigned int>(renderStats.stateChanges()),
+                                  static_cast<unsigned int>(renderStats.unsortedStateChanges));
+                    const int droppedMs = gameSettings.simulationThread ? static_cast<int>(simThread.getDroppedMs()) : droppedSimTime.asMilliseconds();
+                    perfHud.print("\nTick: %d Hz %s, %d steps, alpha %d%%, dropped %d ms", gameSettings.tickRate,
+                                  gameSettings.simulationThread ? "(thread)" : "(inline)", stepsLastFrame,
+                                  static_cast<int>(renderAlpha * 100.f), droppedMs);
+                    perfHud.print("\nCollision: %u bodies checked, %u swept", static_cast<unsigned int>(frame.collisionChecked),
+                                  static_cast<unsigned int>(frame.collisionCandidates));
+                    if (AllocationTracker::isEnabled()) {
+                        perfHud.print("\nAlloc: %u last frame, %.1f KB%s", static_cast<unsigned int>(frameAllocations.allocations),
+                                      static_cast<double>(frameAllocations.bytes) / 1024.0, gameSettings.allocationCheck ? ", checking" : "");
+                    } else {
+                        perfHud.print("\nAlloc: not counted (T3_ALLOC_TRACKING build)");
+                    }
+                    perfHud.print("\nLoad: level %.1f ms, setup %.1f ms", levelManager.getLastLoadMs(), levelSetupMs);
+                    perfHud.print(", arena %.1f / %.1f KB", static_cast<double>(frame.arenaUsed) / 1024.0,
+                                  static_cast<double>(frame.arenaCapacity) / 1024.0);
+                    const LatencyStats::Summary& frameTimes = framePacer.getFrameTimes();
+                    const FramePacingOption& pacing = FRAME_PACING_OPTIONS[gameSettings.framePacing];
+                    perfHud.print("\nFrame: %s", FramePacer::modeName(pacing.mode));
+                    if (pacing.mode == FramePacer::Mode::Limited) perfHud.print(" %d", pacing.fps);
+                    perfHud.print(", %.2f ms mean, sd %.2f, p99 %.2f, max %.2f, build %.2f ms", frameTimes.mean, frameTimes.stdDev,
+                                  frameTimes.p99, frameTimes.max, framePacer.getRenderEstimateMs());
+                    perfHud.record(renderQueue, {10.f, 10.f}, {480.f, 80.f});
+                }
+                {
+                    T3_PROFILE_SCOPE("draw.submit");
+                    renderQueue.submit(&window);
                 }
-                window.draw(debugText);
                 break;
+            }
             case GameState::TRANSITIONING:
                 window.setView(uiView);
                 levelManager.draw(window);
@@ -1257,6 +2213,7 @@ int main(void) {
                  gameOverOption1Text.setFillColor(gameOverOption1Text.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
                  gameOverOption2Text.setFillColor(gameOverOption2Text.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
 
+                 drawSkull();
                  window.draw(gameOverStatusText);
                  window.draw(gameOverOption1Text);
                  window.draw(gameOverOption2Text);
@@ -1270,6 +2227,7 @@ int main(void) {
                 gameOverOption1Text.setFillColor(gameOverOption1Text.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
                 gameOverOption2Text.setFillColor(gameOverOption2Text.getGlobalBounds().contains(currentMouseWorldUiPos) ? hoverBtnColor : defaultBtnColor);
 
+                drawSkull();
                 window.draw(gameOverStatusText);
                 window.draw(gameOverOption1Text);
                 window.draw(gameOverOption2Text);
@@ -1277,17 +2235,66 @@ int main(void) {
              default:
                  window.setView(uiView);
                  { sf::RectangleShape bg(LOGICAL_SIZE); bg.setFillColor(sf::Color::Magenta); window.draw(bg); }
-                 sf::Text errorText("Unknown Game State!", menuFont, 20);
+                 sf::Text errorText("Unknown Game State!", *menuFont, 20);
                  errorText.setOrigin(errorText.getLocalBounds().width/2.f, errorText.getLocalBounds().height/2.f);
                  errorText.setPosition(LOGICAL_SIZE.x/2.f, LOGICAL_SIZE.y/2.f);
                  window.draw(errorText);
                  break;
         }
+        T3_PROFILE_NEXT(frameZone, "frame.display");
         window.display();
+        framePacer.endFrame();
+
+        if (gameSettings.allocationCheck) {
+            // a new tile layout (level, streamed chunks) or anything outside PLAYING starts the warm-up over
+            const AllocationTracker::Counts mainAllocations = AllocationTracker::thisThread();
+            const AllocationTracker::Counts allocated = (mainAllocations - lastCheckedMainAllocations) + simAllocationsShown;
+            lastCheckedMainAllocations = mainAllocations;
+            simAllocationsShown = AllocationTracker::Counts();
+            const bool steady = currentState == GameState::PLAYING && renderedLayoutGeneration == checkedLayoutGeneration;
+            checkedLayoutGeneration = renderedLayoutGeneration;
+            steadyFrames = steady ? steadyFrames + 1 : 0;
+            if (steadyFrames > ALLOC_CHECK_WARMUP_FRAMES) {
+                ++checkedFrames;
+                if (allocated.allocations > 0) {
+                    T3_LOG_ERROR("AllocationTracker Error: steady PLAYING frame made {} allocations ({} bytes) after {} clean frames{}",
+                                 allocated.allocations, allocated.bytes, checkedFrames - 1,
+                                 Profiler::isCompiledIn() ? ", F9 trace zones carry per-zone counts" : "");
+                    exitCode = 1;
+                    running = false;
+                }
+            }
+        }
+
+        if (gameSettings.measureLatency) {
+            // input -> on screen: from polling the key to display() returning on the first frame built from a
+            // step that had read it
+            if (displayedInputUs > lastMeasuredInputUs) {
+                inputLatency.add(static_cast<double>(LatencyStats::nowMicros() - displayedInputUs) / 1000.0);
+                lastMeasuredInputUs = displayedInputUs;
+            }
+            if (latencyReportClock.getElapsedTime() >= sf::seconds(5.f)) {
+                const LatencyStats::Summary jitter = gameSettings.simulationThread ? simThread.takeJitter() : tickJitter.summarize();
+                if (inputLatency.size() > 0 || jitter.count > 0) {
+                    T3_LOG_INFO("Latency ({} Hz, {}): input->display {} | tick jitter {} | frames ({}) {}", gameSettings.tickRate,
+                                gameSettings.simulationThread ? "thread" : "inline", LatencyStats::format(inputLatency.summarize()),
+                                LatencyStats::format(jitter), framePacingName(gameSettings.framePacing),
+                                LatencyStats::format(framePacer.getFrameTimes()));
+                }
+                inputLatency.reset();
+                tickJitter.reset();
+                latencyReportClock.restart();
+            }
+        }
     }
 
     // --- Cleanup ---
+    simThread.stop();
+    if (!inputRecordPath.empty() && !inputLog.empty()) inputLog.save(inputRecordPath);
     if (menuMusic.getStatus() == sf::Music::Playing) menuMusic.stop();
     if (gameMusic.getStatus() == sf::Music::Playing) gameMusic.stop();
-    return 0;
+    if (gameSettings.allocationCheck && exitCode == 0) {
+        T3_LOG_INFO("AllocationTracker: {} steady PLAYING frames checked, none allocated", checkedFrames);
+    }
+    return exitCode;
 }
\ No newline at end of file
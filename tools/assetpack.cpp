@@ -0,0 +1,168 @@
+// assetpack [--lz4] <assets dir> <output pack>
+// Build step behind T3_ASSET_PACK. Packs every file under the assets dir (hidden files skipped) into the format
+// described in AssetPack.hpp. With --lz4 (needs a build with T3_ASSET_PACK_LZ4) entries are stored compressed when
+// that saves at least 10%, which in practice means WAV/TTF/JSON; PNG and OGG are already compressed and stay raw.
+#include "AssetPack.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef T3_HAVE_LZ4
+#include "lz4.h"
+#include "lz4hc.h"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PackedEntry {
+    std::string key;
+    std::uint64_t offset = 0;
+    std::uint64_t storedSize = 0;
+    std::uint64_t size = 0;
+    std::uint32_t flags = 0;
+};
+
+void writeU32(std::ostream& out, std::uint32_t v) { out.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+void writeU64(std::ostream& out, std::uint64_t v) { out.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+bool isHidden(const fs::path& relative) {
+    for (const auto& part : relative) {
+        const std::string name = part.string();
+        if (!name.empty() && name[0] == '.') return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool useLz4 = false;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--lz4") == 0) useLz4 = true;
+        else args.emplace_back(argv[i]);
+    }
+    if (args.size() != 2) {
+        std::cerr << "usage: assetpack [--lz4] <assets dir> <output pack>" << std::endl;
+        return 2;
+    }
+#ifndef T3_HAVE_LZ4
+    if (useLz4) {
+        std::cerr << "assetpack Warning: built without LZ4, packing uncompressed" << std::endl;
+        useLz4 = false;
+    }
+#endif
+    const fs::path assetDir = args[0];
+    const fs::path outputPath = args[1];
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(assetDir, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file()) continue;
+        const fs::path relative = fs::relative(it->path(), assetDir);
+        if (isHidden(relative)) continue;
+        files.push_back(relative);
+    }
+    if (ec) {
+        std::cerr << "assetpack Error: cannot walk " << assetDir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end()); // stable output for identical inputs
+
+    const fs::path tempPath = outputPath.string() + ".tmp";
+    fs::create_directories(outputPath.parent_path(), ec);
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "assetpack Error: cannot write " << tempPath << std::endl;
+        return 1;
+    }
+
+    // header gets rewritten once the index position is known
+    std::vector<char> header(pak::HEADER_SIZE, 0);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    std::vector<PackedEntry> entries;
+    entries.reserve(files.size());
+    std::uint64_t position = pak::HEADER_SIZE;
+    std::uint64_t rawTotal = 0;
+    for (const fs::path& relative : files) {
+        std::ifstream in(assetDir / relative, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (!in.good() && !in.eof()) {
+            std::cerr << "assetpack Error: cannot read " << (assetDir / relative) << std::endl;
+            return 1;
+        }
+
+        PackedEntry entry;
+        entry.key = relative.generic_string();
+        entry.size = bytes.size();
+        rawTotal += bytes.size();
+
+        std::vector<char> stored;
+#ifdef T3_HAVE_LZ4
+        if (useLz4 && !bytes.empty() && bytes.size() < static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+            std::vector<char> compressed(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(bytes.size()))));
+            int compressedSize = LZ4_compress_HC(bytes.data(), compressed.data(), static_cast<int>(bytes.size()),
+                                                 static_cast<int>(compressed.size()), LZ4HC_CLEVEL_DEFAULT);
+            if (compressedSize > 0 && static_cast<std::size_t>(compressedSize) < bytes.size() - bytes.size() / 10) {
+                compressed.resize(static_cast<std::size_t>(compressedSize));
+                stored.swap(compressed);
+                entry.flags |= pak::ENTRY_LZ4;
+            }
+        }
+#endif
+        if (!(entry.flags & pak::ENTRY_LZ4)) stored.swap(bytes);
+
+        const std::uint64_t padding = (pak::DATA_ALIGNMENT - position % pak::DATA_ALIGNMENT) % pak::DATA_ALIGNMENT;
+        for (std::uint64_t i = 0; i < padding; ++i) out.put('\0');
+        position += padding;
+
+        entry.offset = position;
+        entry.storedSize = stored.size();
+        out.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+        position += stored.size();
+        entries.push_back(std::move(entry));
+    }
+
+    const std::uint64_t indexOffset = position;
+    for (const PackedEntry& entry : entries) {
+        writeU64(out, entry.offset);
+        writeU64(out, entry.storedSize);
+        writeU64(out, entry.size);
+        writeU32(out, entry.flags);
+        writeU32(out, static_cast<std::uint32_t>(entry.key.size()));
+        out.write(entry.key.data(), static_cast<std::streamsize>(entry.key.size()));
+        position += 32 + entry.key.size();
+    }
+
+    out.seekp(0);
+    out.write(pak::MAGIC, sizeof(pak::MAGIC));
+    writeU32(out, pak::VERSION);
+    writeU32(out, static_cast<std::uint32_t>(entries.size()));
+    writeU32(out, 0);
+    writeU64(out, indexOffset);
+    writeU64(out, position - indexOffset);
+    out.close();
+    if (!out) {
+        std::cerr << "assetpack Error: failed writing " << tempPath << std::endl;
+        return 1;
+    }
+
+    fs::rename(tempPath, outputPath, ec);
+    if (ec) {
+        std::cerr << "assetpack Error: cannot move pack into place: " << ec.message() << std::endl;
+        return 1;
+    }
+    std::cout << "assetpack: " << entries.size() << " files, " << rawTotal / 1024 << " KiB -> "
+              << position / 1024 << " KiB in " << outputPath.generic_string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,303 @@
+// levelembed <levels dir> <output header>
+// Build step behind T3_EMBED_LEVELS. Parses every levelN.json (plus the chunk files of streamed levels) with the
+// game's own LevelManager, checks them and writes them out as constexpr tables for src/EmbeddedLevels.cpp.
+// Any level that fails to parse or validate fails the build.
+#include "LevelManager.hpp"
+#include "EmbeddedLevel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Converted copy of one file, the embedded::Level points into the vectors
+struct LevelTables {
+    std::string file;
+    LevelTemplatePtr source;
+    std::vector<embedded::Platform> platforms;
+    std::vector<embedded::MovingPlatform> moving;
+    std::vector<embedded::InteractiblePlatform> interactibles;
+    std::vector<embedded::PortalPlatform> portals;
+    std::vector<embedded::ChunkEntry> chunks;
+    embedded::Level level{};
+};
+
+const char* bodyTypeName(phys::bodyType type) {
+    switch (type) {
+        case phys::bodyType::none:         return "none";
+        case phys::bodyType::platform:     return "platform";
+        case phys::bodyType::conveyorBelt: return "conveyorBelt";
+        case phys::bodyType::moving:       return "moving";
+        case phys::bodyType::interactible: return "interactible";
+        case phys::bodyType::falling:      return "falling";
+        case phys::bodyType::vanishing:    return "vanishing";
+        case phys::bodyType::spring:       return "spring";
+        case phys::bodyType::trap:         return "trap";
+        case phys::bodyType::solid:        return "solid";
+        case phys::bodyType::goal:         return "goal";
+        case phys::bodyType::portal:       return "portal";
+    }
+    return "solid";
+}
+
+std::string floatLiteral(float value) {
+    if (!std::isfinite(value)) {
+        std::cerr << "levelembed Warning: non-finite number in level data, writing 0" << std::endl;
+        value = 0.f;
+    }
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(value)); // 9 digits round-trips a float
+    std::string text = buffer;
+    if (text.find_first_of(".e") == std::string::npos) text += ".0";
+    return text + "f";
+}
+
+std::string stringLiteral(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\%03o", static_cast<unsigned char>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+void convert(LevelTables& t) {
+    const LevelData& data = t.source->getData();
+    for (const auto& p : data.platforms) {
+        t.platforms.push_back({p.id, p.position.x, p.position.y, p.width, p.height, p.type, p.initiallyFalling,
+                               p.surfaceVelocity.x, p.surfaceVelocity.y, p.portalID, p.teleportOffset.x, p.teleportOffset.y});
+    }
+    for (const auto& m : data.movingPlatformDetails) {
+        t.moving.push_back({m.id, m.startPosition.x, m.startPosition.y, m.axis, m.distance, m.cycleDuration, m.initialDirection});
+    }
+    for (const auto& ip : data.interactiblePlatformDetails) {
+        t.interactibles.push_back({ip.id, ip.interactionType.c_str(), ip.targetBodyTypeStr.c_str(), ip.targetBodyType,
+                                   ip.targetTileColor.r, ip.targetTileColor.g, ip.targetTileColor.b, ip.targetTileColor.a,
+                                   ip.hasTargetTileColor, ip.oneTime, ip.cooldown, ip.linkedID});
+    }
+    for (const auto& pp : data.portalPlatformDetails) {
+        t.portals.push_back({pp.id, pp.portalID, pp.offset.x, pp.offset.y});
+    }
+    for (const auto& c : data.streaming.chunks) {
+        t.chunks.push_back({c.x, c.y, c.file.c_str()});
+    }
+
+    const LevelData::StreamingInfo& s = data.streaming;
+    t.level = embedded::Level{
+        t.file.c_str(), data.levelNumber, data.levelName.c_str(),
+        data.playerStartPosition.x, data.playerStartPosition.y,
+        data.backgroundColor.r, data.backgroundColor.g, data.backgroundColor.b, data.backgroundColor.a,
+        t.platforms.data(), t.platforms.size(),
+        t.moving.data(), t.moving.size(),
+        t.interactibles.data(), t.interactibles.size(),
+        t.portals.data(), t.portals.size(),
+        embedded::Streaming{s.enabled, s.chunkSize, s.loadRadius, s.unloadRadius, s.maxPendingLoads,
+                            s.startChunk.x, s.startChunk.y, s.hasDeathChunkRow, s.deathChunkRow, s.fallDistance,
+                            t.chunks.data(), t.chunks.size()}
+    };
+}
+
+// Same checks the static_asserts run, but here we can say which one failed
+bool check(const LevelTables& t) {
+    bool ok = true;
+    if (!embedded::platformsAreSane(t.level)) {
+        std::cerr << "levelembed Error: " << t.file << ": platform without a positive size" << std::endl;
+        ok = false;
+    }
+    if (!embedded::hasUniqueIDs(t.level)) {
+        std::cerr << "levelembed Warning: " << t.file << ": duplicated platform ids, links and portals will use the first one" << std::endl;
+    }
+    if (!embedded::detailsPointAtPlatforms(t.level)) {
+        std::cerr << "levelembed Error: " << t.file << ": a moving/interactible/portal entry points at a missing platform or has a bad axis/cycle" << std::endl;
+        ok = false;
+    }
+    if (!embedded::streamingIsSane(t.level.streaming)) {
+        std::cerr << "levelembed Error: " << t.file << ": bad streaming block (radii, chunk size or duplicated chunks)" << std::endl;
+        ok = false;
+    }
+    if (ok && !embedded::validate(t.level)) {
+        std::cerr << "levelembed Error: " << t.file << ": level has no platforms" << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+template <typename T, typename WriteRow>
+void writeTable(std::ostream& out, const char* type, const std::string& name, const std::vector<T>& rows, WriteRow writeRow) {
+    if (rows.empty()) return;
+    out << "constexpr " << type << " " << name << "[] = {\n";
+    for (const T& row : rows) {
+        out << "    {";
+        writeRow(row);
+        out << "},\n";
+    }
+    out << "};\n";
+}
+
+std::string tableRef(const std::string& name, std::size_t count) {
+    return count ? name + ", " + std::to_string(count) : std::string("nullptr, 0");
+}
+
+void writeHeader(std::ostream& out, const std::vector<LevelTables>& levels, const std::string& sourceDir) {
+    out << "// Generated by levelembed from " << sourceDir << ". Do not edit, it is rewritten on every build.\n";
+    out << "#ifndef EMBEDDED_LEVELS_GENERATED_HPP\n#define EMBEDDED_LEVELS_GENERATED_HPP\n\n";
+    out << "#include \"EmbeddedLevel.hpp\"\n\n";
+    out << "namespace embedded {\nnamespace generated {\n\n";
+
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        const LevelTables& t = levels[i];
+        const std::string prefix = "file" + std::to_string(i) + "_";
+        out << "// " << t.file << "\n";
+        writeTable(out, "Platform", prefix + "platforms", t.platforms, [&](const embedded::Platform& p) {
+            out << p.id << "u, " << floatLiteral(p.x) << ", " << floatLiteral(p.y) << ", "
+                << floatLiteral(p.width) << ", " << floatLiteral(p.height) << ", phys::bodyType::" << bodyTypeName(p.type) << ", "
+                << (p.initiallyFalling ? "true" : "false") << ", "
+                << floatLiteral(p.surfaceVelocityX) << ", " << floatLiteral(p.surfaceVelocityY) << ", " << p.portalID << "u, "
+                << floatLiteral(p.teleportOffsetX) << ", " << floatLiteral(p.teleportOffsetY);
+        });
+        writeTable(out, "MovingPlatform", prefix + "moving", t.moving, [&](const embedded::MovingPlatform& m) {
+            out << m.id << "u, " << floatLiteral(m.startX) << ", " << floatLiteral(m.startY) << ", '" << (m.axis == 'y' ? 'y' : 'x') << "', "
+                << floatLiteral(m.distance) << ", " << floatLiteral(m.cycleDuration) << ", " << m.initialDirection;
+        });
+        writeTable(out, "InteractiblePlatform", prefix + "interactibles", t.interactibles, [&](const embedded::InteractiblePlatform& ip) {
+            out << ip.id << "u, " << stringLiteral(ip.interactionType) << ", " << stringLiteral(ip.targetBodyTypeStr)
+                << ", phys::bodyType::" << bodyTypeName(ip.targetBodyType) << ", "
+                << static_cast<int>(ip.tileR) << ", " << static_cast<int>(ip.tileG) << ", " << static_cast<int>(ip.tileB) << ", " << static_cast<int>(ip.tileA) << ", "
+                << (ip.hasTargetTileColor ? "true" : "false") << ", " << (ip.oneTime ? "true" : "false") << ", "
+                << floatLiteral(ip.cooldown) << ", " << ip.linkedID << "u";
+        });
+        writeTable(out, "PortalPlatform", prefix + "portals", t.portals, [&](const embedded::PortalPlatform& pp) {
+            out << pp.id << "u, " << pp.portalID << "u, " << floatLiteral(pp.offsetX) << ", " << floatLiteral(pp.offsetY);
+        });
+        writeTable(out, "ChunkEntry", prefix + "chunks", t.chunks, [&](const embedded::ChunkEntry& c) {
+            out << c.x << ", " << c.y << ", " << stringLiteral(c.file);
+        });
+        out << "\n";
+    }
+
+    out << "constexpr Level levels[] = {\n";
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        const LevelTables& t = levels[i];
+        const embedded::Level& l = t.level;
+        const embedded::Streaming& s = l.streaming;
+        const std::string prefix = "file" + std::to_string(i) + "_";
+        out << "    {" << stringLiteral(t.file) << ", " << l.levelNumber << ", " << stringLiteral(l.levelName) << ",\n"
+            << "     " << floatLiteral(l.playerStartX) << ", " << floatLiteral(l.playerStartY) << ", "
+            << static_cast<int>(l.backgroundR) << ", " << static_cast<int>(l.backgroundG) << ", "
+            << static_cast<int>(l.backgroundB) << ", " << static_cast<int>(l.backgroundA) << ",\n"
+            << "     " << tableRef(prefix + "platforms", t.platforms.size()) << ", "
+            << tableRef(prefix + "moving", t.moving.size()) << ", "
+            << tableRef(prefix + "interactibles", t.interactibles.size()) << ", "
+            << tableRef(prefix + "portals", t.portals.size()) << ",\n"
+            << "     {" << (s.enabled ? "true" : "false") << ", " << floatLiteral(s.chunkSize) << ", "
+            << s.loadRadius << ", " << s.unloadRadius << ", " << s.maxPendingLoads << ", "
+            << s.startChunkX << ", " << s.startChunkY << ", " << (s.hasDeathChunkRow ? "true" : "false") << ", "
+            << s.deathChunkRow << ", " << floatLiteral(s.fallDistance) << ", "
+            << tableRef(prefix + "chunks", t.chunks.size()) << "}},\n";
+    }
+    out << "};\n\n";
+
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        out << "static_assert(validate(levels[" << i << "]), " << stringLiteral(levels[i].file + " failed level validation") << ");\n";
+    }
+
+    out << "\n} // namespace generated\n} // namespace embedded\n\n#endif // EMBEDDED_LEVELS_GENERATED_HPP\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: levelembed <levels dir> <output header>" << std::endl;
+        return 2;
+    }
+    const fs::path levelDir = argv[1];
+    const fs::path outputPath = argv[2];
+
+    std::vector<int> levelNumbers;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(levelDir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() > 10 && name.compare(0, 5, "level") == 0 && entry.path().extension() == ".json") {
+            const std::string digits = name.substr(5, name.size() - 10);
+            if (!digits.empty() && std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                levelNumbers.push_back(std::stoi(digits));
+            }
+        }
+    }
+    if (ec || levelNumbers.empty()) {
+        std::cerr << "levelembed Error: no levelN.json files in " << levelDir << std::endl;
+        return 1;
+    }
+    std::sort(levelNumbers.begin(), levelNumbers.end());
+
+    LevelManager parser;
+    parser.setLevelBasePath(levelDir.generic_string() + "/");
+
+    std::vector<LevelTables> levels;
+    levels.reserve(levelNumbers.size());
+    std::set<std::string> chunkFiles;
+    for (int number : levelNumbers) {
+        LevelTables t;
+        t.file = "level" + std::to_string(number) + ".json";
+        t.source = parser.getLevelTemplate(number);
+        if (!t.source) {
+            std::cerr << "levelembed Error: could not parse " << t.file << std::endl;
+            return 1;
+        }
+        for (const auto& chunk : t.source->getData().streaming.chunks) chunkFiles.insert(chunk.file);
+        levels.push_back(std::move(t));
+    }
+    for (const std::string& file : chunkFiles) {
+        LevelTables t;
+        t.file = file;
+        t.source = parser.loadChunkTemplate(file);
+        if (!t.source) {
+            std::cerr << "levelembed Error: could not parse chunk " << file << std::endl;
+            return 1;
+        }
+        levels.push_back(std::move(t));
+    }
+
+    bool allGood = true;
+    for (auto& t : levels) {
+        convert(t);
+        allGood = check(t) && allGood;
+    }
+    if (!allGood) return 1;
+
+    std::ostringstream header;
+    writeHeader(header, levels, levelDir.generic_string());
+
+    fs::create_directories(outputPath.parent_path(), ec);
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "levelembed Error: cannot write " << outputPath << std::endl;
+        return 1;
+    }
+    out << header.str();
+    std::cout << "levelembed: embedded " << levels.size() << " files into " << outputPath.generic_string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+// levelgen [options] <output.json | ->
+// Built with -DT3_LEVEL_GEN=ON. Writes a synthetic level (LevelGenerator) for scale testing, 1k to 1M platforms:
+//   --platforms N          platform count, default 1000
+//   --seed S               same seed and options, same file
+//   --rows R               grid rows, columns follow from the count
+//   --weight type=W        relative weight of a body type (solid, moving, portal, ...), repeatable
+//   --vanishing-fields N[xS]  N fields of SxS vanishing platforms
+//   --link-range N         how far (in cells) interactibles link
+//   --name NAME / --number N  levelName and levelNumber in the file
+// Drop the result into assets/levels as levelN.json to play it, or point the loader at it.
+#include "LevelGenerator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "usage: levelgen [--platforms N] [--seed S] [--rows R] [--weight type=W]... [--vanishing-fields N[xS]]\n"
+                 "                [--link-range N] [--name NAME] [--number N] <output.json | ->" << std::endl;
+}
+
+bool parseSize(const char* text, std::size_t& out) {
+    char* end = nullptr;
+    const unsigned long long value = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    out = static_cast<std::size_t>(value);
+    return true;
+}
+
+bool parseWeight(const std::string& text, LevelGenerator::Options& options) {
+    const std::size_t equals = text.find('=');
+    if (equals == std::string::npos) return false;
+    phys::bodyType type;
+    if (!LevelGenerator::typeFromName(text.substr(0, equals), type)) return false;
+    char* end = nullptr;
+    const float weight = std::strtof(text.c_str() + equals + 1, &end);
+    if (end == text.c_str() + equals + 1 || *end != '\0' || weight < 0.f) return false;
+    options.setWeight(type, weight);
+    return true;
+}
+
+bool parseFields(const std::string& text, LevelGenerator::Options& options) {
+    const std::size_t x = text.find('x');
+    if (!parseSize(text.substr(0, x).c_str(), options.vanishingFields)) return false;
+    return x == std::string::npos || parseSize(text.c_str() + x + 1, options.vanishingFieldSize);
+}
+
+}
+
+int main(int argc, char** argv) {
+    LevelGenerator::Options options;
+    std::string outputPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (arg == "-" || arg[0] != '-') {
+            ok = outputPath.empty();
+            outputPath = arg;
+        } else if (!value) {
+            ok = false;
+        } else if (arg == "--platforms") {
+            ok = parseSize(value, options.platformCount) && options.platformCount > 0;
+        } else if (arg == "--seed") {
+            char* end = nullptr;
+            options.seed = std::strtoull(value, &end, 10);
+            ok = end != value && *end == '\0';
+        } else if (arg == "--rows") {
+            ok = parseSize(value, options.rows) && options.rows > 0;
+        } else if (arg == "--weight") {
+            ok = parseWeight(value, options);
+        } else if (arg == "--vanishing-fields") {
+            ok = parseFields(value, options);
+        } else if (arg == "--link-range") {
+            ok = parseSize(value, options.linkRange);
+        } else if (arg == "--name") {
+            options.levelName = value;
+        } else if (arg == "--number") {
+            options.levelNumber = std::atoi(value);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "levelgen Error: bad argument " << arg << (value && arg[0] == '-' ? std::string(" ") + value : "") << std::endl;
+            printUsage();
+            return 2;
+        }
+        if (arg[0] == '-' && arg != "-") ++i;
+    }
+    if (outputPath.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    const bool toStdout = outputPath == "-";
+    std::FILE* out = toStdout ? stdout : std::fopen(outputPath.c_str(), "wb");
+    if (!out) {
+        std::cerr << "levelgen Error: could not open " << outputPath << std::endl;
+        return 1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const bool written = LevelGenerator(options).write(out);
+    const bool closed = toStdout || std::fclose(out) == 0;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!written || !closed) {
+        std::cerr << "levelgen Error: could not write " << outputPath << std::endl;
+        return 1;
+    }
+    std::cerr << "levelgen: " << options.platformCount << " platforms, seed " << options.seed << ", " << seconds
+              << " s -> " << outputPath << std::endl;
+    return 0;
+}
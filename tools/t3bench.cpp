@@ -0,0 +1,214 @@
+// t3bench [google benchmark flags]
+// Built with -DT3_BENCH=ON. Microbenchmarks of the physics and level loading code on synthetic input:
+//   sweptAABB          one sweep against one platform: hit, miss (falls short), resting on top
+//   resolveCollisions  a full player step against 10..100k platforms, most of them far away
+//   parseLevelJson     LevelManager's parse of a level with 10..10k platforms of every type, from memory
+//   stringToBodyType   the type name lookup the parser does per platform
+//   easing             the Optimizer.hpp curves over a sweep of t
+//   easeCurve/easeBatch  the same sweep through Easing.hpp, one call at a time and as one batch
+// `cmake --build . --target t3bench_json` runs everything and writes build/t3bench.json, compare two of those
+// with Google Benchmark's tools/compare.py to catch regressions between releases.
+#include "CollisionSystem.hpp"
+#include "Easing.hpp"
+#include "LevelManager.hpp"
+#include "Optimizer.hpp"
+#include "PlatformBody.hpp"
+#include "Player.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float STEP = 1.f / 60.f;
+constexpr float PLAYER_SIZE = 32.f;
+
+enum SweepCase { HIT, MISS, RESTING };
+
+void BM_SweptAABB(benchmark::State& state) {
+    phys::PlatformShape shape;
+    shape.position = {0.f, 100.f};
+    shape.width = 96.f;
+    shape.height = 16.f;
+    shape.type = phys::bodyType::solid;
+    const phys::PlatformBody platform(shape);
+
+    phys::DynamicBody body({32.f, 40.f}, PLAYER_SIZE, PLAYER_SIZE);
+    sf::Vector2f displacement(0.f, 40.f);
+    if (state.range(0) == MISS) body.setPosition({32.f, -100.f}); // above it, too far to reach this step
+    if (state.range(0) == RESTING) {
+        body.setPosition({32.f, 100.f - PLAYER_SIZE});
+        displacement = {3.f, 0.f};
+    }
+
+    std::size_t hits = 0;
+    for (auto _ : state) {
+        phys::CollisionEvent event;
+        const bool hit = phys::CollisionSystem::sweptAABB(body, displacement, platform, 1.f, event);
+        benchmark::DoNotOptimize(event);
+        hits += hit ? 1 : 0;
+    }
+    state.counters["hitRate"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SweptAABB)->ArgName("case")->Arg(HIT)->Arg(MISS)->Arg(RESTING);
+
+// Rows of platforms with gaps, the player falls onto the first one. Only a handful are ever near the player,
+// so this is mostly the cost of walking the list.
+std::vector<phys::PlatformShape> makePlatformShapes(std::size_t count) {
+    std::vector<phys::PlatformShape> shapes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        phys::PlatformShape& shape = shapes[i];
+        shape.id = static_cast<unsigned int>(i + 1);
+        shape.position = {static_cast<float>(i % 100) * 128.f, 200.f + static_cast<float>(i / 100) * 96.f};
+        shape.width = 96.f;
+        shape.height = 16.f;
+        shape.type = i % 3 == 0 ? phys::bodyType::platform : phys::bodyType::solid;
+    }
+    return shapes;
+}
+
+void BM_ResolveCollisions(benchmark::State& state) {
+    const std::vector<phys::PlatformShape> shapes = makePlatformShapes(static_cast<std::size_t>(state.range(0)));
+    phys::BodyList bodies;
+    bodies.reserve(shapes.size());
+    for (const auto& shape : shapes) bodies.emplace_back(shape);
+
+    phys::DynamicBody player;
+    std::size_t checked = 0;
+    for (auto _ : state) {
+        player.setPosition({40.f, 200.f - PLAYER_SIZE - 4.f});
+        player.setLastPosition(player.getPosition());
+        player.setVelocity({120.f, 600.f});
+        player.setOnGround(false);
+        player.setGroundPlatform(nullptr);
+        const phys::CollisionResolutionInfo info = phys::CollisionSystem::resolveCollisions(player, bodies, STEP);
+        benchmark::DoNotOptimize(info);
+        checked += info.platformsChecked;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(checked));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ResolveCollisions)->ArgName("platforms")->RangeMultiplier(10)->Range(10, 100000)->Complexity(benchmark::oN);
+
+// Every body type the format has, with the detail blocks the parser reads for moving, interactible and portal.
+std::string makeLevelJson(std::size_t platformCount) {
+    static const char* const TYPES[] = {"solid", "platform", "moving", "falling", "interactible", "conveyorBelt",
+                                         "vanishing", "spring", "trap", "portal"};
+    std::string json = R"({"levelName":"bench","levelNumber":1,"playerStart":{"x":100,"y":100},)"
+                       R"("backgroundColor":{"r":20,"g":20,"b":40},"platforms":[)";
+    char buffer[512];
+    for (std::size_t i = 0; i < platformCount; ++i) {
+        const char* type = TYPES[i % (sizeof(TYPES) / sizeof(TYPES[0]))];
+        const float x = static_cast<float>(i % 100) * 128.f;
+        const float y = static_cast<float>(i / 100) * 96.f;
+        std::snprintf(buffer, sizeof(buffer), R"(%s{"id":%zu,"type":"%s","position":{"x":%.1f,"y":%.1f},"size":{"width":96,"height":16})",
+                      i ? "," : "", i + 1, type, x, y);
+        json += buffer;
+        const std::string typeName = type;
+        if (typeName == "moving") {
+            std::snprintf(buffer, sizeof(buffer), R"(,"movement":{"startPosition":{"x":%.1f,"y":%.1f},"axis":"x","distance":128,"cycleDuration":3,"initialDirection":1})", x, y);
+            json += buffer;
+        } else if (typeName == "interactible") {
+            json += R"(,"interaction":{"type":"changeSelf","targetBodyType":"solid","targetTileColor":{"r":200,"g":80,"b":80},"oneTime":false,"cooldown":1})";
+        } else if (typeName == "portal") {
+            std::snprintf(buffer, sizeof(buffer), R"(,"portalID":%zu,"teleportOffset":{"x":10,"y":0})", i / 10 + 1);
+            json += buffer;
+        } else if (typeName == "conveyorBelt") {
+            json += R"(,"surfaceVelocity":{"x":70,"y":0})";
+        }
+        json += "}";
+    }
+    json += "]}";
+    return json;
+}
+
+void BM_ParseLevelJson(benchmark::State& state) {
+    const std::string json = makeLevelJson(static_cast<std::size_t>(state.range(0)));
+    LevelManager parser;
+    for (auto _ : state) {
+        LevelData data;
+        if (!parser.parseLevelJson(json.data(), json.size(), data)) {
+            state.SkipWithError("synthetic level didn't parse");
+            break;
+        }
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * json.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParseLevelJson)->ArgName("platforms")->RangeMultiplier(10)->Range(10, 10000)->Complexity(benchmark::oN)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_StringToBodyType(benchmark::State& state) {
+    const std::vector<std::string> names = {"none", "platform", "conveyorBelt", "moving", "interactible", "falling",
+                                            "vanishing", "spring", "trap", "solid", "goal", "portal"};
+    LevelManager parser;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.stringToBodyType(names[i]));
+        if (++i == names.size()) i = 0;
+    }
+}
+BENCHMARK(BM_StringToBodyType);
+
+using Easing = float (*)(float, float, float, float);
+
+void BM_Easing(benchmark::State& state, Easing easing) {
+    constexpr int SAMPLES = 1024;
+    constexpr float DURATION = 2.f;
+    for (auto _ : state) {
+        float sum = 0.f;
+        for (int i = 0; i <= SAMPLES; ++i) {
+            sum += easing(DURATION * static_cast<float>(i) / SAMPLES, 0.f, 100.f, DURATION);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (SAMPLES + 1));
+}
+BENCHMARK_CAPTURE(BM_Easing, linear, &math::easing::linear);
+BENCHMARK_CAPTURE(BM_Easing, quadraticEaseInOut, &math::easing::quadraticEaseInOut);
+BENCHMARK_CAPTURE(BM_Easing, cubicEaseInOut, &math::easing::cubicEaseInOut);
+BENCHMARK_CAPTURE(BM_Easing, expoEaseInOut, &math::easing::expoEaseInOut);
+BENCHMARK_CAPTURE(BM_Easing, sineEaseIn, &math::easing::sineEaseIn);
+BENCHMARK_CAPTURE(BM_Easing, sineEaseOut, &math::easing::sineEaseOut);
+BENCHMARK_CAPTURE(BM_Easing, sineEaseInOut, &math::easing::sineEaseInOut);
+
+template <math::easing::Curve C>
+void BM_EaseCurve(benchmark::State& state) {
+    constexpr int SAMPLES = 1024;
+    for (auto _ : state) {
+        float sum = 0.f;
+        for (int i = 0; i <= SAMPLES; ++i) {
+            sum += math::easing::ease<C>(static_cast<float>(i) / SAMPLES);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (SAMPLES + 1));
+}
+BENCHMARK_TEMPLATE(BM_EaseCurve, math::easing::Curve::CubicInOut);
+BENCHMARK_TEMPLATE(BM_EaseCurve, math::easing::Curve::ExpoInOut);
+BENCHMARK_TEMPLATE(BM_EaseCurve, math::easing::Curve::SineInOut);
+
+template <math::easing::Curve C>
+void BM_EaseBatch(benchmark::State& state) {
+    constexpr int SAMPLES = 1024;
+    std::vector<float> alphas(SAMPLES + 1);
+    std::vector<float> eased(SAMPLES + 1);
+    for (int i = 0; i <= SAMPLES; ++i) alphas[i] = static_cast<float>(i) / SAMPLES;
+    for (auto _ : state) {
+        math::easing::easeBatch<C>(alphas.data(), eased.data(), eased.size());
+        benchmark::DoNotOptimize(eased.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (SAMPLES + 1));
+}
+BENCHMARK_TEMPLATE(BM_EaseBatch, math::easing::Curve::CubicInOut);
+BENCHMARK_TEMPLATE(BM_EaseBatch, math::easing::Curve::ExpoInOut);
+BENCHMARK_TEMPLATE(BM_EaseBatch, math::easing::Curve::SineInOut);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,143 @@
+// tilebench [frames per run] [max tiles]
+// Built with -DT3_TILE_BENCH=ON. Renders synthetic levels of growing size into an 800x600 window three ways and
+// prints the average frame time for each level size:
+//   per-tile  one window.draw() of a RectangleShape per tile, what the game did before TileBatchRenderer
+//   batched   TileBatchRenderer with static caching off, one vertex array per layer of the culled tiles
+//   cached    TileBatchRenderer with the static tiles baked into CHUNK_SIZE render textures
+// 10% of the tiles are dynamic and move every frame, the camera pans across the level the way the player would.
+// Frame time is measured from the first draw to the end of display(), vsync off, so it includes the driver's
+// submit cost but the GPU may still be a frame behind. Compare the columns, not the absolute numbers.
+#include "Tile.hpp"
+#include "TileBatchRenderer.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+constexpr unsigned int ROWS = 64;
+constexpr float TILE = 32.f;
+constexpr float SPACING = 34.f;
+constexpr float SWAY = 8.f; // how far the dynamic tiles move sideways
+const sf::Vector2f VIEW_SIZE(800.f, 600.f);
+
+struct Level {
+    std::vector<Tile> tiles;
+    std::vector<std::size_t> dynamic;
+    float width = 0.f;
+};
+
+Level makeLevel(std::size_t tileCount) {
+    Level level;
+    level.tiles.reserve(tileCount);
+    for (std::size_t i = 0; i < tileCount; ++i) {
+        const float x = static_cast<float>(i / ROWS) * SPACING;
+        const float y = static_cast<float>(i % ROWS) * SPACING;
+        const bool dynamic = i % 10 == 0;
+        Tile tile;
+        tile.position = {x, y};
+        tile.size = {TILE, TILE};
+        tile.setFillColor(dynamic ? sf::Color(70, 200, 70) : sf::Color(100, 100, 100, (i % 7 == 0) ? 180 : 255));
+        level.tiles.push_back(tile);
+        if (dynamic) level.dynamic.push_back(i);
+        level.width = std::max(level.width, x + TILE);
+    }
+    return level;
+}
+
+enum class Mode { PerTile, Batched, Cached };
+
+struct RunResult {
+    double frameMs = 0.0;
+    double rebuildMs = 0.0;
+    std::size_t drawCalls = 0; // of the last frame
+    std::size_t chunks = 0;
+};
+
+RunResult runFrames(sf::RenderWindow& window, Level& level, Mode mode, int frames) {
+    RunResult result;
+    TileBatchRenderer renderer;
+    if (mode != Mode::PerTile) {
+        renderer.setStaticCaching(mode == Mode::Cached);
+        std::vector<bool> isDynamic(level.tiles.size(), false);
+        for (std::size_t i : level.dynamic) isDynamic[i] = true;
+        auto start = std::chrono::steady_clock::now();
+        renderer.rebuild(level.tiles, [&](std::size_t i) -> sf::FloatRect {
+            if (!isDynamic[i]) return {};
+            sf::FloatRect reach = level.tiles[i].getGlobalBounds();
+            reach.left -= SWAY;
+            reach.width += 2.f * SWAY;
+            return reach;
+        });
+        result.rebuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.chunks = renderer.getCachedChunkCount();
+    }
+
+    sf::View view(sf::FloatRect(0.f, 0.f, VIEW_SIZE.x, VIEW_SIZE.y));
+    const float panRange = std::max(0.f, level.width - VIEW_SIZE.x);
+    double totalMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        const float t = static_cast<float>(frame) / static_cast<float>(frames);
+        for (std::size_t i : level.dynamic) {
+            level.tiles[i].position = {static_cast<float>(i / ROWS) * SPACING + std::sin(t * 20.f + static_cast<float>(i)) * SWAY,
+                                       static_cast<float>(i % ROWS) * SPACING};
+        }
+        view.setCenter(VIEW_SIZE.x / 2.f + panRange * t, VIEW_SIZE.y / 2.f + 400.f * std::sin(t * 6.28f));
+
+        auto start = std::chrono::steady_clock::now();
+        window.setView(view);
+        window.clear(sf::Color(20, 20, 50));
+        if (mode == Mode::PerTile) {
+            sf::RectangleShape shape;
+            for (const Tile& tile : level.tiles) {
+                if (!tile.isVisible()) continue;
+                shape.setPosition(tile.position);
+                shape.setSize(tile.size);
+                shape.setFillColor(tile.getFillColor());
+                window.draw(shape);
+            }
+            result.drawCalls = level.tiles.size();
+        } else {
+            renderer.cull(level.tiles, view);
+            window.draw(renderer);
+            result.drawCalls = renderer.getDrawCallCount();
+        }
+        window.display();
+        totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        sf::Event event;
+        while (window.pollEvent(event)) {}
+    }
+    result.frameMs = totalMs / frames;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 300;
+    const std::size_t maxTiles = argc > 2 ? static_cast<std::size_t>(std::max(1, std::atoi(argv[2]))) : 64000;
+
+    sf::RenderWindow window(sf::VideoMode(static_cast<unsigned int>(VIEW_SIZE.x), static_cast<unsigned int>(VIEW_SIZE.y)), "tilebench");
+    window.setVerticalSyncEnabled(false);
+    window.setFramerateLimit(0);
+
+    std::printf("%10s %14s %14s %14s %8s %8s %10s\n", "tiles", "per-tile ms", "batched ms", "cached ms", "chunks", "draws", "bake ms");
+    for (std::size_t tileCount = 1000; tileCount <= maxTiles; tileCount *= 4) {
+        Level level = makeLevel(tileCount);
+        const RunResult perTile = runFrames(window, level, Mode::PerTile, frames);
+        const RunResult batched = runFrames(window, level, Mode::Batched, frames);
+        const RunResult cached = runFrames(window, level, Mode::Cached, frames);
+        std::printf("%10zu %14.3f %14.3f %14.3f %8zu %8zu %10.1f\n",
+                    tileCount, perTile.frameMs, batched.frameMs, cached.frameMs, cached.chunks, cached.drawCalls, cached.rebuildMs);
+        std::fflush(stdout);
+        if (!window.isOpen()) break;
+    }
+    return 0;
+}